@@ -1,5 +1,10 @@
 // common.h
 
+#ifndef COMMON_H
+#define COMMON_H
+
+#include <stdint.h>
+
 /*
  * =========================================
  * SECTION: Common Data Types
@@ -16,5 +21,25 @@ union elem{
     bool boolValue;         // Represents a boolean value
     float floatValue;       // Represents a floating-point value
     void *ptrValue;         // Represents a generic pointer
+    uint64_t uint64Value;   // Represents a 64-bit counter
     // Add other types as needed
 };
+
+
+/*
+ * =========================================
+ * SECTION: Common Functions
+ * =========================================
+ */
+
+/// @brief Scramble a hash value so that every output bit depends on every input bit.
+/// @param hash The hash value to mix.
+/// @return The mixed value (splitmix64 finalizer).
+/// @note Used to derive independent positions from one ioopm_hash_function result.
+static inline uint64_t ioopm_mix_hash(uint64_t hash){
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+    return hash ^ (hash >> 31);
+}
+
+#endif  //COMMON_H
@@ -0,0 +1,194 @@
+// concurrent_counter_table.c
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "concurrent_counter_table.h"
+
+/// Number of locks guarding inserts; bucket i is guarded by lock i % Lock_Stripes.
+#define Lock_Stripes 64
+
+/// Size of a cache line, the alignment of each counter entry.
+#define Cache_Line 64
+
+/*
+ * =========================================
+ * SECTION: Custom Data Types And Aliases
+ * =========================================
+ */
+
+typedef struct counter_entry counter_entry_t;
+
+/// Entries are only ever pushed at the head of a bucket, and next never changes once published.
+struct counter_entry
+{
+  _Atomic uint64_t count;
+  size_t hash;                        /// Full hash, checked before calling key_eq_func.
+  elem_t key;
+  counter_entry_t *next;
+};
+
+/// Each lock gets its own cache line so that stripes do not slow each other down.
+typedef struct
+{
+  pthread_mutex_t mutex;
+} __attribute__((aligned(Cache_Line))) lock_stripe_t;
+
+struct concurrent_counter_table
+{
+  _Atomic(counter_entry_t *) buckets[No_Buckets];
+  lock_stripe_t locks[Lock_Stripes];
+  atomic_size_t size;
+  ioopm_hash_function hash_func;
+  ioopm_eq_function key_eq_func;
+  ioopm_copy_function copy_key_func;
+  ioopm_free_function free_key_func;
+};
+
+
+/*
+ * =========================================
+ * SECTION: Function Definitions
+ * =========================================
+ */
+
+/// @brief Searches a bucket for a key, without locking.
+/// @param first The first entry of the bucket (loaded with acquire ordering).
+/// @param stop The entry to stop at (exclusive), NULL to search the whole bucket.
+/// @param hash The hash of the key.
+/// @param key The key.
+/// @param key_eq_func Function used to compare keys.
+/// @return The entry of the key, or NULL if not found.
+static counter_entry_t *find_entry(counter_entry_t *first, counter_entry_t *stop, size_t hash, elem_t key, ioopm_eq_function key_eq_func){
+  for(counter_entry_t *entry = first; entry != stop; entry = entry->next){
+    if(entry->hash == hash && key_eq_func(entry->key, key)) return entry;
+  }
+  return NULL;
+}
+
+
+ioopm_concurrent_counter_table_t *ioopm_concurrent_counter_table_create(ioopm_hash_function hash_func, ioopm_eq_function key_eq_func,
+                                                                        ioopm_copy_function copy_key_func, ioopm_free_function free_key_func){
+  ioopm_concurrent_counter_table_t *table = aligned_alloc(Cache_Line, sizeof(ioopm_concurrent_counter_table_t));
+  if(!table) return NULL;
+
+  for(size_t i = 0; i < No_Buckets; ++i){
+    atomic_init(&table->buckets[i], NULL);
+  }
+  for(size_t i = 0; i < Lock_Stripes; ++i){
+    pthread_mutex_init(&table->locks[i].mutex, NULL);
+  }
+  atomic_init(&table->size, 0);
+  table->hash_func = hash_func;
+  table->key_eq_func = key_eq_func;
+  table->copy_key_func = copy_key_func;
+  table->free_key_func = free_key_func;
+
+  return table;
+}
+
+void ioopm_concurrent_counter_table_destroy(ioopm_concurrent_counter_table_t *table){
+  if(!table) return;
+
+  for(size_t i = 0; i < No_Buckets; ++i){
+    counter_entry_t *entry = atomic_load_explicit(&table->buckets[i], memory_order_relaxed);
+    while(entry){
+      counter_entry_t *next = entry->next;
+      if(table->free_key_func) table->free_key_func(entry->key);
+      free(entry);
+      entry = next;
+    }
+  }
+  for(size_t i = 0; i < Lock_Stripes; ++i){
+    pthread_mutex_destroy(&table->locks[i].mutex);
+  }
+
+  free(table);
+}
+
+uint64_t ioopm_concurrent_counter_table_increment(ioopm_concurrent_counter_table_t *table, elem_t key, uint64_t delta){
+  if(!table) return 0;
+
+  size_t hash = table->hash_func(key);
+  size_t bucket = hash % No_Buckets;
+
+  // Fast path: the key exists, so a single lock-free fetch-add is enough
+  counter_entry_t *first = atomic_load_explicit(&table->buckets[bucket], memory_order_acquire);
+  counter_entry_t *entry = find_entry(first, NULL, hash, key, table->key_eq_func);
+  if(entry){
+    return atomic_fetch_add_explicit(&entry->count, delta, memory_order_relaxed) + delta;
+  }
+
+  pthread_mutex_t *lock = &table->locks[bucket % Lock_Stripes].mutex;
+  pthread_mutex_lock(lock);
+
+  // Another thread may have inserted the key since, only the new entries need to be searched
+  counter_entry_t *head = atomic_load_explicit(&table->buckets[bucket], memory_order_acquire);
+  entry = find_entry(head, first, hash, key, table->key_eq_func);
+  if(entry){
+    pthread_mutex_unlock(lock);
+    return atomic_fetch_add_explicit(&entry->count, delta, memory_order_relaxed) + delta;
+  }
+
+  elem_t owned_key = key;
+  if(table->copy_key_func){
+    owned_key = table->copy_key_func(key);
+    if(!owned_key.ptrValue){
+      pthread_mutex_unlock(lock);
+      return 0;
+    }
+  }
+
+  entry = aligned_alloc(Cache_Line, Cache_Line);
+  if(!entry){
+    pthread_mutex_unlock(lock);
+    if(table->copy_key_func && table->free_key_func) table->free_key_func(owned_key);
+    return 0;
+  }
+
+  atomic_init(&entry->count, delta);
+  entry->hash = hash;
+  entry->key = owned_key;
+  entry->next = head;
+
+  // Release ordering publishes the filled-in entry to lock-free readers
+  atomic_store_explicit(&table->buckets[bucket], entry, memory_order_release);
+  atomic_fetch_add_explicit(&table->size, 1, memory_order_relaxed);
+  pthread_mutex_unlock(lock);
+
+  return delta;
+}
+
+bool ioopm_concurrent_counter_table_lookup(ioopm_concurrent_counter_table_t *table, elem_t key, uint64_t *count){
+  if(!table) return false;
+
+  size_t hash = table->hash_func(key);
+  counter_entry_t *first = atomic_load_explicit(&table->buckets[hash % No_Buckets], memory_order_acquire);
+  counter_entry_t *entry = find_entry(first, NULL, hash, key, table->key_eq_func);
+  if(!entry) return false;
+
+  if(count) *count = atomic_load_explicit(&entry->count, memory_order_relaxed);
+  return true;
+}
+
+size_t ioopm_concurrent_counter_table_size(ioopm_concurrent_counter_table_t *table){
+  return table ? atomic_load_explicit(&table->size, memory_order_relaxed) : 0;
+}
+
+void ioopm_concurrent_counter_table_apply_to_all(ioopm_concurrent_counter_table_t *table, ioopm_counter_apply_function apply_fun, void *extra){
+  if(!table || !apply_fun) return;
+
+  for(size_t i = 0; i < No_Buckets; ++i){
+    counter_entry_t *entry = atomic_load_explicit(&table->buckets[i], memory_order_acquire);
+    for(; entry; entry = entry->next){
+      apply_fun(entry->key, atomic_load_explicit(&entry->count, memory_order_relaxed), extra);
+    }
+  }
+}
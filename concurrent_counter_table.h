@@ -0,0 +1,89 @@
+// concurrent_counter_table.h
+
+#ifndef CONCURRENT_COUNTER_TABLE_H
+#define CONCURRENT_COUNTER_TABLE_H
+
+/**
+ * @file concurrent_counter_table.h
+ * @brief Counter table that many threads can increment at the same time.
+ *
+ * This is the thread-safe variant of ioopm_counter_table_increment. Buckets
+ * are searched without locking and the counter of an existing key is raised
+ * with an atomic fetch-add, so threads counting the same hot keys never wait
+ * for each other. Only inserting a new key takes a lock, and only one of a
+ * set of lock stripes, so inserts into different buckets mostly proceed in
+ * parallel. Keys are never removed while the table is shared; each counter
+ * sits in its own cache line so hot counters do not falsely share one.
+ */
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hash_table.h"
+
+/*
+ * =========================================
+ * SECTION: Custom Data Types And Aliases
+ * =========================================
+ */
+
+typedef struct concurrent_counter_table ioopm_concurrent_counter_table_t;
+typedef void (*ioopm_counter_apply_function)(elem_t key, uint64_t count, void *extra);
+
+
+/*
+ * =========================================
+ * SECTION: Function Declarations
+ * =========================================
+ */
+
+/// @brief Create an empty concurrent counter table.
+/// @param hash_func Function used to hash keys.
+/// @param key_eq_func Function used to compare keys for equality.
+/// @param copy_key_func Called when a new key is inserted, e.g. to strdup a transient string
+///                      (returning a NULL ptrValue on failure); NULL stores keys as is.
+/// @param free_key_func Called on every key when the table is destroyed; may be NULL.
+/// @return A new table, or NULL if memory allocation fails.
+ioopm_concurrent_counter_table_t *ioopm_concurrent_counter_table_create(ioopm_hash_function hash_func, ioopm_eq_function key_eq_func,
+                                                                        ioopm_copy_function copy_key_func, ioopm_free_function free_key_func);
+
+/// @brief Delete a table, its keys (through free_key_func) and its counters.
+/// @param table The table to delete; no other thread may be using it.
+void ioopm_concurrent_counter_table_destroy(ioopm_concurrent_counter_table_t *table);
+
+/// @brief Atomically add delta to the counter of a key, inserting the key if it is missing.
+/// @param table Table operated upon; safe to call from many threads at once.
+/// @param key The key whose counter is incremented.
+/// @param delta The amount to add.
+/// @return The count right after this increment, or 0 if copying the key or memory allocation fails.
+uint64_t ioopm_concurrent_counter_table_increment(ioopm_concurrent_counter_table_t *table, elem_t key, uint64_t delta);
+
+/// @brief Read the counter of a key.
+/// @param table Table operated upon; safe to call while other threads increment.
+/// @param key The key to look up.
+/// @param count Pointer to store the count in, if the key is present (may be NULL).
+/// @return true if the key is present, false otherwise.
+bool ioopm_concurrent_counter_table_lookup(ioopm_concurrent_counter_table_t *table, elem_t key, uint64_t *count);
+
+/// @brief Returns the number of keys in the table.
+/// @param table Table operated upon.
+/// @return The number of keys.
+size_t ioopm_concurrent_counter_table_size(ioopm_concurrent_counter_table_t *table);
+
+/// @brief Call a function with every key and its count, in no particular order.
+/// @param table Table operated upon.
+/// @param apply_fun Function called for every key.
+/// @param extra Extra argument passed to apply_fun.
+/// @note Keys inserted concurrently may or may not be visited, call it after counting is done.
+void ioopm_concurrent_counter_table_apply_to_all(ioopm_concurrent_counter_table_t *table, ioopm_counter_apply_function apply_fun, void *extra);
+
+
+
+#endif // CONCURRENT_COUNTER_TABLE_H
@@ -0,0 +1,216 @@
+// concurrent_counter_table_tests.c
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include <CUnit/Basic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "concurrent_counter_table.h"
+
+/// @brief Threads and increments per thread in the concurrency test.
+#define NUM_THREADS 8
+#define NUM_INCREMENTS 200000
+
+/// @brief Number of keys the threads count into; few keys means hot keys.
+#define NUM_HOT_KEYS 4
+
+
+/*
+ * =========================================
+ * SECTION: Private Function Definitions
+ * =========================================
+ */
+
+/// @brief Hash function for integer keys.
+/// @param key The key to hash.
+/// @return The hash value.
+static size_t int_hash_function(elem_t key) {
+    return (size_t)key.intValue;
+}
+
+/// @brief Equality function for integer keys.
+/// @param a The first key.
+/// @param b The second key.
+/// @return true if the keys are equal.
+static bool int_eq_function(elem_t a, elem_t b) {
+    return a.intValue == b.intValue;
+}
+
+/// @brief Equality function for string keys.
+/// @param a The first key.
+/// @param b The second key.
+/// @return true if the strings are equal.
+static bool string_eq_function(elem_t a, elem_t b) {
+    return strcmp(a.ptrValue, b.ptrValue) == 0;
+}
+
+/// @brief Copies a string key.
+/// @param key The key to copy.
+/// @return The copy.
+static elem_t string_copy_function(elem_t key) {
+    return ptr_elem(strdup(key.ptrValue));
+}
+
+/// @brief Frees a string key.
+/// @param key The key to free.
+static void string_free_function(elem_t key) {
+    free(key.ptrValue);
+}
+
+/// @brief Apply function that sums all counts.
+/// @param key The key (unused).
+/// @param count The count of the key.
+/// @param extra Pointer to the running sum.
+static void sum_counts(elem_t key, uint64_t count, void *extra) {
+    (void)key;
+    *(uint64_t *)extra += count;
+}
+
+/// @brief Thread body: counts NUM_INCREMENTS keys, mostly hot ones, into a shared table.
+/// @param arg The shared table.
+/// @return NULL.
+static void *count_keys(void *arg) {
+    ioopm_concurrent_counter_table_t *table = arg;
+    for (int i = 0; i < NUM_INCREMENTS; ++i) {
+      // Every 16th increment goes to a key of its own, racing with other threads to insert it
+      int key = i % 16 == 0 ? NUM_HOT_KEYS + i / 16 : i % NUM_HOT_KEYS;
+      ioopm_concurrent_counter_table_increment(table, int_elem(key), 1);
+    }
+    return NULL;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Initialize and clean the suite
+ * =========================================
+ */
+
+int init_suite(void) {
+  return 0;
+}
+
+int clean_suite(void) {
+  return 0;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Tests
+ * =========================================
+ */
+
+void test_increment_lookup() {
+  ioopm_concurrent_counter_table_t *table = ioopm_concurrent_counter_table_create(int_hash_function, int_eq_function, NULL, NULL);
+  CU_ASSERT_PTR_NOT_NULL(table);
+  CU_ASSERT_EQUAL(ioopm_concurrent_counter_table_size(table), 0);
+
+  CU_ASSERT_EQUAL(ioopm_concurrent_counter_table_increment(table, int_elem(3), 2), 2);
+  CU_ASSERT_EQUAL(ioopm_concurrent_counter_table_increment(table, int_elem(3), 1ULL << 40), (1ULL << 40) + 2);
+  CU_ASSERT_EQUAL(ioopm_concurrent_counter_table_increment(table, int_elem(3 + No_Buckets), 1), 1);
+  CU_ASSERT_EQUAL(ioopm_concurrent_counter_table_size(table), 2);
+
+  uint64_t count = 0;
+  CU_ASSERT_TRUE(ioopm_concurrent_counter_table_lookup(table, int_elem(3 + No_Buckets), &count));
+  CU_ASSERT_EQUAL(count, 1);
+  CU_ASSERT_FALSE(ioopm_concurrent_counter_table_lookup(table, int_elem(4), &count));
+
+  ioopm_concurrent_counter_table_destroy(table);
+}
+
+void test_owned_string_keys() {
+  ioopm_concurrent_counter_table_t *table = ioopm_concurrent_counter_table_create(ioopm_string_hash, string_eq_function,
+                                                                                  string_copy_function, string_free_function);
+  char buf[16];
+
+  for (int i = 0; i < 9; ++i) {
+    strcpy(buf, i % 3 == 0 ? "fizz" : "other");
+    ioopm_concurrent_counter_table_increment(table, ptr_elem(buf), 1);
+  }
+  strcpy(buf, "neither");
+
+  uint64_t count = 0;
+  CU_ASSERT_TRUE(ioopm_concurrent_counter_table_lookup(table, ptr_elem("fizz"), &count));
+  CU_ASSERT_EQUAL(count, 3);
+  CU_ASSERT_TRUE(ioopm_concurrent_counter_table_lookup(table, ptr_elem("other"), &count));
+  CU_ASSERT_EQUAL(count, 6);
+
+  ioopm_concurrent_counter_table_destroy(table);
+}
+
+void test_concurrent_increments() {
+  ioopm_concurrent_counter_table_t *table = ioopm_concurrent_counter_table_create(int_hash_function, int_eq_function, NULL, NULL);
+  pthread_t threads[NUM_THREADS];
+
+  for (int i = 0; i < NUM_THREADS; ++i) {
+    pthread_create(&threads[i], NULL, count_keys, table);
+  }
+  for (int i = 0; i < NUM_THREADS; ++i) {
+    pthread_join(threads[i], NULL);
+  }
+
+  // No increment is lost and every key is inserted exactly once
+  int own_keys = NUM_INCREMENTS / 16;
+  CU_ASSERT_EQUAL(ioopm_concurrent_counter_table_size(table), NUM_HOT_KEYS + own_keys);
+
+  uint64_t total = 0;
+  ioopm_concurrent_counter_table_apply_to_all(table, sum_counts, &total);
+  CU_ASSERT_EQUAL(total, (uint64_t)NUM_THREADS * NUM_INCREMENTS);
+
+  uint64_t count = 0;
+  CU_ASSERT_TRUE(ioopm_concurrent_counter_table_lookup(table, int_elem(NUM_HOT_KEYS), &count));
+  CU_ASSERT_EQUAL(count, NUM_THREADS);
+
+  ioopm_concurrent_counter_table_destroy(table);
+}
+
+
+/*
+ * =========================================
+ * SECTION: Main
+ * =========================================
+ */
+
+int main() {
+  // First we try to set up CUnit, and exit if we fail
+  if (CU_initialize_registry() != CUE_SUCCESS)
+    return CU_get_error();
+
+  // We then create an empty test suite and specify the name and
+  // the init and cleanup functions
+  CU_pSuite my_test_suite = CU_add_suite("Unit tests for concurrent counter table", init_suite, clean_suite);
+  if (my_test_suite == NULL) {
+      // If the test suite could not be added, tear down CUnit and exit
+      CU_cleanup_registry();
+      return CU_get_error();
+  }
+
+  if (
+    (CU_add_test(my_test_suite, "Increment and look up counters", test_increment_lookup) == NULL) ||
+    (CU_add_test(my_test_suite, "String keys are copied and freed", test_owned_string_keys) == NULL) ||
+    (CU_add_test(my_test_suite, "Threads counting into one table lose no increments", test_concurrent_increments) == NULL) ||
+    0
+  )
+    {
+      // If adding any of the tests fails, we tear down CUnit and exit
+      CU_cleanup_registry();
+      return CU_get_error();
+    }
+
+  // Set the running mode. Use CU_BRM_VERBOSE for maximum output.
+  // Use CU_BRM_NORMAL to only print errors and a summary
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+
+  // This is where the tests are actually run!
+  CU_basic_run_tests();
+
+  // Tear down CUnit before exiting
+  CU_cleanup_registry();
+  return CU_get_error();
+}
@@ -0,0 +1,199 @@
+// count_min_sketch.c
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "count_min_sketch.h"
+
+/// Euler's number, the constant in the Count-Min error bounds.
+#define Euler 2.718281828459045
+
+/// Identifies a saved sketch (and the version of the format).
+#define Cms_Magic "IOCMS01"
+
+/*
+ * =========================================
+ * SECTION: Custom Data Types And Aliases
+ * =========================================
+ */
+
+/// Counters are stored row after row in one allocation.
+struct count_min_sketch
+{
+  size_t width;
+  size_t depth;
+  uint64_t total;
+  ioopm_hash_function hash_func;
+  uint64_t *counters;
+};
+
+
+/*
+ * =========================================
+ * SECTION: Function Definitions
+ * =========================================
+ */
+
+/// @brief Computes the counter index of a key in every row.
+/// @param cms The sketch.
+/// @param key The key.
+/// @param columns Array of depth entries that receives the index in each row.
+/// @note Rows use h1 + row * h2 (double hashing) of the mixed key hash.
+static void key_columns(ioopm_cms_t *cms, elem_t key, size_t *columns){
+  uint64_t h1 = ioopm_mix_hash(cms->hash_func(key));
+  uint64_t h2 = ioopm_mix_hash(h1) | 1;
+
+  for(size_t row = 0; row < cms->depth; ++row){
+    columns[row] = row * cms->width + (h1 + row * h2) % cms->width;
+  }
+}
+
+ioopm_cms_t *ioopm_cms_create(size_t width, size_t depth, ioopm_hash_function hash_func){
+  if(width == 0 || depth == 0 || depth > Cms_Max_Depth || !hash_func) return NULL;
+  if(width > SIZE_MAX / depth / sizeof(uint64_t)) return NULL;
+
+  ioopm_cms_t *cms = calloc(1, sizeof(ioopm_cms_t));
+  if(!cms) return NULL;
+
+  cms->counters = calloc(width * depth, sizeof(uint64_t));
+  if(!cms->counters){
+    free(cms);
+    return NULL;
+  }
+
+  cms->width = width;
+  cms->depth = depth;
+  cms->total = 0;
+  cms->hash_func = hash_func;
+
+  return cms;
+}
+
+ioopm_cms_t *ioopm_cms_create_with_error(double epsilon, double delta, ioopm_hash_function hash_func){
+  if(!(epsilon > 0 && epsilon < 1) || !(delta > 0 && delta < 1)) return NULL;
+
+  size_t width = (size_t)(Euler / epsilon) + 1;
+
+  // Smallest depth with e^-depth <= delta
+  size_t depth = 1;
+  for(double bound = 1 / Euler; bound > delta; bound /= Euler){
+    depth++;
+  }
+
+  return ioopm_cms_create(width, depth, hash_func);
+}
+
+ioopm_cms_t *ioopm_cms_create_with_budget(size_t memory_budget, size_t depth, ioopm_hash_function hash_func){
+  if(depth == 0) return NULL;
+
+  return ioopm_cms_create(memory_budget / (depth * sizeof(uint64_t)), depth, hash_func);
+}
+
+void ioopm_cms_destroy(ioopm_cms_t *cms){
+  if(!cms) return;
+
+  free(cms->counters);
+  free(cms);
+}
+
+void ioopm_cms_add(ioopm_cms_t *cms, elem_t key, uint64_t count){
+  if(!cms) return;
+
+  size_t columns[Cms_Max_Depth];
+  key_columns(cms, key, columns);
+
+  uint64_t minimum = UINT64_MAX;
+  for(size_t row = 0; row < cms->depth; ++row){
+    if(cms->counters[columns[row]] < minimum) minimum = cms->counters[columns[row]];
+  }
+
+  // Conservative update: raise each counter only as far as the new estimate
+  uint64_t estimate = minimum + count;
+  for(size_t row = 0; row < cms->depth; ++row){
+    if(cms->counters[columns[row]] < estimate) cms->counters[columns[row]] = estimate;
+  }
+
+  cms->total += count;
+}
+
+uint64_t ioopm_cms_estimate(ioopm_cms_t *cms, elem_t key){
+  if(!cms) return 0;
+
+  size_t columns[Cms_Max_Depth];
+  key_columns(cms, key, columns);
+
+  uint64_t minimum = UINT64_MAX;
+  for(size_t row = 0; row < cms->depth; ++row){
+    if(cms->counters[columns[row]] < minimum) minimum = cms->counters[columns[row]];
+  }
+
+  return minimum;
+}
+
+uint64_t ioopm_cms_total(ioopm_cms_t *cms){
+  return cms ? cms->total : 0;
+}
+
+size_t ioopm_cms_width(ioopm_cms_t *cms){
+  return cms ? cms->width : 0;
+}
+
+size_t ioopm_cms_depth(ioopm_cms_t *cms){
+  return cms ? cms->depth : 0;
+}
+
+bool ioopm_cms_merge(ioopm_cms_t *dst, ioopm_cms_t *src){
+  if(!dst || !src) return false;
+  if(dst->width != src->width || dst->depth != src->depth || dst->hash_func != src->hash_func) return false;
+
+  size_t no_counters = dst->width * dst->depth;
+  for(size_t i = 0; i < no_counters; ++i){
+    dst->counters[i] += src->counters[i];
+  }
+  dst->total += src->total;
+
+  return true;
+}
+
+bool ioopm_cms_save(ioopm_cms_t *cms, FILE *out){
+  if(!cms || !out) return false;
+
+  uint64_t header[3] = {cms->width, cms->depth, cms->total};
+  size_t no_counters = cms->width * cms->depth;
+
+  return fwrite(Cms_Magic, 1, sizeof(Cms_Magic), out) == sizeof(Cms_Magic)
+      && fwrite(header, sizeof(uint64_t), 3, out) == 3
+      && fwrite(cms->counters, sizeof(uint64_t), no_counters, out) == no_counters;
+}
+
+ioopm_cms_t *ioopm_cms_load(FILE *in, ioopm_hash_function hash_func){
+  if(!in) return NULL;
+
+  char magic[sizeof(Cms_Magic)];
+  uint64_t header[3];
+  if(fread(magic, 1, sizeof(magic), in) != sizeof(magic) || memcmp(magic, Cms_Magic, sizeof(magic)) != 0){
+    return NULL;
+  }
+  if(fread(header, sizeof(uint64_t), 3, in) != 3){
+    return NULL;
+  }
+
+  ioopm_cms_t *cms = ioopm_cms_create(header[0], header[1], hash_func);
+  if(!cms) return NULL;
+
+  size_t no_counters = cms->width * cms->depth;
+  if(fread(cms->counters, sizeof(uint64_t), no_counters, in) != no_counters){
+    ioopm_cms_destroy(cms);
+    return NULL;
+  }
+  cms->total = header[2];
+
+  return cms;
+}
@@ -0,0 +1,122 @@
+// count_min_sketch.h
+
+#ifndef COUNT_MIN_SKETCH_H
+#define COUNT_MIN_SKETCH_H
+
+/**
+ * @file count_min_sketch.h
+ * @brief Count-Min Sketch for approximate counting of unbounded streams.
+ *
+ * A sketch of width w and depth d uses w * d counters no matter how many
+ * distinct keys are counted. Estimates never undercount, and with
+ * w = ceil(e / epsilon) and d = ceil(ln(1 / delta)) they overcount by more
+ * than epsilon * total with probability at most delta. Updates are
+ * conservative (only the smallest counters are raised), which keeps the
+ * overestimate lower than in the plain sketch.
+ */
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "hash_table.h"
+
+/// Largest supported depth (delta = e^-64 is far below any practical need).
+#define Cms_Max_Depth 64
+
+/*
+ * =========================================
+ * SECTION: Custom Data Types And Aliases
+ * =========================================
+ */
+
+typedef struct count_min_sketch ioopm_cms_t;
+
+
+/*
+ * =========================================
+ * SECTION: Function Declarations
+ * =========================================
+ */
+
+/// @brief Create a new, empty sketch with the given dimensions.
+/// @param width Number of counters per row (controls the error, epsilon = e / width).
+/// @param depth Number of rows (controls the confidence, delta = e^-depth), at most Cms_Max_Depth.
+/// @param hash_func Function used to hash keys.
+/// @return A new sketch, or NULL if an argument is invalid or memory allocation fails.
+ioopm_cms_t *ioopm_cms_create(size_t width, size_t depth, ioopm_hash_function hash_func);
+
+/// @brief Create a new, empty sketch from error bounds.
+/// @param epsilon Maximum overestimate as a fraction of the total count, in (0, 1).
+/// @param delta Probability that an estimate exceeds that bound, in (0, 1).
+/// @param hash_func Function used to hash keys.
+/// @return A new sketch, or NULL if an argument is invalid or memory allocation fails.
+ioopm_cms_t *ioopm_cms_create_with_error(double epsilon, double delta, ioopm_hash_function hash_func);
+
+/// @brief Create the widest sketch of a given depth that fits in a memory budget.
+/// @param memory_budget Maximum number of bytes used by the counters.
+/// @param depth Number of rows.
+/// @param hash_func Function used to hash keys.
+/// @return A new sketch, or NULL if the budget is too small or memory allocation fails.
+ioopm_cms_t *ioopm_cms_create_with_budget(size_t memory_budget, size_t depth, ioopm_hash_function hash_func);
+
+/// @brief Delete a sketch and free its memory.
+/// @param cms The sketch to delete.
+void ioopm_cms_destroy(ioopm_cms_t *cms);
+
+/// @brief Count a key (conservative update).
+/// @param cms The sketch operated upon.
+/// @param key The key to count.
+/// @param count How many occurrences to add.
+void ioopm_cms_add(ioopm_cms_t *cms, elem_t key, uint64_t count);
+
+/// @brief Estimate how many times a key has been counted.
+/// @param cms The sketch operated upon.
+/// @param key The key to estimate.
+/// @return An estimate that is never lower than the true count.
+uint64_t ioopm_cms_estimate(ioopm_cms_t *cms, elem_t key);
+
+/// @brief Returns the total of all counts added to the sketch.
+/// @param cms The sketch operated upon.
+/// @return The total count.
+uint64_t ioopm_cms_total(ioopm_cms_t *cms);
+
+/// @brief Returns the width of the sketch.
+/// @param cms The sketch operated upon.
+/// @return The number of counters per row.
+size_t ioopm_cms_width(ioopm_cms_t *cms);
+
+/// @brief Returns the depth of the sketch.
+/// @param cms The sketch operated upon.
+/// @return The number of rows.
+size_t ioopm_cms_depth(ioopm_cms_t *cms);
+
+/// @brief Add all counts of src into dst, e.g. to combine the sketches of several workers.
+/// @param dst The sketch that receives the counts.
+/// @param src The sketch to add; left unchanged.
+/// @return true on success, false if the sketches differ in dimensions or hash function.
+bool ioopm_cms_merge(ioopm_cms_t *dst, ioopm_cms_t *src);
+
+/// @brief Write a sketch to a binary stream.
+/// @param cms The sketch to save.
+/// @param out The stream to write to.
+/// @return true on success, false on a write error.
+/// @note Counters are written in the byte order of the host.
+bool ioopm_cms_save(ioopm_cms_t *cms, FILE *out);
+
+/// @brief Read a sketch written by ioopm_cms_save.
+/// @param in The stream to read from.
+/// @param hash_func Function used to hash keys; must be the one the sketch was built with.
+/// @return The loaded sketch, or NULL if the stream is not a valid sketch or memory allocation fails.
+ioopm_cms_t *ioopm_cms_load(FILE *in, ioopm_hash_function hash_func);
+
+
+
+#endif // COUNT_MIN_SKETCH_H
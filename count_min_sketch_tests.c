@@ -0,0 +1,200 @@
+// count_min_sketch_tests.c
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include <CUnit/Basic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "count_min_sketch.h"
+
+/// @brief Number of distinct keys used in the accuracy tests.
+#define NUM_KEYS 10000
+
+
+/*
+ * =========================================
+ * SECTION: Private Function Definitions
+ * =========================================
+ */
+
+/// @brief Hash function for integer keys.
+/// @param key The key to hash.
+/// @return The hash value.
+static size_t int_hash_function(elem_t key) {
+    return (size_t)key.intValue;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Initialize and clean the suite
+ * =========================================
+ */
+
+int init_suite(void) {
+  return 0;
+}
+
+int clean_suite(void) {
+  return 0;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Tests
+ * =========================================
+ */
+
+void test_create_destroy() {
+  ioopm_cms_t *cms = ioopm_cms_create(1000, 4, int_hash_function);
+  CU_ASSERT_PTR_NOT_NULL(cms);
+  CU_ASSERT_EQUAL(ioopm_cms_width(cms), 1000);
+  CU_ASSERT_EQUAL(ioopm_cms_depth(cms), 4);
+  CU_ASSERT_EQUAL(ioopm_cms_total(cms), 0);
+  ioopm_cms_destroy(cms);
+
+  CU_ASSERT_PTR_NULL(ioopm_cms_create(0, 4, int_hash_function));
+  CU_ASSERT_PTR_NULL(ioopm_cms_create(10, 0, int_hash_function));
+  CU_ASSERT_PTR_NULL(ioopm_cms_create(10, Cms_Max_Depth + 1, int_hash_function));
+  CU_ASSERT_PTR_NULL(ioopm_cms_create(10, 4, NULL));
+  CU_ASSERT_PTR_NULL(ioopm_cms_create_with_error(0, 0.1, int_hash_function));
+  CU_ASSERT_PTR_NULL(ioopm_cms_create_with_budget(16, 4, int_hash_function));
+}
+
+void test_create_with_error_and_budget() {
+  ioopm_cms_t *cms = ioopm_cms_create_with_error(0.001, 0.01, int_hash_function);
+  CU_ASSERT(ioopm_cms_width(cms) >= 2718);
+  CU_ASSERT_EQUAL(ioopm_cms_depth(cms), 5);
+  ioopm_cms_destroy(cms);
+
+  cms = ioopm_cms_create_with_budget(1 << 16, 4, int_hash_function);
+  CU_ASSERT_EQUAL(ioopm_cms_width(cms) * ioopm_cms_depth(cms) * sizeof(uint64_t), 1 << 16);
+  ioopm_cms_destroy(cms);
+}
+
+void test_estimates_are_bounded() {
+  ioopm_cms_t *cms = ioopm_cms_create_with_error(0.001, 0.01, int_hash_function);
+
+  // Key i is counted i % 100 + 1 times
+  for (int i = 0; i < NUM_KEYS; ++i) {
+    ioopm_cms_add(cms, int_elem(i), i % 100 + 1);
+  }
+
+  uint64_t total = ioopm_cms_total(cms);
+  size_t too_high = 0;
+  for (int i = 0; i < NUM_KEYS; ++i) {
+    uint64_t estimate = ioopm_cms_estimate(cms, int_elem(i));
+    CU_ASSERT(estimate >= (uint64_t)(i % 100 + 1));
+    if (estimate > (uint64_t)(i % 100 + 1) + total / 1000) {
+      too_high++;
+    }
+  }
+  CU_ASSERT(too_high < NUM_KEYS / 100);
+
+  ioopm_cms_destroy(cms);
+}
+
+void test_merge() {
+  ioopm_cms_t *a = ioopm_cms_create(2000, 4, int_hash_function);
+  ioopm_cms_t *b = ioopm_cms_create(2000, 4, int_hash_function);
+  ioopm_cms_t *other = ioopm_cms_create(1000, 4, int_hash_function);
+
+  ioopm_cms_add(a, int_elem(1), 5);
+  ioopm_cms_add(b, int_elem(1), 7);
+  ioopm_cms_add(b, int_elem(2), 3);
+
+  CU_ASSERT_TRUE(ioopm_cms_merge(a, b));
+  CU_ASSERT_EQUAL(ioopm_cms_total(a), 15);
+  CU_ASSERT(ioopm_cms_estimate(a, int_elem(1)) >= 12);
+  CU_ASSERT(ioopm_cms_estimate(a, int_elem(2)) >= 3);
+  CU_ASSERT_EQUAL(ioopm_cms_total(b), 10);
+
+  CU_ASSERT_FALSE(ioopm_cms_merge(a, other));
+
+  ioopm_cms_destroy(a);
+  ioopm_cms_destroy(b);
+  ioopm_cms_destroy(other);
+}
+
+void test_save_load() {
+  ioopm_cms_t *cms = ioopm_cms_create(500, 3, int_hash_function);
+  for (int i = 0; i < 1000; ++i) {
+    ioopm_cms_add(cms, int_elem(i % 50), 1);
+  }
+
+  FILE *f = tmpfile();
+  CU_ASSERT_TRUE(ioopm_cms_save(cms, f));
+  rewind(f);
+  ioopm_cms_t *loaded = ioopm_cms_load(f, int_hash_function);
+  fclose(f);
+
+  CU_ASSERT_PTR_NOT_NULL(loaded);
+  CU_ASSERT_EQUAL(ioopm_cms_width(loaded), 500);
+  CU_ASSERT_EQUAL(ioopm_cms_depth(loaded), 3);
+  CU_ASSERT_EQUAL(ioopm_cms_total(loaded), 1000);
+  for (int i = 0; i < 50; ++i) {
+    CU_ASSERT_EQUAL(ioopm_cms_estimate(loaded, int_elem(i)), ioopm_cms_estimate(cms, int_elem(i)));
+  }
+
+  // Garbage is rejected
+  f = tmpfile();
+  fputs("not a sketch", f);
+  rewind(f);
+  CU_ASSERT_PTR_NULL(ioopm_cms_load(f, int_hash_function));
+  fclose(f);
+
+  ioopm_cms_destroy(cms);
+  ioopm_cms_destroy(loaded);
+}
+
+
+/*
+ * =========================================
+ * SECTION: Main
+ * =========================================
+ */
+
+int main() {
+  // First we try to set up CUnit, and exit if we fail
+  if (CU_initialize_registry() != CUE_SUCCESS)
+    return CU_get_error();
+
+  // We then create an empty test suite and specify the name and
+  // the init and cleanup functions
+  CU_pSuite my_test_suite = CU_add_suite("Unit tests for count-min sketch", init_suite, clean_suite);
+  if (my_test_suite == NULL) {
+      // If the test suite could not be added, tear down CUnit and exit
+      CU_cleanup_registry();
+      return CU_get_error();
+  }
+
+  if (
+    (CU_add_test(my_test_suite, "Create and destroy sketch", test_create_destroy) == NULL) ||
+    (CU_add_test(my_test_suite, "Create from error bounds and memory budget", test_create_with_error_and_budget) == NULL) ||
+    (CU_add_test(my_test_suite, "Estimates never undercount and rarely exceed the bound", test_estimates_are_bounded) == NULL) ||
+    (CU_add_test(my_test_suite, "Merge sketches", test_merge) == NULL) ||
+    (CU_add_test(my_test_suite, "Save and load a sketch", test_save_load) == NULL) ||
+    0
+  )
+    {
+      // If adding any of the tests fails, we tear down CUnit and exit
+      CU_cleanup_registry();
+      return CU_get_error();
+    }
+
+  // Set the running mode. Use CU_BRM_VERBOSE for maximum output.
+  // Use CU_BRM_NORMAL to only print errors and a summary
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+
+  // This is where the tests are actually run!
+  CU_basic_run_tests();
+
+  // Tear down CUnit before exiting
+  CU_cleanup_registry();
+  return CU_get_error();
+}
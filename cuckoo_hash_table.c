@@ -0,0 +1,459 @@
+// cuckoo_hash_table.c
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "cuckoo_hash_table.h"
+
+/// Size of a cache line, the size and alignment of a bucket.
+#define Cache_Line 64
+
+/// Number of buckets of a new table.
+#define Min_Buckets 16
+
+/// Longest random walk of displacements before the table is rebuilt; walks get long close to
+/// the ~95.9% threshold of three-slot buckets, which Cuckoo_Max_Load_Percent is near.
+#define Max_Displacements 5000
+
+/// Rebuilds try this many new hash functions per size before doubling the size.
+#define Rehashes_Per_Size 4
+
+/// Rebuilds give up after this many attempts (the hash function is then degenerate).
+#define Max_Rebuild_Attempts 16
+
+/*
+ * =========================================
+ * SECTION: Custom Data Types And Aliases
+ * =========================================
+ */
+
+/// The keys, values and tags of one bucket share exactly one cache line. A tag is 0 for an
+/// empty slot, otherwise 8 bits of the key's hash.
+typedef struct
+{
+  elem_t keys[Cuckoo_Slots];
+  elem_t values[Cuckoo_Slots];
+  uint8_t tags[Cuckoo_Slots];
+} __attribute__((aligned(Cache_Line))) bucket_t;
+
+_Static_assert(sizeof(bucket_t) == Cache_Line, "a bucket is one cache line");
+
+/// The two candidate buckets and the tag of a key.
+typedef struct
+{
+  size_t first;
+  size_t second;
+  uint8_t tag;
+} position_t;
+
+/// The stash holds one entry that could not be placed when a rebuild failed for lack of memory.
+struct cuckoo_table
+{
+  bucket_t *buckets;
+  size_t no_buckets;                  /// Always a power of two.
+  size_t size;                        /// Number of entries, including the stash.
+  uint64_t seed;                      /// Selects the pair of hash functions, changed by every rebuild.
+  uint64_t random;                    /// State of the generator that picks displacement victims.
+  bool has_stash;
+  elem_t stash_key;
+  elem_t stash_value;
+  ioopm_hash_function hash_func;
+  ioopm_eq_function key_eq_func;
+  ioopm_eq_function value_eq_func;
+};
+
+
+/*
+ * =========================================
+ * SECTION: Function Definitions
+ * =========================================
+ */
+
+/// @brief Computes the candidate buckets and tag of a key.
+/// @param ct The table.
+/// @param key The key.
+/// @return The position of the key.
+static position_t key_position(ioopm_cuckoo_table_t *ct, elem_t key){
+  uint64_t hash = ioopm_mix_hash(ct->hash_func(key) ^ ct->seed);
+  size_t mask = ct->no_buckets - 1;
+
+  position_t position;
+  position.first = hash & mask;
+  position.second = ioopm_mix_hash(hash) & mask;
+  if(position.second == position.first) position.second = (position.first + 1) & mask;
+  position.tag = (uint8_t)(hash >> 56);
+  if(position.tag == 0) position.tag = 1;
+
+  return position;
+}
+
+/// @brief Returns the next number of a xorshift generator.
+/// @param ct The table holding the generator state.
+static uint64_t next_random(ioopm_cuckoo_table_t *ct){
+  ct->random ^= ct->random << 13;
+  ct->random ^= ct->random >> 7;
+  ct->random ^= ct->random << 17;
+  return ct->random;
+}
+
+/// @brief Finds the slot of a key in its two buckets.
+/// @param ct The table.
+/// @param key The key.
+/// @param bucket Pointer to store the bucket index in.
+/// @param slot Pointer to store the slot index in.
+/// @return true if found, false otherwise (the stash is not searched).
+static bool find_slot(ioopm_cuckoo_table_t *ct, elem_t key, size_t *bucket, size_t *slot){
+  position_t position = key_position(ct, key);
+  size_t candidates[2] = {position.first, position.second};
+
+  for(size_t i = 0; i < 2; ++i){
+    bucket_t *candidate = &ct->buckets[candidates[i]];
+    for(size_t s = 0; s < Cuckoo_Slots; ++s){
+      if(candidate->tags[s] == position.tag && ct->key_eq_func(candidate->keys[s], key)){
+        *bucket = candidates[i];
+        *slot = s;
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+/// @brief Stores an entry in the first empty slot of a bucket.
+/// @return true if the bucket had an empty slot, false otherwise.
+static bool put_in_free_slot(ioopm_cuckoo_table_t *ct, size_t bucket, elem_t key, elem_t value, uint8_t tag){
+  for(size_t s = 0; s < Cuckoo_Slots; ++s){
+    if(ct->buckets[bucket].tags[s] == 0){
+      ct->buckets[bucket].tags[s] = tag;
+      ct->buckets[bucket].keys[s] = key;
+      ct->buckets[bucket].values[s] = value;
+      return true;
+    }
+  }
+  return false;
+}
+
+/// @brief Places an entry whose key is not in the table, displacing residents if both buckets are full.
+/// @param ct The table.
+/// @param key Pointer to the key; on failure it holds the key of the entry left without a slot.
+/// @param value Pointer to the value; on failure it holds the value of that entry.
+/// @return true if every entry has a slot, false if the walk got too long.
+/// @note size is not updated.
+static bool place(ioopm_cuckoo_table_t *ct, elem_t *key, elem_t *value){
+  position_t position = key_position(ct, *key);
+  if(put_in_free_slot(ct, position.first, *key, *value, position.tag)) return true;
+  if(put_in_free_slot(ct, position.second, *key, *value, position.tag)) return true;
+
+  size_t bucket = next_random(ct) & 1 ? position.first : position.second;
+  uint8_t tag = position.tag;
+
+  for(size_t i = 0; i < Max_Displacements; ++i){
+    // Swap in the homeless entry for a random resident, which then moves to its other bucket
+    size_t s = next_random(ct) % Cuckoo_Slots;
+    elem_t victim_key = ct->buckets[bucket].keys[s];
+    elem_t victim_value = ct->buckets[bucket].values[s];
+
+    ct->buckets[bucket].tags[s] = tag;
+    ct->buckets[bucket].keys[s] = *key;
+    ct->buckets[bucket].values[s] = *value;
+    *key = victim_key;
+    *value = victim_value;
+
+    position = key_position(ct, *key);
+    bucket = position.first == bucket ? position.second : position.first;
+    tag = position.tag;
+    if(put_in_free_slot(ct, bucket, *key, *value, tag)) return true;
+  }
+
+  return false;
+}
+
+/// @brief Steps through the entries of a table, the stash last.
+/// @param ct The table.
+/// @param cursor Iteration state, start at 0.
+/// @param key Pointer to store a pointer to the key in.
+/// @param value Pointer to store a pointer to the value in.
+/// @return true if an entry was found, false when all entries have been visited.
+static bool next_entry(ioopm_cuckoo_table_t *ct, size_t *cursor, elem_t **key, elem_t **value){
+  size_t capacity = ct->no_buckets * Cuckoo_Slots;
+
+  while(*cursor < capacity){
+    size_t bucket = *cursor / Cuckoo_Slots;
+    size_t slot = *cursor % Cuckoo_Slots;
+    (*cursor)++;
+
+    if(ct->buckets[bucket].tags[slot]){
+      *key = &ct->buckets[bucket].keys[slot];
+      *value = &ct->buckets[bucket].values[slot];
+      return true;
+    }
+  }
+
+  if(*cursor == capacity){
+    (*cursor)++;
+    if(ct->has_stash){
+      *key = &ct->stash_key;
+      *value = &ct->stash_value;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/// @brief Allocates empty buckets for a table.
+/// @return true on success, false if memory allocation fails.
+static bool allocate_buckets(ioopm_cuckoo_table_t *ct, size_t no_buckets){
+  ct->buckets = aligned_alloc(Cache_Line, no_buckets * sizeof(bucket_t));
+  if(!ct->buckets) return false;
+
+  memset(ct->buckets, 0, no_buckets * sizeof(bucket_t));
+  ct->no_buckets = no_buckets;
+  return true;
+}
+
+/// @brief Moves all entries, plus an optional pending one, into new buckets with new hash functions.
+/// @param ct The table.
+/// @param no_buckets The number of buckets to start with (doubled after Rehashes_Per_Size failures).
+/// @param has_pending Whether key and value must be placed too.
+/// @param key The pending key.
+/// @param value The pending value.
+/// @return true on success, false if memory allocation or every attempt fails (the table is then unchanged).
+/// @note The stash is not carried over, pass it as the pending entry. size is not updated.
+static bool rebuild(ioopm_cuckoo_table_t *ct, size_t no_buckets, bool has_pending, elem_t key, elem_t value){
+  for(size_t attempt = 0; attempt < Max_Rebuild_Attempts; ++attempt){
+    if(attempt > 0 && attempt % Rehashes_Per_Size == 0) no_buckets *= 2;
+
+    ioopm_cuckoo_table_t fresh = *ct;
+    fresh.has_stash = false;
+    fresh.seed = ioopm_mix_hash(ct->seed + attempt + 1);
+    if(!allocate_buckets(&fresh, no_buckets)) return false;
+
+    elem_t pending_key = key;
+    elem_t pending_value = value;
+    bool placed = !has_pending || place(&fresh, &pending_key, &pending_value);
+
+    for(size_t b = 0; placed && b < ct->no_buckets; ++b){
+      for(size_t s = 0; placed && s < Cuckoo_Slots; ++s){
+        if(ct->buckets[b].tags[s] == 0) continue;
+        pending_key = ct->buckets[b].keys[s];
+        pending_value = ct->buckets[b].values[s];
+        placed = place(&fresh, &pending_key, &pending_value);
+      }
+    }
+
+    if(placed){
+      free(ct->buckets);
+      *ct = fresh;
+      return true;
+    }
+
+    free(fresh.buckets);
+  }
+
+  return false;
+}
+
+
+ioopm_cuckoo_table_t *ioopm_cuckoo_table_create(ioopm_hash_function hash_func, ioopm_eq_function key_eq_func, ioopm_eq_function value_eq_func){
+  ioopm_cuckoo_table_t *ct = calloc(1, sizeof(ioopm_cuckoo_table_t));
+  if(!ct) return NULL;
+
+  if(!allocate_buckets(ct, Min_Buckets)){
+    free(ct);
+    return NULL;
+  }
+
+  ct->seed = 0x9e3779b97f4a7c15ULL;
+  ct->random = ct->seed;
+  ct->hash_func = hash_func;
+  ct->key_eq_func = key_eq_func;
+  ct->value_eq_func = value_eq_func;
+
+  return ct;
+}
+
+void ioopm_cuckoo_table_destroy(ioopm_cuckoo_table_t *ct){
+  if(!ct) return;
+
+  free(ct->buckets);
+  free(ct);
+}
+
+bool ioopm_cuckoo_table_insert(ioopm_cuckoo_table_t *ct, elem_t key, elem_t value){
+  if(!ct) return false;
+
+  size_t bucket, slot;
+  if(find_slot(ct, key, &bucket, &slot)){
+    ct->buckets[bucket].values[slot] = value;
+    return true;
+  }
+  if(ct->has_stash && ct->key_eq_func(ct->stash_key, key)){
+    ct->stash_value = value;
+    return true;
+  }
+
+  // The stash holds a single entry, so it has to be emptied before anything else can be displaced
+  if(ct->has_stash && !rebuild(ct, ct->no_buckets, true, ct->stash_key, ct->stash_value)) return false;
+
+  if((ct->size + 1) * 100 > ioopm_cuckoo_table_capacity(ct) * Cuckoo_Max_Load_Percent){
+    if(!rebuild(ct, ct->no_buckets * 2, true, key, value)) return false;
+    ct->size++;
+    return true;
+  }
+
+  // On failure the new key is in, but a displaced entry is left over
+  if(!place(ct, &key, &value) && !rebuild(ct, ct->no_buckets, true, key, value)){
+    ct->has_stash = true;
+    ct->stash_key = key;
+    ct->stash_value = value;
+  }
+  ct->size++;
+
+  return true;
+}
+
+option_t ioopm_cuckoo_table_lookup(ioopm_cuckoo_table_t *ct, elem_t key){
+  if(!ct) return Failure();
+
+  size_t bucket, slot;
+  if(find_slot(ct, key, &bucket, &slot)) return Success(ct->buckets[bucket].values[slot]);
+  if(ct->has_stash && ct->key_eq_func(ct->stash_key, key)) return Success(ct->stash_value);
+
+  return Failure();
+}
+
+option_t ioopm_cuckoo_table_remove(ioopm_cuckoo_table_t *ct, elem_t key){
+  if(!ct) return Failure();
+
+  size_t bucket, slot;
+  if(find_slot(ct, key, &bucket, &slot)){
+    ct->buckets[bucket].tags[slot] = 0;
+    ct->size--;
+    return Success(ct->buckets[bucket].values[slot]);
+  }
+  if(ct->has_stash && ct->key_eq_func(ct->stash_key, key)){
+    ct->has_stash = false;
+    ct->size--;
+    return Success(ct->stash_value);
+  }
+
+  return Failure();
+}
+
+size_t ioopm_cuckoo_table_size(ioopm_cuckoo_table_t *ct){
+  return ct ? ct->size : 0;
+}
+
+size_t ioopm_cuckoo_table_capacity(ioopm_cuckoo_table_t *ct){
+  return ct ? ct->no_buckets * Cuckoo_Slots : 0;
+}
+
+bool ioopm_cuckoo_table_is_empty(ioopm_cuckoo_table_t *ct){
+  return ioopm_cuckoo_table_size(ct) == 0;
+}
+
+void ioopm_cuckoo_table_clear(ioopm_cuckoo_table_t *ct){
+  if(!ct) return;
+
+  for(size_t b = 0; b < ct->no_buckets; ++b){
+    memset(ct->buckets[b].tags, 0, sizeof(ct->buckets[b].tags));
+  }
+  ct->size = 0;
+  ct->has_stash = false;
+}
+
+bool ioopm_cuckoo_table_reserve(ioopm_cuckoo_table_t *ct, size_t no_keys){
+  if(!ct) return false;
+
+  size_t no_buckets = ct->no_buckets;
+  while(no_keys * 100 > no_buckets * Cuckoo_Slots * Cuckoo_Max_Load_Percent){
+    no_buckets *= 2;
+  }
+  if(no_buckets == ct->no_buckets) return true;
+
+  return rebuild(ct, no_buckets, ct->has_stash, ct->stash_key, ct->stash_value);
+}
+
+bool ioopm_cuckoo_table_has_key(ioopm_cuckoo_table_t *ct, elem_t key){
+  return Successful(ioopm_cuckoo_table_lookup(ct, key));
+}
+
+bool ioopm_cuckoo_table_has_value(ioopm_cuckoo_table_t *ct, elem_t value){
+  if(!ct || !ct->value_eq_func) return false;
+
+  size_t cursor = 0;
+  elem_t *key, *current;
+  while(next_entry(ct, &cursor, &key, &current)){
+    if(ct->value_eq_func(*current, value)) return true;
+  }
+
+  return false;
+}
+
+ioopm_list_t *ioopm_cuckoo_table_keys(ioopm_cuckoo_table_t *ct){
+  if(!ct) return NULL;
+
+  ioopm_list_t *keys = ioopm_linked_list_create(ct->key_eq_func);
+  size_t cursor = 0;
+  elem_t *key, *value;
+  while(next_entry(ct, &cursor, &key, &value)){
+    ioopm_linked_list_append(keys, *key);
+  }
+
+  return keys;
+}
+
+ioopm_list_t *ioopm_cuckoo_table_values(ioopm_cuckoo_table_t *ct){
+  if(!ct) return NULL;
+
+  ioopm_list_t *values = ioopm_linked_list_create(ct->value_eq_func);
+  size_t cursor = 0;
+  elem_t *key, *value;
+  while(next_entry(ct, &cursor, &key, &value)){
+    ioopm_linked_list_append(values, *value);
+  }
+
+  return values;
+}
+
+bool ioopm_cuckoo_table_any(ioopm_cuckoo_table_t *ct, ioopm_predicate pred, void *arg){
+  if(!ct || !pred) return false;
+
+  size_t cursor = 0;
+  elem_t *key, *value;
+  while(next_entry(ct, &cursor, &key, &value)){
+    if(pred(*key, *value, arg)) return true;
+  }
+
+  return false;
+}
+
+bool ioopm_cuckoo_table_all(ioopm_cuckoo_table_t *ct, ioopm_predicate pred, void *arg){
+  if(!ct || !pred) return false;
+
+  size_t cursor = 0;
+  elem_t *key, *value;
+  while(next_entry(ct, &cursor, &key, &value)){
+    if(!pred(*key, *value, arg)) return false;
+  }
+
+  return true;
+}
+
+void ioopm_cuckoo_table_apply_to_all(ioopm_cuckoo_table_t *ct, ioopm_apply_function apply_fun, void *arg){
+  if(!ct || !apply_fun) return;
+
+  size_t cursor = 0;
+  elem_t *key, *value;
+  while(next_entry(ct, &cursor, &key, &value)){
+    apply_fun(*key, value, arg);
+  }
+}
@@ -0,0 +1,158 @@
+// cuckoo_hash_table.h
+
+#ifndef CUCKOO_HASH_TABLE_H
+#define CUCKOO_HASH_TABLE_H
+
+/**
+ * @file cuckoo_hash_table.h
+ * @brief Bucketized cuckoo hash table with a bounded number of probes per lookup.
+ *
+ * Every key lives in one of two candidate buckets, chosen by two hash
+ * functions derived from the user's hash function. A bucket holds
+ * Cuckoo_Slots keys and values and an 8-bit tag per slot in exactly one
+ * 64-byte cache line, so a lookup reads at most two cache lines. The tags
+ * filter out almost all key comparisons.
+ * Inserting into two full buckets moves residents to their other bucket
+ * (a random walk). When that walk gets too long the table is rehashed with
+ * new hash functions, and grown if that does not help. The table grows
+ * before it exceeds Cuckoo_Max_Load_Percent full.
+ *
+ * Keys and values are elem_t and the functions follow hash_table.h, except
+ * that insert reports failure (memory allocation) and the table can be
+ * sized in advance with ioopm_cuckoo_table_reserve.
+ */
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "hash_table.h"
+
+/// Keys per bucket (3 keys, 3 values and 3 tags fit in one cache line).
+#define Cuckoo_Slots 3
+
+/// The table grows before more than this percentage of its slots are used; two choices of
+/// three-slot buckets can be filled to about 95.9% before displacement walks stop ending.
+#define Cuckoo_Max_Load_Percent 95
+
+/*
+ * =========================================
+ * SECTION: Custom Data Types And Aliases
+ * =========================================
+ */
+
+typedef struct cuckoo_table ioopm_cuckoo_table_t;
+
+
+/*
+ * =========================================
+ * SECTION: Function Declarations
+ * =========================================
+ */
+
+/// @brief Create a new, empty cuckoo hash table.
+/// @param hash_func Function used to hash keys (the result is mixed before use).
+/// @param key_eq_func Function used to compare keys for equality.
+/// @param value_eq_func Function used to compare values, only needed by has_value.
+/// @return A new table, or NULL if memory allocation fails.
+ioopm_cuckoo_table_t *ioopm_cuckoo_table_create(ioopm_hash_function hash_func, ioopm_eq_function key_eq_func, ioopm_eq_function value_eq_func);
+
+/// @brief Delete a table and free its memory (keys and values are not freed).
+/// @param ct Table to delete.
+void ioopm_cuckoo_table_destroy(ioopm_cuckoo_table_t *ct);
+
+/// @brief Add a key => value entry, replacing the value if the key is already present.
+/// @param ct Table operated upon.
+/// @param key Key to insert.
+/// @param value Value to insert.
+/// @return true on success, false if memory allocation fails (the table is then unchanged).
+bool ioopm_cuckoo_table_insert(ioopm_cuckoo_table_t *ct, elem_t key, elem_t value);
+
+/// @brief Lookup the value for a key.
+/// @param ct Table operated upon.
+/// @param key Key to look up.
+/// @return Success with the value if the key is present, Failure otherwise.
+option_t ioopm_cuckoo_table_lookup(ioopm_cuckoo_table_t *ct, elem_t key);
+
+/// @brief Remove an entry.
+/// @param ct Table operated upon.
+/// @param key Key to remove.
+/// @return Success with the removed value if the key was present, Failure otherwise.
+option_t ioopm_cuckoo_table_remove(ioopm_cuckoo_table_t *ct, elem_t key);
+
+/// @brief Returns the number of entries in the table.
+/// @param ct Table operated upon.
+/// @return The number of entries.
+size_t ioopm_cuckoo_table_size(ioopm_cuckoo_table_t *ct);
+
+/// @brief Returns the number of slots in the table.
+/// @param ct Table operated upon.
+/// @return The number of slots; size / capacity is the load factor.
+size_t ioopm_cuckoo_table_capacity(ioopm_cuckoo_table_t *ct);
+
+/// @brief Checks if the table is empty.
+/// @param ct Table operated upon.
+/// @return true if size == 0, false otherwise.
+bool ioopm_cuckoo_table_is_empty(ioopm_cuckoo_table_t *ct);
+
+/// @brief Remove all entries, keeping the allocated slots.
+/// @param ct Table operated upon.
+void ioopm_cuckoo_table_clear(ioopm_cuckoo_table_t *ct);
+
+/// @brief Grow the table so that it holds no_keys entries without growing again.
+/// @param ct Table operated upon.
+/// @param no_keys Number of entries to make room for.
+/// @return true on success, false if memory allocation fails (the table is then unchanged).
+bool ioopm_cuckoo_table_reserve(ioopm_cuckoo_table_t *ct, size_t no_keys);
+
+/// @brief Checks if a key is in the table.
+/// @param ct Table operated upon.
+/// @param key Key to check for.
+/// @return true if the key is present, false otherwise.
+bool ioopm_cuckoo_table_has_key(ioopm_cuckoo_table_t *ct, elem_t key);
+
+/// @brief Checks if a value is in the table.
+/// @param ct Table operated upon.
+/// @param value Value to check for.
+/// @return true if some entry has the value, false otherwise.
+bool ioopm_cuckoo_table_has_value(ioopm_cuckoo_table_t *ct, elem_t value);
+
+/// @brief Returns the keys of the table, in no particular order.
+/// @param ct Table operated upon.
+/// @return A new list of keys (to be destroyed by the caller).
+ioopm_list_t *ioopm_cuckoo_table_keys(ioopm_cuckoo_table_t *ct);
+
+/// @brief Returns the values of the table, in no particular order.
+/// @param ct Table operated upon.
+/// @return A new list of values (to be destroyed by the caller).
+ioopm_list_t *ioopm_cuckoo_table_values(ioopm_cuckoo_table_t *ct);
+
+/// @brief Checks if a predicate holds for any entry.
+/// @param ct Table operated upon.
+/// @param pred The predicate.
+/// @param arg Extra argument passed to pred.
+/// @return true if pred holds for at least one entry, false otherwise.
+bool ioopm_cuckoo_table_any(ioopm_cuckoo_table_t *ct, ioopm_predicate pred, void *arg);
+
+/// @brief Checks if a predicate holds for all entries.
+/// @param ct Table operated upon.
+/// @param pred The predicate.
+/// @param arg Extra argument passed to pred.
+/// @return true if pred holds for every entry (or the table is empty), false otherwise.
+bool ioopm_cuckoo_table_all(ioopm_cuckoo_table_t *ct, ioopm_predicate pred, void *arg);
+
+/// @brief Apply a function to every entry, which may change the values.
+/// @param ct Table operated upon.
+/// @param apply_fun Function called with each key and a pointer to its value.
+/// @param arg Extra argument passed to apply_fun.
+void ioopm_cuckoo_table_apply_to_all(ioopm_cuckoo_table_t *ct, ioopm_apply_function apply_fun, void *arg);
+
+
+
+#endif // CUCKOO_HASH_TABLE_H
@@ -0,0 +1,161 @@
+// cuckoo_hash_table_bench.c
+
+/**
+ * @file cuckoo_hash_table_bench.c
+ * @brief Insert and lookup cost of the cuckoo table at 50-95% load, next to the chained hash table.
+ *
+ * For every load factor a table reserved for Bench_Slots slots is filled to
+ * that load, then looked up with keys that are present (hits) and absent
+ * (misses) in random order. The chained table from hash_table.h gets the
+ * same keys and lookups. Build and run with: make bench_cuckoo_hash_table
+ */
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "cuckoo_hash_table.h"
+#include "hash_table.h"
+
+/// Slots of the cuckoo table in every run.
+#define Bench_Slots (Cuckoo_Slots << 17)
+
+/// Lookups timed per run, for hits and misses each.
+#define Bench_Lookups (1 << 19)
+
+/// Multiplying by an odd constant is a bijection on 32 bits, so keys i * Key_Spread are distinct.
+#define Key_Spread 2654435761u
+
+
+/*
+ * =========================================
+ * SECTION: Private Function Definitions
+ * =========================================
+ */
+
+/// @brief Hash function for integer keys.
+static size_t int_hash_function(elem_t key) {
+  return (size_t)key.uintValue;
+}
+
+/// @brief Equality function for integer keys and values.
+static bool int_eq_function(elem_t a, elem_t b) {
+  return a.uintValue == b.uintValue;
+}
+
+/// @brief Returns the current time in nanoseconds.
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/// @brief Returns the key with number i; numbers at or above the number of inserted keys are misses.
+static elem_t bench_key(size_t i) {
+  return (elem_t){.uintValue = (unsigned int)i * Key_Spread};
+}
+
+/// @brief Returns a pseudo-random index below limit (xorshift).
+static size_t random_index(uint64_t *state, size_t limit) {
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state % limit;
+}
+
+/// @brief Times insert, hit and miss of the cuckoo table filled to no_keys entries.
+/// @param no_keys Number of keys to insert.
+/// @param result Array receiving the ns/op of insert, hit and miss.
+static void bench_cuckoo(size_t no_keys, double result[3]) {
+  ioopm_cuckoo_table_t *ct = ioopm_cuckoo_table_create(int_hash_function, int_eq_function, int_eq_function);
+  ioopm_cuckoo_table_reserve(ct, Bench_Slots * Cuckoo_Max_Load_Percent / 100);
+
+  double start = now_ns();
+  for (size_t i = 0; i < no_keys; ++i) {
+    ioopm_cuckoo_table_insert(ct, bench_key(i), (elem_t){.uintValue = (unsigned int)i});
+  }
+  result[0] = (now_ns() - start) / no_keys;
+
+  uint64_t state = 88172645463325252ULL;
+  size_t found = 0;
+  start = now_ns();
+  for (size_t i = 0; i < Bench_Lookups; ++i) {
+    found += ioopm_cuckoo_table_lookup(ct, bench_key(random_index(&state, no_keys))).success;
+  }
+  result[1] = (now_ns() - start) / Bench_Lookups;
+
+  start = now_ns();
+  for (size_t i = 0; i < Bench_Lookups; ++i) {
+    found += ioopm_cuckoo_table_lookup(ct, bench_key(no_keys + random_index(&state, no_keys))).success;
+  }
+  result[2] = (now_ns() - start) / Bench_Lookups;
+
+  if (found != Bench_Lookups || ioopm_cuckoo_table_capacity(ct) != Bench_Slots) {
+    fprintf(stderr, "cuckoo table: unexpected result\n");
+  }
+  ioopm_cuckoo_table_destroy(ct);
+}
+
+/// @brief Times insert, hit and miss of the chained hash table with no_keys entries.
+/// @param no_keys Number of keys to insert.
+/// @param result Array receiving the ns/op of insert, hit and miss.
+static void bench_chained(size_t no_keys, double result[3]) {
+  ioopm_hash_table_t *ht = ioopm_hash_table_create(int_hash_function, int_eq_function, int_eq_function);
+
+  double start = now_ns();
+  for (size_t i = 0; i < no_keys; ++i) {
+    ioopm_hash_table_insert(ht, bench_key(i), (elem_t){.uintValue = (unsigned int)i});
+  }
+  result[0] = (now_ns() - start) / no_keys;
+
+  uint64_t state = 88172645463325252ULL;
+  size_t found = 0;
+  start = now_ns();
+  for (size_t i = 0; i < Bench_Lookups; ++i) {
+    found += ioopm_hash_table_lookup(ht, bench_key(random_index(&state, no_keys))).success;
+  }
+  result[1] = (now_ns() - start) / Bench_Lookups;
+
+  start = now_ns();
+  for (size_t i = 0; i < Bench_Lookups; ++i) {
+    found += ioopm_hash_table_lookup(ht, bench_key(no_keys + random_index(&state, no_keys))).success;
+  }
+  result[2] = (now_ns() - start) / Bench_Lookups;
+
+  if (found != Bench_Lookups) {
+    fprintf(stderr, "chained table: unexpected result\n");
+  }
+  ioopm_hash_table_destroy(ht);
+}
+
+
+/*
+ * =========================================
+ * SECTION: Main
+ * =========================================
+ */
+
+int main() {
+  int loads[] = {50, 60, 70, 80, 85, 90, 95};
+
+  printf("%d slots, %d lookups per column, ns/op\n", Bench_Slots, Bench_Lookups);
+  printf("load  keys    | cuckoo insert  hit    miss  | chained insert  hit    miss\n");
+
+  for (size_t i = 0; i < sizeof(loads) / sizeof(loads[0]); ++i) {
+    size_t no_keys = (size_t)Bench_Slots * loads[i] / 100;
+    double cuckoo[3], chained[3];
+    bench_cuckoo(no_keys, cuckoo);
+    bench_chained(no_keys, chained);
+
+    printf("%3d%%  %-7zu |        %6.1f %6.1f %6.1f |         %6.1f %6.1f %6.1f\n", loads[i], no_keys,
+           cuckoo[0], cuckoo[1], cuckoo[2], chained[0], chained[1], chained[2]);
+  }
+
+  return 0;
+}
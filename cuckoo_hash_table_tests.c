@@ -0,0 +1,287 @@
+// cuckoo_hash_table_tests.c
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include <CUnit/Basic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cuckoo_hash_table.h"
+
+/// @brief Number of keys used in the growth tests.
+#define NUM_KEYS 100000
+
+
+/*
+ * =========================================
+ * SECTION: Private Function Definitions
+ * =========================================
+ */
+
+/// @brief Hash function for integer keys.
+/// @param key The key to hash.
+/// @return The hash value.
+static size_t int_hash_function(elem_t key) {
+    return (size_t)key.intValue;
+}
+
+/// @brief Equality function for integer keys and values.
+/// @param a The first element.
+/// @param b The second element.
+/// @return true if they are equal.
+static bool int_eq_function(elem_t a, elem_t b) {
+    return a.intValue == b.intValue;
+}
+
+/// @brief Hash function that sends every key to the same two buckets.
+/// @param key The key (unused).
+/// @return Always 0.
+static size_t constant_hash_function(elem_t key) {
+    (void)key;
+    return 0;
+}
+
+/// @brief Predicate that checks if a value is even.
+/// @param key The key (unused).
+/// @param value The value.
+/// @param extra Unused extra parameter.
+/// @return true if the value is even.
+static bool value_is_even(elem_t key, elem_t value, void *extra) {
+    (void)key;
+    (void)extra;
+    return value.intValue % 2 == 0;
+}
+
+/// @brief Apply function that doubles a value.
+/// @param key The key (unused).
+/// @param value Pointer to the value.
+/// @param extra Unused extra parameter.
+static void double_value(elem_t key, elem_t *value, void *extra) {
+    (void)key;
+    (void)extra;
+    value->intValue *= 2;
+}
+
+/// @brief Returns the length of a list.
+/// @param list The list.
+/// @return The number of elements.
+static size_t list_size(ioopm_list_t *list) {
+    size_t size = 0;
+    ioopm_linked_list_size(list, &size);
+    return size;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Initialize and clean the suite
+ * =========================================
+ */
+
+int init_suite(void) {
+  return 0;
+}
+
+int clean_suite(void) {
+  return 0;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Tests
+ * =========================================
+ */
+
+void test_insert_lookup_remove() {
+  ioopm_cuckoo_table_t *ct = ioopm_cuckoo_table_create(int_hash_function, int_eq_function, int_eq_function);
+  CU_ASSERT_PTR_NOT_NULL(ct);
+  CU_ASSERT_TRUE(ioopm_cuckoo_table_is_empty(ct));
+  CU_ASSERT(Unsuccessful(ioopm_cuckoo_table_lookup(ct, int_elem(1))));
+
+  CU_ASSERT_TRUE(ioopm_cuckoo_table_insert(ct, int_elem(1), int_elem(10)));
+  CU_ASSERT_TRUE(ioopm_cuckoo_table_insert(ct, int_elem(2), int_elem(20)));
+  CU_ASSERT_TRUE(ioopm_cuckoo_table_insert(ct, int_elem(1), int_elem(11)));
+  CU_ASSERT_EQUAL(ioopm_cuckoo_table_size(ct), 2);
+
+  option_t found = ioopm_cuckoo_table_lookup(ct, int_elem(1));
+  CU_ASSERT(Successful(found));
+  CU_ASSERT_EQUAL(found.value.intValue, 11);
+  CU_ASSERT_TRUE(ioopm_cuckoo_table_has_key(ct, int_elem(2)));
+  CU_ASSERT_FALSE(ioopm_cuckoo_table_has_key(ct, int_elem(3)));
+
+  option_t removed = ioopm_cuckoo_table_remove(ct, int_elem(1));
+  CU_ASSERT(Successful(removed));
+  CU_ASSERT_EQUAL(removed.value.intValue, 11);
+  CU_ASSERT(Unsuccessful(ioopm_cuckoo_table_remove(ct, int_elem(1))));
+  CU_ASSERT(Unsuccessful(ioopm_cuckoo_table_lookup(ct, int_elem(1))));
+  CU_ASSERT_EQUAL(ioopm_cuckoo_table_size(ct), 1);
+
+  ioopm_cuckoo_table_destroy(ct);
+}
+
+void test_grow_keeps_entries() {
+  ioopm_cuckoo_table_t *ct = ioopm_cuckoo_table_create(int_hash_function, int_eq_function, int_eq_function);
+
+  for (int i = 0; i < NUM_KEYS; ++i) {
+    CU_ASSERT_TRUE(ioopm_cuckoo_table_insert(ct, int_elem(i), int_elem(-i)));
+  }
+  CU_ASSERT_EQUAL(ioopm_cuckoo_table_size(ct), NUM_KEYS);
+  CU_ASSERT(ioopm_cuckoo_table_size(ct) * 100 <= ioopm_cuckoo_table_capacity(ct) * Cuckoo_Max_Load_Percent);
+
+  for (int i = 0; i < NUM_KEYS; i += 2) {
+    CU_ASSERT(Successful(ioopm_cuckoo_table_remove(ct, int_elem(i))));
+  }
+  for (int i = 0; i < NUM_KEYS; ++i) {
+    option_t found = ioopm_cuckoo_table_lookup(ct, int_elem(i));
+    CU_ASSERT_EQUAL(found.success, i % 2 == 1);
+    if (found.success) CU_ASSERT_EQUAL(found.value.intValue, -i);
+  }
+  CU_ASSERT_EQUAL(ioopm_cuckoo_table_size(ct), NUM_KEYS / 2);
+
+  ioopm_cuckoo_table_destroy(ct);
+}
+
+void test_reserve_fills_to_max_load() {
+  ioopm_cuckoo_table_t *ct = ioopm_cuckoo_table_create(int_hash_function, int_eq_function, int_eq_function);
+
+  CU_ASSERT_TRUE(ioopm_cuckoo_table_reserve(ct, 1 << 14));
+  size_t capacity = ioopm_cuckoo_table_capacity(ct);
+  CU_ASSERT(capacity * Cuckoo_Max_Load_Percent >= (1 << 14) * 100);
+
+  // Filling right up to the maximum load does not grow the table
+  size_t no_keys = capacity * Cuckoo_Max_Load_Percent / 100;
+  for (size_t i = 0; i < no_keys; ++i) {
+    CU_ASSERT_TRUE(ioopm_cuckoo_table_insert(ct, int_elem((int)i * 7919), int_elem((int)i)));
+  }
+  CU_ASSERT_EQUAL(ioopm_cuckoo_table_capacity(ct), capacity);
+  for (size_t i = 0; i < no_keys; ++i) {
+    CU_ASSERT_EQUAL(ioopm_cuckoo_table_lookup(ct, int_elem((int)i * 7919)).value.intValue, (int)i);
+  }
+
+  // One more entry grows it
+  CU_ASSERT_TRUE(ioopm_cuckoo_table_insert(ct, int_elem(-1), int_elem(-1)));
+  CU_ASSERT(ioopm_cuckoo_table_capacity(ct) > capacity);
+  CU_ASSERT_EQUAL(ioopm_cuckoo_table_size(ct), no_keys + 1);
+
+  ioopm_cuckoo_table_destroy(ct);
+}
+
+void test_degenerate_hash_uses_stash() {
+  ioopm_cuckoo_table_t *ct = ioopm_cuckoo_table_create(constant_hash_function, int_eq_function, int_eq_function);
+
+  // Every key maps to the same two buckets, which hold 2 * Cuckoo_Slots entries, and one fits in the stash
+  int fitting = 2 * Cuckoo_Slots + 1;
+  for (int i = 0; i < fitting; ++i) {
+    CU_ASSERT_TRUE(ioopm_cuckoo_table_insert(ct, int_elem(i), int_elem(i)));
+  }
+  CU_ASSERT_FALSE(ioopm_cuckoo_table_insert(ct, int_elem(fitting), int_elem(fitting)));
+  CU_ASSERT_EQUAL(ioopm_cuckoo_table_size(ct), fitting);
+
+  for (int i = 0; i < fitting; ++i) {
+    CU_ASSERT_EQUAL(ioopm_cuckoo_table_lookup(ct, int_elem(i)).value.intValue, i);
+  }
+  CU_ASSERT_FALSE(ioopm_cuckoo_table_has_key(ct, int_elem(fitting)));
+
+  ioopm_list_t *keys = ioopm_cuckoo_table_keys(ct);
+  CU_ASSERT_EQUAL(list_size(keys), (size_t)fitting);
+  ioopm_linked_list_destroy(keys);
+
+  // Once there is room again the stash is emptied into the buckets
+  CU_ASSERT(Successful(ioopm_cuckoo_table_remove(ct, int_elem(0))));
+  CU_ASSERT(Successful(ioopm_cuckoo_table_remove(ct, int_elem(1))));
+  CU_ASSERT_TRUE(ioopm_cuckoo_table_insert(ct, int_elem(fitting), int_elem(fitting)));
+  for (int i = 2; i <= fitting; ++i) {
+    CU_ASSERT_EQUAL(ioopm_cuckoo_table_lookup(ct, int_elem(i)).value.intValue, i);
+  }
+
+  ioopm_cuckoo_table_destroy(ct);
+}
+
+void test_traversal() {
+  ioopm_cuckoo_table_t *ct = ioopm_cuckoo_table_create(int_hash_function, int_eq_function, int_eq_function);
+
+  CU_ASSERT_TRUE(ioopm_cuckoo_table_all(ct, value_is_even, NULL));
+  CU_ASSERT_FALSE(ioopm_cuckoo_table_any(ct, value_is_even, NULL));
+
+  for (int i = 0; i < 100; ++i) {
+    ioopm_cuckoo_table_insert(ct, int_elem(i), int_elem(i));
+  }
+  CU_ASSERT_TRUE(ioopm_cuckoo_table_any(ct, value_is_even, NULL));
+  CU_ASSERT_FALSE(ioopm_cuckoo_table_all(ct, value_is_even, NULL));
+  CU_ASSERT_TRUE(ioopm_cuckoo_table_has_value(ct, int_elem(99)));
+
+  ioopm_cuckoo_table_apply_to_all(ct, double_value, NULL);
+  CU_ASSERT_TRUE(ioopm_cuckoo_table_all(ct, value_is_even, NULL));
+  CU_ASSERT_FALSE(ioopm_cuckoo_table_has_value(ct, int_elem(99)));
+  CU_ASSERT_TRUE(ioopm_cuckoo_table_has_value(ct, int_elem(198)));
+
+  ioopm_list_t *keys = ioopm_cuckoo_table_keys(ct);
+  ioopm_list_t *values = ioopm_cuckoo_table_values(ct);
+  CU_ASSERT_EQUAL(list_size(keys), 100);
+  CU_ASSERT_EQUAL(list_size(values), 100);
+  for (int i = 0; i < 100; ++i) {
+    elem_t key, value;
+    ioopm_linked_list_get(keys, i, &key);
+    ioopm_linked_list_get(values, i, &value);
+    CU_ASSERT_EQUAL(value.intValue, 2 * key.intValue);
+  }
+  ioopm_linked_list_destroy(keys);
+  ioopm_linked_list_destroy(values);
+
+  ioopm_cuckoo_table_clear(ct);
+  CU_ASSERT_TRUE(ioopm_cuckoo_table_is_empty(ct));
+  CU_ASSERT_FALSE(ioopm_cuckoo_table_has_key(ct, int_elem(5)));
+
+  ioopm_cuckoo_table_destroy(ct);
+}
+
+
+/*
+ * =========================================
+ * SECTION: Main
+ * =========================================
+ */
+
+int main() {
+  // First we try to set up CUnit, and exit if we fail
+  if (CU_initialize_registry() != CUE_SUCCESS)
+    return CU_get_error();
+
+  // We then create an empty test suite and specify the name and
+  // the init and cleanup functions
+  CU_pSuite my_test_suite = CU_add_suite("Unit tests for cuckoo hash table", init_suite, clean_suite);
+  if (my_test_suite == NULL) {
+      // If the test suite could not be added, tear down CUnit and exit
+      CU_cleanup_registry();
+      return CU_get_error();
+  }
+
+  if (
+    (CU_add_test(my_test_suite, "Insert, lookup and remove", test_insert_lookup_remove) == NULL) ||
+    (CU_add_test(my_test_suite, "Growing keeps all entries", test_grow_keeps_entries) == NULL) ||
+    (CU_add_test(my_test_suite, "Reserved table fills to maximum load", test_reserve_fills_to_max_load) == NULL) ||
+    (CU_add_test(my_test_suite, "Degenerate hash function falls back to the stash", test_degenerate_hash_uses_stash) == NULL) ||
+    (CU_add_test(my_test_suite, "Keys, values, any, all and apply_to_all", test_traversal) == NULL) ||
+    0
+  )
+    {
+      // If adding any of the tests fails, we tear down CUnit and exit
+      CU_cleanup_registry();
+      return CU_get_error();
+    }
+
+  // Set the running mode. Use CU_BRM_VERBOSE for maximum output.
+  // Use CU_BRM_NORMAL to only print errors and a summary
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+
+  // This is where the tests are actually run!
+  CU_basic_run_tests();
+
+  // Tear down CUnit before exiting
+  CU_cleanup_registry();
+  return CU_get_error();
+}
@@ -6,47 +6,68 @@
 #include <string.h>
 #include "hash_table.h"
 #include "linked_list.h"
-#include "iterator.h"
+#include "count_min_sketch.h"
+#include "space_saving.h"
+#include "hyperloglog.h"
 
 #define Delimiters "+-#@()[]{}.,:;!? \t\n\r"
 
-static int cmpstringp(const void *p1, const void *p2)
+/// Default memory budget and depth of the sketch used by --approx
+#define Approx_Default_Budget (1 << 20)
+#define Approx_Depth 4
+
+/// Precision of the HyperLogLog used by --distinct (16 KiB, about 0.8 % standard error)
+#define Distinct_Precision 14
+
+/// Items monitored by --top K --streaming, per requested item
+#define Streaming_Capacity_Factor 10
+
+typedef void (*word_handler_t)(char *word, void *extra);
+
+static int cmp_strings(elem_t a, elem_t b)
 {
-    return strcmp(*(char *const *)p1, *(char *const *)p2);
+    return strcmp(a.ptrValue, b.ptrValue);
 }
 
-void sort_keys(char *keys[], size_t no_keys)
+elem_t copy_word(elem_t word)
 {
-    qsort(keys, no_keys, sizeof(char *), cmpstringp);
+    return (elem_t){ .ptrValue = strdup(word.ptrValue) };
 }
 
-void process_word(char *word, ioopm_hash_table_t *ht)
+void process_word(char *word, void *extra)
 {
-    elem_t key = { .ptrValue = word };
+    // New words are copied by the counter table (copy_word), existing ones are counted in place
+    if (ioopm_counter_table_increment(extra, (elem_t){ .ptrValue = word }, 1) == 0)
+    {
+        fprintf(stderr, "Failed to allocate memory for word\n");
+        exit(EXIT_FAILURE);
+    }
+}
 
-    // Check if the word is already in the hash table
-    option_t opt = ioopm_hash_table_lookup(ht, key);
+void approx_word(char *word, void *extra)
+{
+    ioopm_cms_add(extra, (elem_t){ .ptrValue = word }, 1);
+}
 
-    if (opt.success)
+void stream_word(char *word, void *extra)
+{
+    if (!ioopm_space_saving_add(extra, (elem_t){ .ptrValue = word }))
     {
-        // Key exists, increment the frequency
-        int freq = opt.value.intValue;
-        ioopm_hash_table_insert(ht, key, (elem_t){ .intValue = freq + 1 });
+        fprintf(stderr, "Failed to allocate memory for word\n");
+        exit(EXIT_FAILURE);
     }
-    else
+}
+
+void distinct_word(char *word, void *extra)
+{
+    if (!ioopm_hll_add(extra, (elem_t){ .ptrValue = word }))
     {
-        // Key does not exist, insert it with frequency 1
-        char *word_copy = strdup(word);
-        if (!word_copy)
-        {
-            fprintf(stderr, "Failed to allocate memory for word\n");
-            exit(EXIT_FAILURE);
-        }
-        ioopm_hash_table_insert(ht, (elem_t){ .ptrValue = word_copy }, (elem_t){ .intValue = 1 });
+        fprintf(stderr, "Failed to allocate memory for word\n");
+        exit(EXIT_FAILURE);
     }
 }
 
-void process_file(char *filename, ioopm_hash_table_t *ht)
+void process_file(char *filename, word_handler_t handle_word, void *extra)
 {
     FILE *f = fopen(filename, "r");
     if (!f)
@@ -65,7 +86,7 @@ void process_file(char *filename, ioopm_hash_table_t *ht)
              word != NULL;
              word = strtok(NULL, Delimiters))
         {
-            process_word(word, ht);
+            handle_word(word, extra);
         }
         free(buf);
         buf = NULL;
@@ -99,94 +120,339 @@ void free_keys(elem_t key, elem_t *value, void *extra)
     free(key.ptrValue);
 }
 
-int main(int argc, char *argv[])
+void count_exact(char *files[], int no_files)
 {
-    ioopm_hash_table_t *ht = ioopm_hash_table_create(string_sum_hash, string_eq, NULL);
+    ioopm_hash_table_t *ht = ioopm_counter_table_create(string_sum_hash, string_eq, copy_word);
 
-    if (argc > 1)
+    for (int i = 0; i < no_files; ++i)
     {
-        for (int i = 1; i < argc; ++i)
-        {
-            process_file(argv[i], ht);
-        }
+        process_file(files[i], process_word, ht);
+    }
 
-        // Get the keys as a list
-        ioopm_list_t *keys_list = ioopm_hash_table_keys(ht);
+    // Get the keys as a list and sort it in place
+    ioopm_list_t *keys_list = ioopm_hash_table_keys(ht);
+    ioopm_status_t status = ioopm_linked_list_sort(keys_list, cmp_strings);
+    if (status != IOOPM_SUCCESS)
+    {
+        fprintf(stderr, "Failed to sort keys list\n");
+        exit(EXIT_FAILURE);
+    }
 
-        // Get the number of keys
-        size_t keys_count;
-        ioopm_status_t status = ioopm_linked_list_size(keys_list, &keys_count);
-        if (status != IOOPM_SUCCESS)
+    // Copy the sorted keys to an array in one pass and print from it
+    elem_t *keys;
+    size_t no_keys;
+    status = ioopm_linked_list_to_array(keys_list, &keys, &no_keys);
+    if (status != IOOPM_SUCCESS)
+    {
+        fprintf(stderr, "Failed to copy keys list\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Print the frequencies
+    for (size_t i = 0; i < no_keys; ++i)
+    {
+        option_t opt = ioopm_hash_table_lookup(ht, keys[i]);
+        if (opt.success)
         {
-            fprintf(stderr, "Failed to get size of keys list\n");
-            exit(EXIT_FAILURE);
+            unsigned long long freq = opt.value.uint64Value;
+            printf("%s: %llu\n", (char *)keys[i].ptrValue, freq);
         }
+    }
+
+    // Free allocated memory
+    free(keys);
+    ioopm_linked_list_destroy(keys_list);
+
+    // Free the keys stored in the hash table
+    ioopm_hash_table_apply_to_all(ht, free_keys, NULL);
+
+    // Destroy the hash table
+    ioopm_hash_table_destroy(ht);
+}
+
+/// A word and its count, for ranking by --top
+typedef struct
+{
+    char *word;
+    uint64_t count;
+} word_count_t;
+
+/// Orders by descending count, ties by word
+static int cmp_word_counts(const void *p1, const void *p2)
+{
+    const word_count_t *a = p1;
+    const word_count_t *b = p2;
+    if (a->count != b->count)
+    {
+        return a->count < b->count ? 1 : -1;
+    }
+    return strcmp(a->word, b->word);
+}
+
+void collect_word_count(elem_t key, elem_t *value, void *extra)
+{
+    word_count_t **next = extra;
+    **next = (word_count_t){ .word = key.ptrValue, .count = value->uint64Value };
+    (*next)++;
+}
+
+void count_top_exact(char *files[], int no_files, size_t k)
+{
+    ioopm_hash_table_t *ht = ioopm_counter_table_create(string_sum_hash, string_eq, copy_word);
+
+    for (int i = 0; i < no_files; ++i)
+    {
+        process_file(files[i], process_word, ht);
+    }
+
+    size_t no_words = ioopm_hash_table_size(ht);
+    word_count_t *counts = malloc((no_words + 1) * sizeof(word_count_t));
+    if (!counts)
+    {
+        fprintf(stderr, "Failed to allocate memory for counts array\n");
+        exit(EXIT_FAILURE);
+    }
+
+    word_count_t *next = counts;
+    ioopm_hash_table_apply_to_all(ht, collect_word_count, &next);
+    qsort(counts, no_words, sizeof(word_count_t), cmp_word_counts);
+
+    for (size_t i = 0; i < no_words && i < k; ++i)
+    {
+        printf("%s: %llu\n", counts[i].word, (unsigned long long)counts[i].count);
+    }
+
+    free(counts);
+    ioopm_hash_table_apply_to_all(ht, free_keys, NULL);
+    ioopm_hash_table_destroy(ht);
+}
+
+void free_word(elem_t word)
+{
+    free(word.ptrValue);
+}
+
+void count_top_streaming(char *files[], int no_files, size_t k)
+{
+    ioopm_space_saving_t *ss = NULL;
+    if (k <= SIZE_MAX / Streaming_Capacity_Factor)
+    {
+        ss = ioopm_space_saving_create(k * Streaming_Capacity_Factor, ioopm_string_hash, string_eq, copy_word, free_word);
+    }
+    ioopm_heavy_hitter_t *top = calloc(k, sizeof(ioopm_heavy_hitter_t));
+    if (!ss || !top)
+    {
+        fprintf(stderr, "Failed to allocate a summary for the top %zu words\n", k);
+        exit(EXIT_FAILURE);
+    }
+
+    for (int i = 0; i < no_files; ++i)
+    {
+        process_file(files[i], stream_word, ss);
+    }
+
+    // Counts are upper bounds; count - error is guaranteed to have been seen
+    size_t no_top = ioopm_space_saving_top(ss, top, k);
+    for (size_t i = 0; i < no_top; ++i)
+    {
+        printf("%s: %llu (error <= %llu)\n", (char *)top[i].key.ptrValue,
+               (unsigned long long)top[i].count, (unsigned long long)top[i].error);
+    }
+
+    free(top);
+    ioopm_space_saving_destroy(ss);
+}
+
+void count_distinct(char *files[], int no_files)
+{
+    ioopm_hll_t *hll = ioopm_hll_create(Distinct_Precision, ioopm_string_hash);
+    if (!hll)
+    {
+        fprintf(stderr, "Failed to create a distinct counter\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (int i = 0; i < no_files; ++i)
+    {
+        process_file(files[i], distinct_word, hll);
+    }
+
+    printf("distinct: %llu\n", (unsigned long long)ioopm_hll_estimate(hll));
+    ioopm_hll_destroy(hll);
+}
 
-        // Allocate an array for the keys
-        char **keys_array = malloc(keys_count * sizeof(char *));
-        if (!keys_array)
+/// Settings for --approx, collected from the command line
+typedef struct
+{
+    size_t memory_budget;
+    char *save_file;
+    char **load_files;
+    int no_load_files;
+    char **queries;
+    int no_queries;
+} approx_options_t;
+
+void count_approx(char *files[], int no_files, approx_options_t *options)
+{
+    ioopm_cms_t *cms = ioopm_cms_create_with_budget(options->memory_budget, Approx_Depth, ioopm_string_hash);
+    if (!cms)
+    {
+        fprintf(stderr, "Failed to create a sketch within %zu bytes\n", options->memory_budget);
+        exit(EXIT_FAILURE);
+    }
+
+    // Sketches from other workers are merged in before counting
+    for (int i = 0; i < options->no_load_files; ++i)
+    {
+        FILE *f = fopen(options->load_files[i], "rb");
+        ioopm_cms_t *other = f ? ioopm_cms_load(f, ioopm_string_hash) : NULL;
+        if (f) fclose(f);
+
+        if (!other || !ioopm_cms_merge(cms, other))
         {
-            fprintf(stderr, "Failed to allocate memory for keys array\n");
+            fprintf(stderr, "Failed to merge sketch %s (different --memory?)\n", options->load_files[i]);
             exit(EXIT_FAILURE);
         }
+        ioopm_cms_destroy(other);
+    }
 
-        // Iterate over the list and fill the array
-        ioopm_list_iterator_t *iter = ioopm_iterator_create(keys_list);
-        if (!iter)
+    for (int i = 0; i < no_files; ++i)
+    {
+        process_file(files[i], approx_word, cms);
+    }
+
+    if (options->save_file)
+    {
+        FILE *f = fopen(options->save_file, "wb");
+        if (!f || !ioopm_cms_save(cms, f))
         {
-            fprintf(stderr, "Failed to create iterator\n");
+            fprintf(stderr, "Failed to save sketch to %s\n", options->save_file);
             exit(EXIT_FAILURE);
         }
+        fclose(f);
+    }
 
-        size_t index = 0;
-        bool has_next;
-        status = ioopm_iterator_has_next(iter, &has_next);
-        while (status == IOOPM_SUCCESS && has_next)
-        {
-            elem_t current;
-            status = ioopm_iterator_next(iter, &current);
-            if (status != IOOPM_SUCCESS)
-            {
-                fprintf(stderr, "Iterator next failed\n");
-                exit(EXIT_FAILURE);
-            }
-            keys_array[index] = current.ptrValue; // Store the key
-            index++;
+    printf("total: %llu\n", (unsigned long long)ioopm_cms_total(cms));
+    for (int i = 0; i < options->no_queries; ++i)
+    {
+        uint64_t estimate = ioopm_cms_estimate(cms, (elem_t){ .ptrValue = options->queries[i] });
+        printf("%s: %llu\n", options->queries[i], (unsigned long long)estimate);
+    }
 
-            status = ioopm_iterator_has_next(iter, &has_next);
-        }
+    ioopm_cms_destroy(cms);
+}
 
-        ioopm_iterator_destroy(iter);
+void usage(void)
+{
+    puts("Usage: freq-count file1 ... filen");
+    puts("       freq-count --approx [--memory BYTES] [--load SKETCH]... [--save SKETCH] [--query WORD]... file1 ... filen");
+    puts("       freq-count --distinct file1 ... filen");
+    puts("       freq-count --top K [--streaming] file1 ... filen");
+}
 
-        // Sort the keys
-        sort_keys(keys_array, keys_count);
+int main(int argc, char *argv[])
+{
+    bool approx = false;
+    bool streaming = false;
+    bool distinct = false;
+    size_t top = 0;
+    approx_options_t approx_options = { .memory_budget = Approx_Default_Budget };
+    char **files = calloc(argc, sizeof(char *));
+    char **load_files = calloc(argc, sizeof(char *));
+    char **queries = calloc(argc, sizeof(char *));
+    int no_files = 0;
 
-        // Print the frequencies
-        for (size_t i = 0; i < keys_count; ++i)
-        {
-            char *key = keys_array[i];
-            option_t opt = ioopm_hash_table_lookup(ht, (elem_t){ .ptrValue = key });
-            if (opt.success)
-            {
-                int freq = opt.value.intValue;
-                printf("%s: %d\n", key, freq);
-            }
-        }
+    if (!files || !load_files || !queries)
+    {
+        fprintf(stderr, "Failed to allocate memory for arguments\n");
+        exit(EXIT_FAILURE);
+    }
+    approx_options.load_files = load_files;
+    approx_options.queries = queries;
 
-        // Free allocated memory
-        free(keys_array);
-        ioopm_linked_list_destroy(keys_list);
+    for (int i = 1; i < argc; ++i)
+    {
+        bool has_value = i + 1 < argc;
 
-        // Free the keys stored in the hash table
-        ioopm_hash_table_apply_to_all(ht, free_keys, NULL);
+        if (strcmp(argv[i], "--approx") == 0)
+        {
+            approx = true;
+        }
+        else if (strcmp(argv[i], "--distinct") == 0)
+        {
+            distinct = true;
+        }
+        else if (strcmp(argv[i], "--streaming") == 0)
+        {
+            streaming = true;
+        }
+        else if (strcmp(argv[i], "--top") == 0 && has_value)
+        {
+            top = strtoull(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--memory") == 0 && has_value)
+        {
+            approx_options.memory_budget = strtoull(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--save") == 0 && has_value)
+        {
+            approx_options.save_file = argv[++i];
+        }
+        else if (strcmp(argv[i], "--load") == 0 && has_value)
+        {
+            load_files[approx_options.no_load_files++] = argv[++i];
+        }
+        else if (strcmp(argv[i], "--query") == 0 && has_value)
+        {
+            queries[approx_options.no_queries++] = argv[++i];
+        }
+        else if (strncmp(argv[i], "--", 2) == 0)
+        {
+            usage();
+            return EXIT_FAILURE;
+        }
+        else
+        {
+            files[no_files++] = argv[i];
+        }
+    }
 
-        // Destroy the hash table
-        ioopm_hash_table_destroy(ht);
+    if (approx)
+    {
+        count_approx(files, no_files, &approx_options);
+    }
+    else if (distinct)
+    {
+        count_distinct(files, no_files);
+    }
+    else if (top > 0)
+    {
+        if (streaming)
+        {
+            count_top_streaming(files, no_files, top);
+        }
+        else
+        {
+            count_top_exact(files, no_files, top);
+        }
+    }
+    else if (streaming)
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+    else if (no_files > 0)
+    {
+        count_exact(files, no_files);
     }
     else
     {
-        puts("Usage: freq-count file1 ... filen");
+        usage();
     }
 
+    free(files);
+    free(load_files);
+    free(queries);
+
     return 0;
 }
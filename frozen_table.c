@@ -0,0 +1,484 @@
+// frozen_table.c
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "frozen_table.h"
+
+/// Identifies a saved frozen table (and the version of the format).
+#define Frozen_Magic "IOMPH01"
+
+/// Average number of keys per pilot bucket.
+#define Keys_Per_Bucket 4
+
+/// Keys are hashed onto no_keys * 100 / Load_Percent positions.
+#define Load_Percent 97
+
+/// Number of seeds tried before giving up (each attempt fails with small probability).
+#define Max_Attempts 8
+
+/// Set in the file header when keys are offsets into the key data at the end of the file.
+#define Keys_In_Blob 1
+
+/// Sections of the table are padded to 8 bytes so that every one is aligned in a mapped file.
+#define Align8(n) (((n) + 7) & ~(size_t)7)
+
+/*
+ * =========================================
+ * SECTION: Custom Data Types And Aliases
+ * =========================================
+ */
+
+typedef struct
+{
+  elem_t key;
+  elem_t value;
+} slot_t;
+
+/// Start of a saved table; pilots, remap, slots and key data follow in that order.
+typedef struct
+{
+  char magic[8];
+  uint64_t no_keys;
+  uint64_t no_buckets;
+  uint64_t no_positions;
+  uint64_t seed;
+  uint64_t flags;
+  uint64_t key_blob_size;
+} file_header_t;
+
+/// All arrays live in one block (malloc'ed or mapped), laid out as in the file.
+struct frozen_table
+{
+  size_t no_keys;
+  size_t no_buckets;
+  size_t no_positions;                /// At least no_keys; positions >= no_keys go through remap.
+  uint64_t seed;
+  const uint16_t *pilots;
+  const uint32_t *remap;              /// Slot of every position >= no_keys that some key hashes to.
+  const slot_t *slots;
+  const char *key_blob;               /// If not NULL, slot keys are offsets into this data.
+  size_t key_blob_size;
+  void *memory;
+  size_t mapped_size;                 /// Size of the mapping, 0 if memory was malloc'ed.
+  ioopm_hash_function hash_func;
+  ioopm_eq_function key_eq_func;
+};
+
+/// Collects the entries of a hash table.
+typedef struct
+{
+  slot_t *entries;
+  size_t count;
+  size_t capacity;
+} collect_args_t;
+
+
+/*
+ * =========================================
+ * SECTION: Function Definitions
+ * =========================================
+ */
+
+/// @brief Computes the hash of a key for a given seed.
+static uint64_t key_hash(ioopm_hash_function hash_func, uint64_t seed, elem_t key){
+  return ioopm_mix_hash(hash_func(key) ^ seed);
+}
+
+/// @brief Computes the position of a key hash under a pilot.
+static size_t key_position(uint64_t hash, uint16_t pilot, uint64_t seed, size_t no_positions){
+  return ioopm_mix_hash(hash ^ ioopm_mix_hash(pilot ^ seed)) % no_positions;
+}
+
+/// @brief Returns the key stored in a slot, resolving offsets into the key data of mapped tables.
+/// @param ft The table.
+/// @param slot The slot, less than no_keys.
+/// @param key Pointer to store the key in.
+/// @return false if the slot holds an offset outside the key data, which only a damaged file does.
+static bool slot_key(ioopm_frozen_table_t *ft, size_t slot, elem_t *key){
+  if(!ft->key_blob){
+    *key = ft->slots[slot].key;
+    return true;
+  }
+
+  uint64_t offset = ft->slots[slot].key.uint64Value;
+  if(offset >= ft->key_blob_size) return false;
+  *key = ptr_elem((void *)(ft->key_blob + offset));
+  return true;
+}
+
+/// @brief Computes the size of the block holding pilots, remap and slots.
+/// @param no_keys Number of keys.
+/// @param no_buckets Number of pilot buckets.
+/// @param no_positions Number of positions.
+/// @param remap_offset Pointer to store the offset of remap in.
+/// @param slots_offset Pointer to store the offset of the slots in.
+/// @return The size of the block in bytes.
+static size_t block_layout(size_t no_keys, size_t no_buckets, size_t no_positions, size_t *remap_offset, size_t *slots_offset){
+  *remap_offset = Align8(no_buckets * sizeof(uint16_t));
+  *slots_offset = *remap_offset + Align8((no_positions - no_keys) * sizeof(uint32_t));
+  return *slots_offset + no_keys * sizeof(slot_t);
+}
+
+/// @brief Points the arrays of a table into its block.
+static void set_arrays(ioopm_frozen_table_t *ft, char *block){
+  size_t remap_offset, slots_offset;
+  block_layout(ft->no_keys, ft->no_buckets, ft->no_positions, &remap_offset, &slots_offset);
+
+  ft->pilots = (const uint16_t *)block;
+  ft->remap = (const uint32_t *)(block + remap_offset);
+  ft->slots = (const slot_t *)(block + slots_offset);
+}
+
+/// @brief Predicate that copies an entry into a collect_args_t, for a read-only walk with ioopm_hash_table_all.
+/// @return true to continue, false once the entries array is full.
+static bool collect_entry(elem_t key, elem_t value, void *extra){
+  collect_args_t *args = extra;
+  if(args->count == args->capacity) return false;
+
+  args->entries[args->count++] = (slot_t){.key = key, .value = value};
+  return true;
+}
+
+/// @brief Orders encoded (bucket size << 32 | bucket) pairs by descending size.
+static int cmp_bucket_desc(const void *p1, const void *p2){
+  uint64_t a = *(const uint64_t *)p1;
+  uint64_t b = *(const uint64_t *)p2;
+  return a < b ? 1 : a > b ? -1 : 0;
+}
+
+/// @brief Orders hash values ascending.
+static int cmp_hash(const void *p1, const void *p2){
+  uint64_t a = *(const uint64_t *)p1;
+  uint64_t b = *(const uint64_t *)p2;
+  return a < b ? -1 : a > b ? 1 : 0;
+}
+
+/// @brief Checks whether two entries have the same hash value, which no perfect hash can separate.
+/// @return true if all hash values are distinct, false if not or memory allocation fails.
+static bool hashes_distinct(const slot_t *entries, size_t no_keys, ioopm_hash_function hash_func){
+  uint64_t *hashes = malloc((no_keys + 1) * sizeof(uint64_t));
+  if(!hashes) return false;
+
+  for(size_t i = 0; i < no_keys; ++i){
+    hashes[i] = hash_func(entries[i].key);
+  }
+  qsort(hashes, no_keys, sizeof(uint64_t), cmp_hash);
+
+  bool distinct = true;
+  for(size_t i = 1; i < no_keys && distinct; ++i){
+    distinct = hashes[i] != hashes[i - 1];
+  }
+
+  free(hashes);
+  return distinct;
+}
+
+/// @brief Searches pilots for all buckets and places the entries, with one seed.
+/// @param ft Table with no_keys, no_buckets, no_positions, seed and hash_func set; receives memory and arrays.
+/// @param entries The entries to place.
+/// @return true on success, false if some bucket has no working pilot or memory allocation fails.
+static bool build(ioopm_frozen_table_t *ft, const slot_t *entries){
+  size_t n = ft->no_keys;
+  size_t remap_offset, slots_offset;
+  size_t block_size = block_layout(n, ft->no_buckets, ft->no_positions, &remap_offset, &slots_offset);
+
+  char *block = calloc(1, block_size);
+  uint64_t *hashes = malloc((n + 1) * sizeof(uint64_t));
+  size_t *bucket_start = calloc(ft->no_buckets + 1, sizeof(size_t));
+  size_t *bucket_keys = malloc((n + 1) * sizeof(size_t));
+  uint64_t *order = malloc(ft->no_buckets * sizeof(uint64_t));
+  uint64_t *taken = calloc(ft->no_positions / 64 + 1, sizeof(uint64_t));
+  size_t *positions = malloc((n + 1) * sizeof(size_t));
+  bool success = block && hashes && bucket_start && bucket_keys && order && taken && positions;
+
+  uint16_t *pilots = (uint16_t *)block;
+  uint32_t *remap = (uint32_t *)(block + remap_offset);
+  slot_t *slots = (slot_t *)(block + slots_offset);
+
+  if(success){
+    // Group the keys by bucket (counting sort), then order the buckets largest first
+    for(size_t i = 0; i < n; ++i){
+      hashes[i] = key_hash(ft->hash_func, ft->seed, entries[i].key);
+      bucket_start[hashes[i] % ft->no_buckets + 1]++;
+    }
+    for(size_t b = 0; b < ft->no_buckets; ++b){
+      bucket_start[b + 1] += bucket_start[b];
+      order[b] = (uint64_t)(bucket_start[b + 1] - bucket_start[b]) << 32 | b;
+    }
+    for(size_t i = 0; i < n; ++i){
+      size_t b = hashes[i] % ft->no_buckets;
+      bucket_keys[bucket_start[b]++] = i;
+    }
+    for(size_t b = ft->no_buckets; b > 0; --b){
+      bucket_start[b] = bucket_start[b - 1];
+    }
+    bucket_start[0] = 0;
+    qsort(order, ft->no_buckets, sizeof(uint64_t), cmp_bucket_desc);
+  }
+
+  for(size_t i = 0; success && i < ft->no_buckets && (order[i] >> 32) > 0; ++i){
+    size_t b = order[i] & 0xffffffff;
+    size_t *keys = &bucket_keys[bucket_start[b]];
+    size_t size = bucket_start[b + 1] - bucket_start[b];
+    bool found = false;
+
+    for(uint32_t pilot = 0; pilot <= UINT16_MAX && !found; ++pilot){
+      // Claim positions one by one and release them if a later key of the bucket collides
+      size_t placed = 0;
+      for(; placed < size; ++placed){
+        size_t position = key_position(hashes[keys[placed]], (uint16_t)pilot, ft->seed, ft->no_positions);
+        if(taken[position / 64] & (1ULL << (position % 64))) break;
+        taken[position / 64] |= 1ULL << (position % 64);
+        positions[placed] = position;
+      }
+
+      if(placed == size){
+        pilots[b] = (uint16_t)pilot;
+        found = true;
+      }
+      else{
+        while(placed > 0){
+          placed--;
+          taken[positions[placed] / 64] &= ~(1ULL << (positions[placed] % 64));
+        }
+      }
+    }
+
+    success = found;
+  }
+
+  if(success){
+    // Every taken position >= n gets one of the free slots < n
+    size_t free_slot = 0;
+    for(size_t position = n; position < ft->no_positions; ++position){
+      if(!(taken[position / 64] & (1ULL << (position % 64)))) continue;
+      while(taken[free_slot / 64] & (1ULL << (free_slot % 64))) free_slot++;
+      remap[position - n] = (uint32_t)free_slot++;
+    }
+
+    for(size_t i = 0; i < n; ++i){
+      size_t position = key_position(hashes[i], pilots[hashes[i] % ft->no_buckets], ft->seed, ft->no_positions);
+      if(position >= n) position = remap[position - n];
+      slots[position] = entries[i];
+    }
+
+    ft->memory = block;
+    set_arrays(ft, block);
+  }
+  else{
+    free(block);
+  }
+
+  free(hashes);
+  free(bucket_start);
+  free(bucket_keys);
+  free(order);
+  free(taken);
+  free(positions);
+
+  return success;
+}
+
+
+ioopm_frozen_table_t *ioopm_hash_table_freeze(ioopm_hash_table_t *ht){
+  if(!ht) return NULL;
+
+  ioopm_hash_function hash_func = ioopm_hash_table_hash_function(ht);
+  ioopm_eq_function key_eq_func = ioopm_hash_table_key_eq_function(ht);
+
+  size_t n = ioopm_hash_table_size(ht);
+  if(n > UINT32_MAX) return NULL;
+
+  ioopm_frozen_table_t *ft = calloc(1, sizeof(ioopm_frozen_table_t));
+  collect_args_t args = {.entries = malloc((n + 1) * sizeof(slot_t)), .count = 0, .capacity = n};
+  if(!ft || !args.entries){
+    free(ft);
+    free(args.entries);
+    return NULL;
+  }
+
+  // ioopm_hash_table_all only reads, where apply_to_all would copy buckets shared with a snapshot
+  if(!ioopm_hash_table_all(ht, collect_entry, &args) || args.count != n){
+    free(ft);
+    free(args.entries);
+    return NULL;
+  }
+
+  ft->no_keys = n;
+  ft->no_buckets = n / Keys_Per_Bucket + 1;
+  ft->no_positions = n * 100 / Load_Percent + 1;
+  ft->hash_func = hash_func;
+  ft->key_eq_func = key_eq_func;
+
+  bool built = false;
+  if(hashes_distinct(args.entries, n, hash_func)){
+    for(uint64_t attempt = 0; attempt < Max_Attempts && !built; ++attempt){
+      ft->seed = ioopm_mix_hash(attempt + 1);
+      built = build(ft, args.entries);
+    }
+  }
+
+  free(args.entries);
+  if(!built){
+    free(ft);
+    return NULL;
+  }
+
+  return ft;
+}
+
+void ioopm_frozen_table_destroy(ioopm_frozen_table_t *ft){
+  if(!ft) return;
+
+  if(ft->mapped_size) munmap(ft->memory, ft->mapped_size);
+  else free(ft->memory);
+  free(ft);
+}
+
+option_t ioopm_frozen_table_lookup(ioopm_frozen_table_t *ft, elem_t key){
+  if(!ft || ft->no_keys == 0) return Failure();
+
+  uint64_t hash = key_hash(ft->hash_func, ft->seed, key);
+  size_t position = key_position(hash, ft->pilots[hash % ft->no_buckets], ft->seed, ft->no_positions);
+  if(position >= ft->no_keys){
+    // Remapped slots come from the file of a mapped table, so they are checked
+    position = ft->remap[position - ft->no_keys];
+    if(position >= ft->no_keys) return Failure();
+  }
+
+  // The slot is the only place the key can be, but an absent key also maps to some slot
+  elem_t slot_elem;
+  if(!slot_key(ft, position, &slot_elem) || !ft->key_eq_func(slot_elem, key)) return Failure();
+
+  return Success(ft->slots[position].value);
+}
+
+bool ioopm_frozen_table_has_key(ioopm_frozen_table_t *ft, elem_t key){
+  return Successful(ioopm_frozen_table_lookup(ft, key));
+}
+
+size_t ioopm_frozen_table_size(ioopm_frozen_table_t *ft){
+  return ft ? ft->no_keys : 0;
+}
+
+double ioopm_frozen_table_bits_per_key(ioopm_frozen_table_t *ft){
+  if(!ft || ft->no_keys == 0) return 0;
+
+  size_t bits = ft->no_buckets * 16 + (ft->no_positions - ft->no_keys) * 32;
+  return (double)bits / ft->no_keys;
+}
+
+bool ioopm_frozen_table_save(ioopm_frozen_table_t *ft, FILE *out, ioopm_size_function key_size_func){
+  if(!ft || !out) return false;
+
+  size_t remap_offset, slots_offset;
+  block_layout(ft->no_keys, ft->no_buckets, ft->no_positions, &remap_offset, &slots_offset);
+
+  file_header_t header = {
+    .magic = Frozen_Magic,
+    .no_keys = ft->no_keys,
+    .no_buckets = ft->no_buckets,
+    .no_positions = ft->no_positions,
+    .seed = ft->seed,
+    .flags = key_size_func ? Keys_In_Blob : 0,
+  };
+  for(size_t i = 0; key_size_func && i < ft->no_keys; ++i){
+    elem_t key;
+    if(!slot_key(ft, i, &key)) return false;
+    header.key_blob_size += key_size_func(key);
+  }
+
+  if(fwrite(&header, sizeof(header), 1, out) != 1) return false;
+  if(fwrite(ft->pilots, 1, slots_offset, out) != slots_offset) return false;
+
+  if(!key_size_func){
+    return fwrite(ft->slots, sizeof(slot_t), ft->no_keys, out) == ft->no_keys;
+  }
+
+  // Keys become offsets into the key data written after the slots
+  uint64_t offset = 0;
+  for(size_t i = 0; i < ft->no_keys; ++i){
+    slot_t slot = {.key = {.uint64Value = offset}, .value = ft->slots[i].value};
+    if(fwrite(&slot, sizeof(slot_t), 1, out) != 1) return false;
+
+    elem_t key;
+    slot_key(ft, i, &key);
+    offset += key_size_func(key);
+  }
+  for(size_t i = 0; i < ft->no_keys; ++i){
+    elem_t key;
+    slot_key(ft, i, &key);
+    size_t size = key_size_func(key);
+    if(fwrite(key.ptrValue, 1, size, out) != size) return false;
+  }
+
+  return true;
+}
+
+ioopm_frozen_table_t *ioopm_frozen_table_map(const char *path, ioopm_hash_function hash_func, ioopm_eq_function key_eq_func){
+  if(!path || !hash_func || !key_eq_func) return NULL;
+
+  int fd = open(path, O_RDONLY);
+  if(fd < 0) return NULL;
+
+  struct stat st;
+  if(fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(file_header_t)){
+    close(fd);
+    return NULL;
+  }
+
+  size_t file_size = st.st_size;
+  char *mapping = mmap(NULL, file_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if(mapping == MAP_FAILED) return NULL;
+
+  // Only the header is checked, so mapping does not read the whole file; lookups check the
+  // slot numbers and key offsets they read
+  file_header_t header;
+  memcpy(&header, mapping, sizeof(header));
+
+  size_t remap_offset, slots_offset, block_size = 0;
+  bool valid = memcmp(header.magic, Frozen_Magic, sizeof(header.magic)) == 0
+            && header.no_keys <= UINT32_MAX
+            && header.no_buckets > 0 && header.no_buckets <= UINT32_MAX
+            && header.no_positions >= header.no_keys && header.no_positions <= 2 * (uint64_t)UINT32_MAX
+            && header.key_blob_size <= file_size;
+  if(valid){
+    block_size = block_layout(header.no_keys, header.no_buckets, header.no_positions, &remap_offset, &slots_offset);
+    valid = sizeof(header) + block_size + header.key_blob_size == file_size;
+  }
+
+  ioopm_frozen_table_t *ft = valid ? calloc(1, sizeof(ioopm_frozen_table_t)) : NULL;
+  if(!ft){
+    munmap(mapping, file_size);
+    return NULL;
+  }
+
+  ft->no_keys = header.no_keys;
+  ft->no_buckets = header.no_buckets;
+  ft->no_positions = header.no_positions;
+  ft->seed = header.seed;
+  ft->memory = mapping;
+  ft->mapped_size = file_size;
+  ft->hash_func = hash_func;
+  ft->key_eq_func = key_eq_func;
+  set_arrays(ft, mapping + sizeof(header));
+  if(header.flags & Keys_In_Blob){
+    ft->key_blob = mapping + sizeof(header) + block_size;
+    ft->key_blob_size = header.key_blob_size;
+  }
+
+  return ft;
+}
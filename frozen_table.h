@@ -0,0 +1,110 @@
+// frozen_table.h
+
+#ifndef FROZEN_TABLE_H
+#define FROZEN_TABLE_H
+
+/**
+ * @file frozen_table.h
+ * @brief Immutable table built on a minimal perfect hash, for tables that are only read.
+ *
+ * Freezing a hash table places its n entries in an array of exactly n slots,
+ * so that every key has a slot of its own and a lookup reads one slot. The
+ * slot of a key is found PTHash-style: keys are split into buckets of about
+ * four, and each bucket stores a 16-bit pilot that was searched so that the
+ * keys of the bucket land on free, distinct positions. Positions are drawn
+ * from a few percent more than n and the surplus ones are remapped to the
+ * leftover slots, which keeps the search fast. The hash structure takes
+ * about five bits per key on top of the slots.
+ *
+ * A frozen table can be saved to a file and mapped back with mmap, without
+ * parsing or copying. Keys and values are written as raw elem_t, so values
+ * should be scalars; keys may also be pointers to data of a known size
+ * (e.g. strings), which is then written along with the table.
+ *
+ * Mapping checks the header against the file size, and lookups check every
+ * slot number and key offset they read from the file, so a damaged file
+ * makes lookups fail instead of reading outside the mapping. The key data
+ * itself is handed to the key equality function as it is, so a file whose
+ * keys are read up to a terminator (e.g. strings) must be trusted.
+ */
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "hash_table.h"
+
+/*
+ * =========================================
+ * SECTION: Custom Data Types And Aliases
+ * =========================================
+ */
+
+typedef struct frozen_table ioopm_frozen_table_t;
+
+
+/*
+ * =========================================
+ * SECTION: Function Declarations
+ * =========================================
+ */
+
+/// @brief Build a frozen table holding the current entries of a hash table.
+/// @param ht The hash table to freeze; it is not changed. The frozen table uses its hash and key
+///           equality functions.
+/// @return A new frozen table, or NULL if memory allocation fails or two keys have the same hash value.
+ioopm_frozen_table_t *ioopm_hash_table_freeze(ioopm_hash_table_t *ht);
+
+/// @brief Delete a frozen table, unmapping it if it was mapped from a file.
+/// @param ft The table to delete.
+void ioopm_frozen_table_destroy(ioopm_frozen_table_t *ft);
+
+/// @brief Lookup the value for a key.
+/// @param ft Table operated upon.
+/// @param key Key to look up.
+/// @return Success with the value if the key is present, Failure otherwise.
+option_t ioopm_frozen_table_lookup(ioopm_frozen_table_t *ft, elem_t key);
+
+/// @brief Checks if a key is in the table.
+/// @param ft Table operated upon.
+/// @param key Key to check for.
+/// @return true if the key is present, false otherwise.
+bool ioopm_frozen_table_has_key(ioopm_frozen_table_t *ft, elem_t key);
+
+/// @brief Returns the number of entries in the table.
+/// @param ft Table operated upon.
+/// @return The number of entries.
+size_t ioopm_frozen_table_size(ioopm_frozen_table_t *ft);
+
+/// @brief Returns the size of the perfect hash function, excluding the slots.
+/// @param ft Table operated upon.
+/// @return Bits of pilots and remapped positions per key (0 for an empty table).
+double ioopm_frozen_table_bits_per_key(ioopm_frozen_table_t *ft);
+
+/// @brief Write a frozen table to a file that ioopm_frozen_table_map can map.
+/// @param ft The table to save.
+/// @param out The stream to write to, at a position that is a multiple of 8.
+/// @param key_size_func NULL to write keys as they are, or the size in bytes of the data each key points to,
+///                      which is then written too.
+/// @return true on success, false on a write error or a key offset outside the key data of a
+///         mapped table.
+/// @note The file is in the byte order of the host.
+bool ioopm_frozen_table_save(ioopm_frozen_table_t *ft, FILE *out, ioopm_size_function key_size_func);
+
+/// @brief Map a file written by ioopm_frozen_table_save into memory (read-only).
+/// @param path The file to map.
+/// @param hash_func The hash function the table was frozen with.
+/// @param key_eq_func The key equality function the table was frozen with.
+/// @return The mapped table, or NULL if the file cannot be mapped or is not a valid frozen table.
+ioopm_frozen_table_t *ioopm_frozen_table_map(const char *path, ioopm_hash_function hash_func, ioopm_eq_function key_eq_func);
+
+
+
+#endif // FROZEN_TABLE_H
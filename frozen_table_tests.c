@@ -0,0 +1,320 @@
+// frozen_table_tests.c
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include <CUnit/Basic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "frozen_table.h"
+
+/// @brief Number of keys in the large tables.
+#define NUM_KEYS 100000
+
+
+/*
+ * =========================================
+ * SECTION: Private Function Definitions
+ * =========================================
+ */
+
+/// @brief Hash function for integer keys.
+/// @param key The key to hash.
+/// @return The hash value.
+static size_t int_hash_function(elem_t key) {
+    return (size_t)key.intValue;
+}
+
+/// @brief Equality function for integer keys.
+/// @param a The first key.
+/// @param b The second key.
+/// @return true if the keys are equal.
+static bool int_eq_function(elem_t a, elem_t b) {
+    return a.intValue == b.intValue;
+}
+
+/// @brief Hash function that gives keys 0 and 1 the same hash.
+/// @param key The key to hash.
+/// @return The hash value.
+static size_t colliding_hash_function(elem_t key) {
+    return (size_t)(key.intValue / 2);
+}
+
+/// @brief Equality function for string keys.
+/// @param a The first key.
+/// @param b The second key.
+/// @return true if the strings are equal.
+static bool string_eq_function(elem_t a, elem_t b) {
+    return strcmp(a.ptrValue, b.ptrValue) == 0;
+}
+
+/// @brief Size function for string keys.
+/// @param key The key.
+/// @return The number of bytes of the string, including the terminator.
+static size_t string_size_function(elem_t key) {
+    return strlen(key.ptrValue) + 1;
+}
+
+/// @brief Saves a frozen table to a new temporary file.
+/// @param ft The table to save.
+/// @param key_size_func Passed on to ioopm_frozen_table_save.
+/// @param path Buffer of at least 32 bytes that receives the file name.
+/// @return true if the table was saved.
+static bool save_to_temp_file(ioopm_frozen_table_t *ft, ioopm_size_function key_size_func, char *path) {
+    strcpy(path, "/tmp/frozen_tableXXXXXX");
+    int fd = mkstemp(path);
+    if (fd < 0) return false;
+
+    FILE *f = fdopen(fd, "wb");
+    bool saved = ioopm_frozen_table_save(ft, f, key_size_func);
+    fclose(f);
+    return saved;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Initialize and clean the suite
+ * =========================================
+ */
+
+int init_suite(void) {
+  return 0;
+}
+
+int clean_suite(void) {
+  return 0;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Tests
+ * =========================================
+ */
+
+void test_freeze_lookup() {
+  ioopm_hash_table_t *ht = ioopm_hash_table_create(int_hash_function, int_eq_function, int_eq_function);
+  for (int i = 0; i < NUM_KEYS; ++i) {
+    ioopm_hash_table_insert(ht, int_elem(i * 3), int_elem(i));
+  }
+
+  // Freezing only reads ht, so a snapshot sharing its buckets is left alone
+  ioopm_hash_table_t *snapshot = ioopm_hash_table_snapshot(ht);
+  ioopm_frozen_table_t *ft = ioopm_hash_table_freeze(ht);
+  CU_ASSERT_PTR_NOT_NULL(ft);
+  CU_ASSERT_EQUAL(ioopm_frozen_table_size(ft), NUM_KEYS);
+
+  for (int i = 0; i < NUM_KEYS; ++i) {
+    option_t found = ioopm_frozen_table_lookup(ft, int_elem(i * 3));
+    CU_ASSERT(Successful(found));
+    CU_ASSERT_EQUAL(found.value.intValue, i);
+    CU_ASSERT_FALSE(ioopm_frozen_table_has_key(ft, int_elem(i * 3 + 1)));
+  }
+
+  double bits = ioopm_frozen_table_bits_per_key(ft);
+  CU_ASSERT(bits > 0 && bits < 6);
+
+  // The frozen table does not depend on the hash table
+  CU_ASSERT_EQUAL(ioopm_hash_table_size(snapshot), NUM_KEYS);
+  ioopm_hash_table_destroy(snapshot);
+  ioopm_hash_table_destroy(ht);
+  CU_ASSERT(Successful(ioopm_frozen_table_lookup(ft, int_elem(3))));
+  ioopm_frozen_table_destroy(ft);
+}
+
+void test_freeze_small_and_empty() {
+  ioopm_hash_table_t *ht = ioopm_hash_table_create(int_hash_function, int_eq_function, int_eq_function);
+
+  ioopm_frozen_table_t *ft = ioopm_hash_table_freeze(ht);
+  CU_ASSERT_PTR_NOT_NULL(ft);
+  CU_ASSERT_EQUAL(ioopm_frozen_table_size(ft), 0);
+  CU_ASSERT(Unsuccessful(ioopm_frozen_table_lookup(ft, int_elem(0))));
+  CU_ASSERT_EQUAL(ioopm_frozen_table_bits_per_key(ft), 0);
+  ioopm_frozen_table_destroy(ft);
+
+  ioopm_hash_table_insert(ht, int_elem(42), int_elem(7));
+  ft = ioopm_hash_table_freeze(ht);
+  CU_ASSERT_EQUAL(ioopm_frozen_table_lookup(ft, int_elem(42)).value.intValue, 7);
+  CU_ASSERT(Unsuccessful(ioopm_frozen_table_lookup(ft, int_elem(0))));
+  ioopm_frozen_table_destroy(ft);
+
+  CU_ASSERT_PTR_NULL(ioopm_hash_table_freeze(NULL));
+  ioopm_hash_table_destroy(ht);
+}
+
+void test_freeze_hash_collision() {
+  ioopm_hash_table_t *ht = ioopm_hash_table_create(colliding_hash_function, int_eq_function, int_eq_function);
+  ioopm_hash_table_insert(ht, int_elem(0), int_elem(0));
+  ioopm_hash_table_insert(ht, int_elem(1), int_elem(1));
+
+  CU_ASSERT_PTR_NULL(ioopm_hash_table_freeze(ht));
+
+  ioopm_hash_table_destroy(ht);
+}
+
+void test_save_map() {
+  ioopm_hash_table_t *ht = ioopm_hash_table_create(int_hash_function, int_eq_function, int_eq_function);
+  for (int i = 0; i < 1000; ++i) {
+    ioopm_hash_table_insert(ht, int_elem(i * 7), int_elem(-i));
+  }
+  ioopm_frozen_table_t *ft = ioopm_hash_table_freeze(ht);
+
+  char path[32];
+  CU_ASSERT_TRUE(save_to_temp_file(ft, NULL, path));
+  ioopm_frozen_table_t *mapped = ioopm_frozen_table_map(path, int_hash_function, int_eq_function);
+  unlink(path);
+
+  CU_ASSERT_PTR_NOT_NULL(mapped);
+  CU_ASSERT_EQUAL(ioopm_frozen_table_size(mapped), 1000);
+  CU_ASSERT_EQUAL(ioopm_frozen_table_bits_per_key(mapped), ioopm_frozen_table_bits_per_key(ft));
+  for (int i = 0; i < 1000; ++i) {
+    CU_ASSERT_EQUAL(ioopm_frozen_table_lookup(mapped, int_elem(i * 7)).value.intValue, -i);
+    CU_ASSERT_FALSE(ioopm_frozen_table_has_key(mapped, int_elem(i * 7 + 1)));
+  }
+
+  // A mapped table can be saved again
+  CU_ASSERT_TRUE(save_to_temp_file(mapped, NULL, path));
+  ioopm_frozen_table_t *remapped = ioopm_frozen_table_map(path, int_hash_function, int_eq_function);
+  unlink(path);
+  CU_ASSERT_EQUAL(ioopm_frozen_table_lookup(remapped, int_elem(700)).value.intValue, -100);
+
+  ioopm_frozen_table_destroy(remapped);
+  ioopm_frozen_table_destroy(mapped);
+  ioopm_frozen_table_destroy(ft);
+  ioopm_hash_table_destroy(ht);
+}
+
+void test_save_map_string_keys() {
+  char *words[] = {"apple", "banana", "cherry", "date", "elderberry", "fig", "grape"};
+  size_t no_words = sizeof(words) / sizeof(words[0]);
+
+  ioopm_hash_table_t *ht = ioopm_hash_table_create(ioopm_string_hash, string_eq_function, int_eq_function);
+  for (size_t i = 0; i < no_words; ++i) {
+    ioopm_hash_table_insert(ht, ptr_elem(words[i]), int_elem((int)i));
+  }
+  ioopm_frozen_table_t *ft = ioopm_hash_table_freeze(ht);
+
+  // The strings are written into the file, so the mapped table does not point into this process
+  char path[32];
+  CU_ASSERT_TRUE(save_to_temp_file(ft, string_size_function, path));
+  ioopm_frozen_table_t *mapped = ioopm_frozen_table_map(path, ioopm_string_hash, string_eq_function);
+  unlink(path);
+
+  CU_ASSERT_PTR_NOT_NULL(mapped);
+  for (size_t i = 0; i < no_words; ++i) {
+    char copy[16];
+    strcpy(copy, words[i]);
+    CU_ASSERT_EQUAL(ioopm_frozen_table_lookup(mapped, ptr_elem(copy)).value.intValue, (int)i);
+  }
+  CU_ASSERT_FALSE(ioopm_frozen_table_has_key(mapped, ptr_elem("kiwi")));
+
+  ioopm_frozen_table_destroy(mapped);
+  ioopm_frozen_table_destroy(ft);
+  ioopm_hash_table_destroy(ht);
+}
+
+void test_map_invalid_file() {
+  CU_ASSERT_PTR_NULL(ioopm_frozen_table_map("/nonexistent/frozen_table", int_hash_function, int_eq_function));
+
+  char path[32];
+  strcpy(path, "/tmp/frozen_tableXXXXXX");
+  int fd = mkstemp(path);
+  FILE *f = fdopen(fd, "wb");
+  fputs("this is not a frozen table, but it is long enough to hold a header", f);
+  fclose(f);
+
+  CU_ASSERT_PTR_NULL(ioopm_frozen_table_map(path, int_hash_function, int_eq_function));
+  unlink(path);
+}
+
+void test_map_damaged_file() {
+  char *words[] = {"apple", "banana", "cherry", "date", "elderberry", "fig", "grape"};
+  size_t no_words = sizeof(words) / sizeof(words[0]);
+  size_t blob_size = 0;
+
+  ioopm_hash_table_t *ht = ioopm_hash_table_create(ioopm_string_hash, string_eq_function, int_eq_function);
+  for (size_t i = 0; i < no_words; ++i) {
+    ioopm_hash_table_insert(ht, ptr_elem(words[i]), int_elem((int)i));
+    blob_size += strlen(words[i]) + 1;
+  }
+  ioopm_frozen_table_t *ft = ioopm_hash_table_freeze(ht);
+
+  char path[32];
+  CU_ASSERT_TRUE(save_to_temp_file(ft, string_size_function, path));
+
+  // Overwrite pilots, remapped slots and slots between the 7-word header and the key data
+  FILE *f = fopen(path, "r+b");
+  fseek(f, 0, SEEK_END);
+  long end = ftell(f) - (long)blob_size;
+  fseek(f, 7 * sizeof(uint64_t), SEEK_SET);
+  for (long i = 7 * sizeof(uint64_t); i < end; ++i) {
+    fputc(0xff, f);
+  }
+  fclose(f);
+
+  // The header is intact, so the file maps, but no lookup may leave the mapping
+  ioopm_frozen_table_t *mapped = ioopm_frozen_table_map(path, ioopm_string_hash, string_eq_function);
+  unlink(path);
+  CU_ASSERT_PTR_NOT_NULL(mapped);
+  for (size_t i = 0; i < no_words; ++i) {
+    CU_ASSERT_FALSE(ioopm_frozen_table_has_key(mapped, ptr_elem(words[i])));
+  }
+
+  ioopm_frozen_table_destroy(mapped);
+  ioopm_frozen_table_destroy(ft);
+  ioopm_hash_table_destroy(ht);
+}
+
+
+/*
+ * =========================================
+ * SECTION: Main
+ * =========================================
+ */
+
+int main() {
+  // First we try to set up CUnit, and exit if we fail
+  if (CU_initialize_registry() != CUE_SUCCESS)
+    return CU_get_error();
+
+  // We then create an empty test suite and specify the name and
+  // the init and cleanup functions
+  CU_pSuite my_test_suite = CU_add_suite("Unit tests for frozen table", init_suite, clean_suite);
+  if (my_test_suite == NULL) {
+      // If the test suite could not be added, tear down CUnit and exit
+      CU_cleanup_registry();
+      return CU_get_error();
+  }
+
+  if (
+    (CU_add_test(my_test_suite, "Freeze a table and look up every key", test_freeze_lookup) == NULL) ||
+    (CU_add_test(my_test_suite, "Freeze empty and single-entry tables", test_freeze_small_and_empty) == NULL) ||
+    (CU_add_test(my_test_suite, "Freezing fails on equal hash values", test_freeze_hash_collision) == NULL) ||
+    (CU_add_test(my_test_suite, "Save and map a frozen table", test_save_map) == NULL) ||
+    (CU_add_test(my_test_suite, "Save and map with string keys", test_save_map_string_keys) == NULL) ||
+    (CU_add_test(my_test_suite, "Mapping rejects invalid files", test_map_invalid_file) == NULL) ||
+    (CU_add_test(my_test_suite, "Lookups in a damaged file fail", test_map_damaged_file) == NULL) ||
+    0
+  )
+    {
+      // If adding any of the tests fails, we tear down CUnit and exit
+      CU_cleanup_registry();
+      return CU_get_error();
+    }
+
+  // Set the running mode. Use CU_BRM_VERBOSE for maximum output.
+  // Use CU_BRM_NORMAL to only print errors and a summary
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+
+  // This is where the tests are actually run!
+  CU_basic_run_tests();
+
+  // Tear down CUnit before exiting
+  CU_cleanup_registry();
+  return CU_get_error();
+}
@@ -10,6 +10,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include <stdint.h>
 #include "hash_table.h"
 #include "linked_list.h"
 
@@ -30,14 +31,45 @@ struct entry
   entry_t *next;
 };
 
+/// The dummy head of a bucket can be shared between a table and its snapshots.
+/// Its (otherwise unused) key counts how many tables refer to the bucket.
+#define Bucket_Refs(dummy) ((dummy)->key.uintValue)
+
+/// Blocked Bloom filter: every key sets Bloom_Probes bits inside a single
+/// cache line sized block, so a query costs at most one cache miss.
+#define Bloom_Block_Words 8
+#define Bloom_Block_Bits (Bloom_Block_Words * 64)
+#define Bloom_Bits_Per_Key 10
+#define Bloom_Probes 7
+
+typedef struct bloom_filter bloom_filter_t;
+
+struct bloom_filter
+{
+  uint64_t (*blocks)[Bloom_Block_Words];
+  size_t no_blocks;
+};
+
+
+/// One bit per bucket, set while the bucket has at least one entry.
+#define Occupied_Words (No_Buckets / 64)
+_Static_assert(No_Buckets % 64 == 0, "No_Buckets must be a multiple of 64");
+
+/// @brief Loops over the indices of all non-empty buckets in ascending order.
+#define FOR_EACH_OCCUPIED(ht, i) \
+  for(size_t i = next_occupied((ht), 0); i < No_Buckets; i = next_occupied((ht), i + 1))
 
 struct hash_table
 {
   entry_t *buckets[No_Buckets];   
+  uint64_t occupied[Occupied_Words]; /// Bitmap of non-empty buckets, lets iteration skip empty ones.
   size_t size;
   ioopm_hash_function hash_func;
   ioopm_eq_function key_eq_func;
   ioopm_eq_function value_eq_func;
+  bloom_filter_t *bloom;          /// Optional filter consulted before probing, NULL if not attached.
+  ioopm_copy_function copy_key_func; /// Copies keys inserted by ioopm_counter_table_increment, may be NULL.
+  entry_t *empty_head;            /// Dummy head shared by the buckets shrink_to_fit or clear emptied, or NULL.
 };
 
 //Förklara gärna mer vad det är för strukt, vad är target_elem samt eq_args_t?
@@ -82,6 +114,165 @@ static void entry_destroy(entry_t *entry){
   }
 }
 
+/// @brief Creates an empty bucket (a dummy head) owned by a single table.
+/// @return A pointer to the dummy head, or NULL if memory allocation fails.
+static entry_t *bucket_create(void){
+  return entry_create((elem_t){.uintValue = 1}, ptr_elem(NULL), NULL);
+}
+
+/// @brief Drops one reference to a bucket, freeing its chain when no table uses it anymore.
+/// @param dummy The dummy head of the bucket.
+static void bucket_release(entry_t *dummy){
+  if(!dummy) return;
+
+  Bucket_Refs(dummy) -= 1;
+  if(Bucket_Refs(dummy) == 0){
+    entry_destroy(dummy);
+  }
+}
+
+/// @brief Makes sure a bucket is owned only by ht before it is modified (copy-on-write).
+/// @param ht The hash table that is about to modify the bucket.
+/// @param bucket The index of the bucket.
+/// @return true if the bucket can be modified, false if memory allocation fails.
+static bool bucket_make_private(ioopm_hash_table_t *ht, int bucket){
+  entry_t *shared = ht->buckets[bucket];
+  if(Bucket_Refs(shared) <= 1) return true;
+
+  entry_t *copy = bucket_create();
+  if(!copy) return false;
+
+  entry_t *last = copy;
+  for(entry_t *entry = shared->next; entry; entry = entry->next){
+    last->next = entry_create(entry->key, entry->value, NULL);
+    if(!last->next){
+      entry_destroy(copy);
+      return false;
+    }
+    last = last->next;
+  }
+
+  Bucket_Refs(shared) -= 1;
+  ht->buckets[bucket] = copy;
+
+  return true;
+}
+
+/// @brief Estimates the bookkeeping malloc adds to an allocation of the given size.
+/// @param size The requested allocation size.
+/// @return The number of bytes used beyond size (an 8 byte chunk header, rounded up
+///         to 16 bytes with a 32 byte minimum chunk, as in glibc).
+static size_t allocator_overhead(size_t size){
+  size_t chunk = (size + sizeof(size_t) + 15) & ~(size_t)15;
+  if(chunk < 32) chunk = 32;
+
+  return chunk - size;
+}
+
+/// @brief Marks a bucket as holding entries.
+/// @param ht Pointer to the hash table.
+/// @param bucket The index of the bucket.
+static inline void mark_occupied(ioopm_hash_table_t *ht, size_t bucket){
+  ht->occupied[bucket / 64] |= 1ULL << (bucket % 64);
+}
+
+/// @brief Marks a bucket as empty.
+/// @param ht Pointer to the hash table.
+/// @param bucket The index of the bucket.
+static inline void mark_empty(ioopm_hash_table_t *ht, size_t bucket){
+  ht->occupied[bucket / 64] &= ~(1ULL << (bucket % 64));
+}
+
+/// @brief Finds the first non-empty bucket at or after a given index.
+/// @param ht Pointer to the hash table.
+/// @param from The index to start searching from.
+/// @return The index of the bucket, or No_Buckets if there is none.
+static inline size_t next_occupied(ioopm_hash_table_t *ht, size_t from){
+  size_t word = from / 64;
+  if(word >= Occupied_Words) return No_Buckets;
+
+  uint64_t bits = ht->occupied[word] & (~0ULL << (from % 64));
+  while(!bits){
+    if(++word == Occupied_Words) return No_Buckets;
+    bits = ht->occupied[word];
+  }
+
+  return word * 64 + __builtin_ctzll(bits);
+}
+
+/// @brief Creates an empty Bloom filter sized for an expected number of keys.
+/// @param expected_keys The number of keys the filter should hold with a low false positive rate.
+/// @return A pointer to the filter, or NULL if memory allocation fails.
+static bloom_filter_t *bloom_create(size_t expected_keys){
+  bloom_filter_t *bloom = calloc(1, sizeof(bloom_filter_t));
+  if(!bloom) return NULL;
+
+  bloom->no_blocks = (expected_keys * Bloom_Bits_Per_Key + Bloom_Block_Bits - 1) / Bloom_Block_Bits;
+  if(bloom->no_blocks == 0) bloom->no_blocks = 1;
+
+  size_t bytes = bloom->no_blocks * sizeof(*bloom->blocks);
+  bloom->blocks = aligned_alloc(64, bytes);
+  if(!bloom->blocks){
+    free(bloom);
+    return NULL;
+  }
+  memset(bloom->blocks, 0, bytes);
+
+  return bloom;
+}
+
+/// @brief Frees a Bloom filter.
+/// @param bloom The filter to free (may be NULL).
+static void bloom_destroy(bloom_filter_t *bloom){
+  if(!bloom) return;
+
+  free(bloom->blocks);
+  free(bloom);
+}
+
+/// @brief Adds a key to, or checks a key against, the Bloom filter of a table.
+/// @param bloom The filter.
+/// @param hash The (unmixed) hash of the key.
+/// @param add true to set the key's bits, false to only test them.
+/// @return true if all of the key's bits are set (after adding, always true).
+static bool bloom_probe(bloom_filter_t *bloom, size_t hash, bool add){
+  uint64_t mixed = ioopm_mix_hash(hash);
+  uint64_t *block = bloom->blocks[mixed % bloom->no_blocks];
+  uint64_t bits = ioopm_mix_hash(mixed);
+
+  bool found = true;
+  for(int i = 0; i < Bloom_Probes; ++i){
+    unsigned bit = bits & (Bloom_Block_Bits - 1);
+    uint64_t mask = 1ULL << (bit & 63);
+    bits >>= 9;
+
+    if(add){
+      block[bit >> 6] |= mask;
+    }
+    else if(!(block[bit >> 6] & mask)){
+      found = false;
+      break;
+    }
+  }
+
+  return found;
+}
+
+/// @brief Checks whether a key may be in the table, without touching the buckets.
+/// @param ht Pointer to the hash table.
+/// @param key The key to check.
+/// @return false if the key is definitely absent, true otherwise.
+static inline bool bloom_may_contain(ioopm_hash_table_t *ht, elem_t key){
+  return !ht->bloom || bloom_probe(ht->bloom, ht->hash_func(key), false);
+}
+
+/// @brief Records a key in the Bloom filter of a table, if it has one.
+/// @param ht Pointer to the hash table.
+/// @param key The key to record.
+static inline void bloom_add(ioopm_hash_table_t *ht, elem_t key){
+  if(ht->bloom) bloom_probe(ht->bloom, ht->hash_func(key), true);
+}
+
 /// @brief Finds the entry before the entry containing the given key.
 /// @param first_entry The first entry in the linked list (may be a dummy head).
 /// @param key The key to search for.
@@ -98,17 +289,6 @@ static entry_t *find_previous_entry_for_key(entry_t *first_entry, elem_t key, io
   return cursor;
 }
 
-/// @brief Predicate function to check if a key matches a target key.
-/// @param key The key to check.
-/// @param value The associated value (unused).
-/// @param extra A pointer to an eq_args_t struct containing the target key and equality function.
-/// @return true if the key matches the target key, false otherwise.
-static bool key_match(elem_t key, elem_t value, void *extra){
-  eq_args_t *args = (eq_args_t *)extra;
-
-  return args->eq_func(key, args->target_elem);
-}
-
 /// @brief Predicate function to check if a value matches a target value.
 /// @param key The key (unused).
 /// @param value The value to check.
@@ -131,33 +311,47 @@ static inline int calculate_bucket_idx(ioopm_hash_table_t *ht, elem_t key) {
 
 
 
+size_t ioopm_string_hash(elem_t key){
+  const unsigned char *str = key.ptrValue;
+  uint64_t hash = 14695981039346656037ULL;
+  while(*str){
+    hash ^= *str++;
+    hash *= 1099511628211ULL;
+  }
+
+  return hash;
+}
+
 ioopm_hash_table_t *ioopm_hash_table_create(ioopm_hash_function hash_func, ioopm_eq_function key_eq_func, ioopm_eq_function value_eq_func){
   ioopm_hash_table_t *ht = calloc(1, sizeof(ioopm_hash_table_t));
   if(!ht) return NULL;
   //Känns som att ha en dummy node för varje bucket göra ht onödigt stort?
   for(size_t i = 0; i < No_Buckets; ++i){
-    ht->buckets[i] = entry_create(int_elem(0), ptr_elem(NULL), NULL);
+    ht->buckets[i] = bucket_create();
   }
 
   ht->size = 0;
   ht->hash_func = hash_func;
   ht->key_eq_func = key_eq_func;
   ht->value_eq_func = value_eq_func;
+  ht->bloom = NULL;
 
   return ht;
 }
 
 void ioopm_hash_table_destroy(ioopm_hash_table_t *ht) {
   for(size_t i = 0; i < No_Buckets; ++i){
-    entry_t *entry = ht->buckets[i];
-    entry_destroy(entry);
+    bucket_release(ht->buckets[i]);
   }
+  bucket_release(ht->empty_head);
   
+  bloom_destroy(ht->bloom);
   free(ht);
 }
 
 void ioopm_hash_table_insert(ioopm_hash_table_t *ht, elem_t key, elem_t value) {
   int bucket = calculate_bucket_idx(ht, key);
+  if(!bucket_make_private(ht, bucket)) return;
 
   entry_t *entry = find_previous_entry_for_key(ht->buckets[bucket], key, ht->key_eq_func);
   entry_t *next = entry->next;
@@ -166,12 +360,35 @@ void ioopm_hash_table_insert(ioopm_hash_table_t *ht, elem_t key, elem_t value) {
     next->value = value;
   }
   else{
-    entry->next = entry_create(key, value, next);
+    entry_t *new_entry = entry_create(key, value, next);
+    if(!new_entry) return;
+
+    entry->next = new_entry;
     ht->size += 1;
+    mark_occupied(ht, bucket);
+    bloom_add(ht, key);
   }
 }
 
+option_t ioopm_hash_table_replace(ioopm_hash_table_t *ht, elem_t key, elem_t value){
+  if(!ht || !bloom_may_contain(ht, key)) return Failure();
+
+  int bucket = calculate_bucket_idx(ht, key);
+  entry_t *prev = find_previous_entry_for_key(ht->buckets[bucket], key, ht->key_eq_func);
+  if(!prev->next || !ht->key_eq_func(prev->next->key, key)) return Failure();
+  if(!bucket_make_private(ht, bucket)) return Failure();
+
+  prev = find_previous_entry_for_key(ht->buckets[bucket], key, ht->key_eq_func);
+  entry_t *entry = prev->next;
+  elem_t old_value = entry->value;
+  entry->key = key;
+  entry->value = value;
+  return Success(old_value);
+}
+
 option_t ioopm_hash_table_lookup(ioopm_hash_table_t *ht, elem_t key){
+  if(!bloom_may_contain(ht, key)) return Failure();
+
   int bucket = calculate_bucket_idx(ht, key);
   entry_t *tmp = find_previous_entry_for_key(ht->buckets[bucket], key, ht->key_eq_func);
   entry_t *next = tmp->next;
@@ -189,7 +406,16 @@ option_t ioopm_hash_table_remove(ioopm_hash_table_t *ht, elem_t key){
     return Failure();
   }
 
-  entry_t *dummy = ht->buckets[ht->hash_func(key) % No_Buckets]; //segfault om ht->buckets är null?
+  if(!bloom_may_contain(ht, key)) return Failure();
+
+  int bucket = ht->hash_func(key) % No_Buckets;
+  entry_t *dummy = ht->buckets[bucket]; //segfault om ht->buckets är null?
+
+  if(Bucket_Refs(dummy) > 1){
+    entry_t *prev = find_previous_entry_for_key(dummy, key, ht->key_eq_func);
+    if(!prev->next || !bucket_make_private(ht, bucket)) return Failure();
+    dummy = ht->buckets[bucket];
+  }
 
   entry_t *prev = dummy;
   entry_t *current = prev->next;
@@ -203,6 +429,7 @@ option_t ioopm_hash_table_remove(ioopm_hash_table_t *ht, elem_t key){
       current = NULL; // change
       //Sätta current till NULL? förebygga för ev. dangling pointers
       ht->size -= 1;
+      if(!dummy->next) mark_empty(ht, bucket);
       return Success(value);
     }
 
@@ -223,26 +450,60 @@ bool ioopm_hash_table_is_empty(ioopm_hash_table_t *ht){
   return !ht || ht->size == 0;
 }
 
+ioopm_hash_function ioopm_hash_table_hash_function(ioopm_hash_table_t *ht){
+  return ht ? ht->hash_func : NULL;
+}
+
+ioopm_eq_function ioopm_hash_table_key_eq_function(ioopm_hash_table_t *ht){
+  return ht ? ht->key_eq_func : NULL;
+}
+
 void ioopm_hash_table_clear(ioopm_hash_table_t *ht){
   if(!ht) return;
 
-  for(size_t i = 0; i < No_Buckets; ++i){
-    if(ht->buckets[i]){
+  // Shared chains are left to the snapshots and their buckets take the empty head, which is
+  // the only allocation and is made before anything changes
+  if(!ht->empty_head){
+    bool shared = false;
+    FOR_EACH_OCCUPIED(ht, i){
+      if(Bucket_Refs(ht->buckets[i]) > 1){
+        shared = true;
+        break;
+      }
+    }
+    if(shared){
+      ht->empty_head = bucket_create();
+      if(!ht->empty_head) return;
+    }
+  }
+
+  FOR_EACH_OCCUPIED(ht, i){
+    if(Bucket_Refs(ht->buckets[i]) > 1){
+      bucket_release(ht->buckets[i]);
+      Bucket_Refs(ht->empty_head) += 1;
+      ht->buckets[i] = ht->empty_head;
+    }
+    else{
       entry_t *entry = ht->buckets[i]->next;
       entry_destroy(entry);
       ht->buckets[i]->next = NULL;
     }
+    mark_empty(ht, i);
   }
 
   ht->size = 0;
+  if(ht->bloom){
+    memset(ht->bloom->blocks, 0, ht->bloom->no_blocks * sizeof(*ht->bloom->blocks));
+  }
 }
 
 ioopm_list_t *ioopm_hash_table_keys(ioopm_hash_table_t *ht) {
   if (!ht) return NULL;
 
-  ioopm_list_t *keys_list = ioopm_linked_list_create(ht->key_eq_func);
+  ioopm_list_t *keys_list = ioopm_linked_list_create_with_storage(ht->key_eq_func, IOOPM_LIST_ARRAY);
+  ioopm_linked_list_reserve(keys_list, ht->size);
 
-  for (size_t i = 0; i < No_Buckets; ++i) {
+  FOR_EACH_OCCUPIED(ht, i) {
     entry_t *entry = ht->buckets[i]->next; // Skip the dummy head if you have one
     while (entry) {
       ioopm_linked_list_append(keys_list, entry->key);
@@ -257,9 +518,10 @@ ioopm_list_t *ioopm_hash_table_keys(ioopm_hash_table_t *ht) {
 ioopm_list_t *ioopm_hash_table_values(ioopm_hash_table_t *ht) {
   if (!ht) return NULL;
 
-  ioopm_list_t *values_list = ioopm_linked_list_create(ht->value_eq_func);
+  ioopm_list_t *values_list = ioopm_linked_list_create_with_storage(ht->value_eq_func, IOOPM_LIST_ARRAY);
+  ioopm_linked_list_reserve(values_list, ht->size);
 
-  for (size_t i = 0; i < No_Buckets; ++i) {
+  FOR_EACH_OCCUPIED(ht, i) {
     entry_t *entry = ht->buckets[i]->next; // Skip the dummy head if you have one
     while (entry) {
       ioopm_linked_list_append(values_list, entry->value);
@@ -272,9 +534,10 @@ ioopm_list_t *ioopm_hash_table_values(ioopm_hash_table_t *ht) {
 
 
 bool ioopm_hash_table_has_key(ioopm_hash_table_t *ht, elem_t key){
-  eq_args_t args = {.eq_func = ht->key_eq_func, .target_elem = key};
+  if(!ht) return false;
 
-  return ioopm_hash_table_any(ht, key_match, &args);
+  // Equal keys hash to the same bucket, so only that bucket needs to be searched
+  return Successful(ioopm_hash_table_lookup(ht, key));
 }
 
 bool ioopm_hash_table_has_value(ioopm_hash_table_t *ht, elem_t value){
@@ -296,7 +559,7 @@ bool ioopm_hash_table_any(ioopm_hash_table_t *ht, ioopm_predicate pred, void *ar
   //Kan vara förvirrande utan att ha ngt felmeddelande som säger vad som är fel för !ht eller !pred
   // då kanske inte användaren vet om det inte fanns någon som matchade predikatet eller om det ör ett tomt ht exempelvis
 
-  for(size_t i = 0; i < No_Buckets; ++i){
+  FOR_EACH_OCCUPIED(ht, i){
     entry_t *entry = ht->buckets[i]->next;
     while(entry){
       if(pred(entry->key, entry->value, arg)){
@@ -313,7 +576,7 @@ bool ioopm_hash_table_any(ioopm_hash_table_t *ht, ioopm_predicate pred, void *ar
 bool ioopm_hash_table_all(ioopm_hash_table_t *ht, ioopm_predicate pred, void *arg){
   if(!ht || !pred) return false;
 
-  for(size_t i = 0; i < No_Buckets; ++i){
+  FOR_EACH_OCCUPIED(ht, i){
     entry_t *entry = ht->buckets[i]->next;
 
     while(entry){
@@ -331,7 +594,9 @@ bool ioopm_hash_table_all(ioopm_hash_table_t *ht, ioopm_predicate pred, void *ar
 void ioopm_hash_table_apply_to_all(ioopm_hash_table_t *ht, ioopm_apply_function apply_fun, void *arg){
   if(!ht || !apply_fun) return;
 
-  for(size_t i = 0; i < No_Buckets; ++i){
+  FOR_EACH_OCCUPIED(ht, i){
+    if(!bucket_make_private(ht, i)) continue;
+
     entry_t *entry = ht->buckets[i]->next;
     while(entry){
       apply_fun(entry->key, &(entry->value), arg);
@@ -339,3 +604,232 @@ void ioopm_hash_table_apply_to_all(ioopm_hash_table_t *ht, ioopm_apply_function
     }
   }
 }
+
+ioopm_status_t ioopm_hash_table_merge(ioopm_hash_table_t *dst, ioopm_hash_table_t *src, ioopm_combine_function combine_fun, void *arg){
+  if(!dst || !src) return IOOPM_ERROR_NULL_PROPERTY;
+  if(dst == src) return IOOPM_ERROR_SAME_LIST;
+
+  bool same_layout = dst->hash_func == src->hash_func;
+
+  FOR_EACH_OCCUPIED(src, i){
+    if(!bucket_make_private(src, i)) return IOOPM_ERROR_MEMORY_ALLOCATION;
+
+    entry_t *src_head = src->buckets[i];
+
+    // Nothing to collide with, the whole chain can be moved over as is
+    if(same_layout && !dst->buckets[i]->next && bucket_make_private(dst, i)){
+      entry_t *entry = src_head->next;
+      src_head->next = NULL;
+      mark_empty(src, i);
+      dst->buckets[i]->next = entry;
+      mark_occupied(dst, i);
+      while(entry){
+        dst->size += 1;
+        src->size -= 1;
+        bloom_add(dst, entry->key);
+        entry = entry->next;
+      }
+      continue;
+    }
+
+    // Entries are unlinked from src one at a time, only once dst has taken them
+    while(src_head->next){
+      entry_t *entry = src_head->next;
+      int bucket = same_layout ? (int)i : calculate_bucket_idx(dst, entry->key);
+      if(!bucket_make_private(dst, bucket)) return IOOPM_ERROR_MEMORY_ALLOCATION;
+
+      src_head->next = entry->next;
+      src->size -= 1;
+
+      entry_t *prev = find_previous_entry_for_key(dst->buckets[bucket], entry->key, dst->key_eq_func);
+      entry_t *existing = prev->next;
+
+      if(existing){
+        existing->value = combine_fun ? combine_fun(entry->key, existing->value, entry->value, arg) : entry->value;
+        free(entry);
+      }
+      else{
+        entry->next = NULL;
+        prev->next = entry;
+        dst->size += 1;
+        mark_occupied(dst, bucket);
+        bloom_add(dst, entry->key);
+      }
+    }
+    mark_empty(src, i);
+  }
+
+  return IOOPM_SUCCESS;
+}
+
+ioopm_hash_table_t *ioopm_hash_table_snapshot(ioopm_hash_table_t *ht){
+  if(!ht) return NULL;
+
+  ioopm_hash_table_t *snapshot = calloc(1, sizeof(ioopm_hash_table_t));
+  if(!snapshot) return NULL;
+
+  *snapshot = *ht;
+  snapshot->bloom = NULL;
+  for(size_t i = 0; i < No_Buckets; ++i){
+    Bucket_Refs(ht->buckets[i]) += 1;
+  }
+  if(ht->empty_head) Bucket_Refs(ht->empty_head) += 1;
+
+  return snapshot;
+}
+
+ioopm_memory_usage_t ioopm_hash_table_memory_usage(ioopm_hash_table_t *ht, ioopm_size_function key_size_func){
+  ioopm_memory_usage_t usage = {0};
+  if(!ht) return usage;
+
+  size_t entry_overhead = allocator_overhead(sizeof(entry_t));
+
+  usage.buckets = sizeof(ioopm_hash_table_t);
+  usage.allocator_overhead = allocator_overhead(sizeof(ioopm_hash_table_t));
+
+  if(ht->empty_head){
+    usage.buckets += sizeof(entry_t);
+    usage.allocator_overhead += entry_overhead;
+  }
+
+  for(size_t i = 0; i < No_Buckets; ++i){
+    if(ht->buckets[i] != ht->empty_head){
+      usage.buckets += sizeof(entry_t);
+      usage.allocator_overhead += entry_overhead;
+    }
+
+    for(entry_t *entry = ht->buckets[i]->next; entry; entry = entry->next){
+      usage.entries += sizeof(entry_t);
+      usage.allocator_overhead += entry_overhead;
+
+      if(key_size_func){
+        size_t key_size = key_size_func(entry->key);
+        usage.owned_keys += key_size;
+        usage.allocator_overhead += allocator_overhead(key_size);
+      }
+    }
+  }
+
+  if(ht->bloom){
+    size_t filter_bytes = ht->bloom->no_blocks * sizeof(*ht->bloom->blocks);
+    usage.bloom_filter = sizeof(bloom_filter_t) + filter_bytes;
+    usage.allocator_overhead += allocator_overhead(sizeof(bloom_filter_t)) + allocator_overhead(filter_bytes);
+  }
+
+  usage.total = usage.buckets + usage.entries + usage.bloom_filter + usage.allocator_overhead + usage.owned_keys;
+
+  return usage;
+}
+
+size_t ioopm_hash_table_shrink_to_fit(ioopm_hash_table_t *ht){
+  if(!ht) return 0;
+
+  size_t entry_size = sizeof(entry_t) + allocator_overhead(sizeof(entry_t));
+  size_t released = 0;
+  size_t allocated = 0;
+
+  // The table holds one reference to its empty head, so buckets pointing at it count as
+  // shared and the first insert into one of them copies it
+  if(!ht->empty_head){
+    ht->empty_head = bucket_create();
+    if(!ht->empty_head) return 0;
+    allocated = entry_size;
+  }
+
+  for(size_t i = 0; i < No_Buckets; ++i){
+    entry_t *dummy = ht->buckets[i];
+    if(dummy == ht->empty_head || dummy->next) continue;
+
+    Bucket_Refs(ht->empty_head) += 1;
+    ht->buckets[i] = ht->empty_head;
+    if(Bucket_Refs(dummy) == 1){
+      released += entry_size;
+    }
+    bucket_release(dummy);
+  }
+
+  return released > allocated ? released - allocated : 0;
+}
+
+bool ioopm_hash_table_attach_bloom_filter(ioopm_hash_table_t *ht, size_t expected_keys){
+  if(!ht) return false;
+
+  if(expected_keys < ht->size) expected_keys = ht->size;
+
+  bloom_filter_t *bloom = bloom_create(expected_keys);
+  if(!bloom) return false;
+
+  bloom_destroy(ht->bloom);
+  ht->bloom = bloom;
+
+  FOR_EACH_OCCUPIED(ht, i){
+    for(entry_t *entry = ht->buckets[i]->next; entry; entry = entry->next){
+      bloom_add(ht, entry->key);
+    }
+  }
+
+  return true;
+}
+
+bool ioopm_hash_table_rebuild_bloom_filter(ioopm_hash_table_t *ht){
+  if(!ht || !ht->bloom) return false;
+
+  size_t capacity = ht->bloom->no_blocks * Bloom_Block_Bits / Bloom_Bits_Per_Key;
+
+  return ioopm_hash_table_attach_bloom_filter(ht, capacity);
+}
+
+void ioopm_hash_table_detach_bloom_filter(ioopm_hash_table_t *ht){
+  if(!ht) return;
+
+  bloom_destroy(ht->bloom);
+  ht->bloom = NULL;
+}
+
+/// @brief Equality function for counter values.
+/// @param a The first value.
+/// @param b The second value.
+/// @return true if the counts are equal.
+static bool counter_eq(elem_t a, elem_t b){
+  return a.uint64Value == b.uint64Value;
+}
+
+ioopm_hash_table_t *ioopm_counter_table_create(ioopm_hash_function hash_func, ioopm_eq_function key_eq_func,
+                                               ioopm_copy_function copy_key_func){
+  ioopm_hash_table_t *ht = ioopm_hash_table_create(hash_func, key_eq_func, counter_eq);
+  if(!ht) return NULL;
+
+  ht->copy_key_func = copy_key_func;
+
+  return ht;
+}
+
+uint64_t ioopm_counter_table_increment(ioopm_hash_table_t *ht, elem_t key, uint64_t delta){
+  if(!ht) return 0;
+
+  int bucket = calculate_bucket_idx(ht, key);
+  if(!bucket_make_private(ht, bucket)) return 0;
+
+  entry_t *prev = find_previous_entry_for_key(ht->buckets[bucket], key, ht->key_eq_func);
+  entry_t *next = prev->next;
+
+  if(next && ht->key_eq_func(next->key, key)){
+    next->value.uint64Value += delta;
+    return next->value.uint64Value;
+  }
+
+  if(ht->copy_key_func){
+    key = ht->copy_key_func(key);
+    if(!key.ptrValue) return 0;
+  }
+
+  entry_t *entry = entry_create(key, (elem_t){.uint64Value = delta}, next);
+  if(!entry) return 0;
+
+  prev->next = entry;
+  ht->size += 1;
+  mark_occupied(ht, bucket);
+  bloom_add(ht, key);
+
+  return delta;
+}
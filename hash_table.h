@@ -24,6 +24,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "linked_list.h"
 
 #define Success(v)      (option_t){.success = true, .value = v}
@@ -43,8 +44,13 @@ typedef struct hash_table ioopm_hash_table_t;
 typedef struct option option_t;
 typedef bool (*ioopm_predicate)(elem_t key, elem_t value, void *extra);
 typedef void (*ioopm_apply_function)(elem_t key, elem_t *value, void *extra);  //Changed to void to work with append_suffix
-typedef size_t (*ioopm_hash_function)(elem_t key);
 typedef bool (*ioopm_eq_function)(elem_t a, elem_t b);
+typedef size_t (*ioopm_size_function)(elem_t elem);
+typedef struct memory_usage ioopm_memory_usage_t;
+typedef elem_t (*ioopm_combine_function)(elem_t key, elem_t dst_value, elem_t src_value, void *extra);
+typedef elem_t (*ioopm_copy_function)(elem_t elem);
+typedef void (*ioopm_free_function)(elem_t elem);
+typedef void (*ioopm_evict_function)(elem_t key, elem_t value, void *extra);
 
 struct option
 {
@@ -52,6 +58,17 @@ struct option
   elem_t value;
 };
 
+/// @brief Breakdown of the memory used by a hash table, in bytes.
+struct memory_usage
+{
+  size_t buckets;             /// The table itself and the dummy head of every allocated bucket.
+  size_t entries;             /// The entries holding key-value pairs.
+  size_t bloom_filter;        /// The Bloom filter, if one is attached.
+  size_t allocator_overhead;  /// Estimated malloc headers and padding for all of the above.
+  size_t owned_keys;          /// Key storage, as reported by the caller's size function.
+  size_t total;               /// Sum of all fields above.
+};
+
 
 /*
  * =========================================
@@ -59,6 +76,11 @@ struct option
  * =========================================
  */
 
+/// @brief Hash function for NUL-terminated string keys (FNV-1a).
+/// @param key The key, whose ptrValue points to the string.
+/// @return The hash value.
+size_t ioopm_string_hash(elem_t key);
+
 /// @brief Create a new hash table.
 /// @param hash_func Function used to hash keys.
 /// @param key_eq_func Function used to compare keys for equality.
@@ -76,6 +98,14 @@ void ioopm_hash_table_destroy(ioopm_hash_table_t *ht);
 /// @param value Value to associate with the key.
 void ioopm_hash_table_insert(ioopm_hash_table_t *ht, elem_t key, elem_t value);
 
+/// @brief Replace an existing entry, key and value, without allocating an entry.
+/// @param ht Hash table operated upon.
+/// @param key Key to store in place of the equal key already in the table.
+/// @param value Value to associate with the key.
+/// @return Success with the old value, or Failure if no equal key is in the table or a shared
+///         bucket could not be copied; the table is then unchanged.
+option_t ioopm_hash_table_replace(ioopm_hash_table_t *ht, elem_t key, elem_t value);
+
 /// @brief Lookup the value associated with a key in the hash table.
 /// @param ht Hash table operated upon.
 /// @param key Key to lookup.
@@ -98,18 +128,30 @@ int ioopm_hash_table_size(ioopm_hash_table_t *ht);
 /// @return true if the hash table is empty, false otherwise.
 bool ioopm_hash_table_is_empty(ioopm_hash_table_t *ht);
 
+/// @brief Returns the hash function a hash table was created with.
+/// @param ht Hash table operated upon.
+/// @return The hash function, or NULL if ht is NULL.
+ioopm_hash_function ioopm_hash_table_hash_function(ioopm_hash_table_t *ht);
+
+/// @brief Returns the key equality function a hash table was created with.
+/// @param ht Hash table operated upon.
+/// @return The key equality function, or NULL if ht is NULL.
+ioopm_eq_function ioopm_hash_table_key_eq_function(ioopm_hash_table_t *ht);
+
 /// @brief Clear all the entries in a hash table.
 /// @param ht Hash table operated upon.
+/// @note Buckets shared with a snapshot are not copied, so clearing allocates at most one
+///       empty bucket; if that fails the table is left unchanged.
 void ioopm_hash_table_clear(ioopm_hash_table_t *ht);
 
 /// @brief Return the keys for all entries in the hash table.
 /// @param ht Hash table operated upon.
-/// @return A linked list containing all keys in the hash table.
+/// @return A linked list containing all keys in the hash table (array storage).
 ioopm_list_t *ioopm_hash_table_keys(ioopm_hash_table_t *ht);
 
 /// @brief Return the values for all entries in the hash table.
 /// @param ht Hash table operated upon.
-/// @return A linked list containing all values in the hash table.
+/// @return A linked list containing all values in the hash table (array storage).
 ioopm_list_t *ioopm_hash_table_values(ioopm_hash_table_t *ht);
 
 /// @brief Check if a hash table has an entry with a given key.
@@ -144,6 +186,82 @@ bool ioopm_hash_table_any(ioopm_hash_table_t *ht, ioopm_predicate pred, void *ar
 /// @param arg Extra argument passed to the apply function.
 void ioopm_hash_table_apply_to_all(ioopm_hash_table_t *ht, ioopm_apply_function apply_fun, void *arg);
 
+/// @brief Move all entries from src into dst, combining values of keys present in both.
+/// @param dst Hash table that receives the entries.
+/// @param src Hash table whose entries are moved; it is empty afterwards on success.
+/// @param combine_fun Called with the key and both values when a key exists in both tables,
+///                    its result becomes the value in dst. May be NULL to keep the src value.
+/// @param arg Extra argument passed to the combine function.
+/// @return IOOPM_SUCCESS, IOOPM_ERROR_NULL_PROPERTY if a table is NULL, IOOPM_ERROR_SAME_LIST
+///         if dst and src are the same table, or IOOPM_ERROR_MEMORY_ALLOCATION if a shared
+///         bucket could not be copied. On failure the entries not yet moved stay in src.
+/// @note The src entry is discarded on collisions, so if keys are owned by the table
+///       combine_fun is the place to free the src key. When both tables use the same hash
+///       function entries are relinked bucket by bucket without rehashing or allocating.
+ioopm_status_t ioopm_hash_table_merge(ioopm_hash_table_t *dst, ioopm_hash_table_t *src, ioopm_combine_function combine_fun, void *arg);
+
+/// @brief Take a point-in-time snapshot of a hash table.
+/// @param ht Hash table to snapshot.
+/// @return A new hash table with the same content, or NULL if memory allocation fails.
+/// @note The snapshot shares all buckets with ht and costs O(buckets) to take. A bucket is
+///       copied (copy-on-write) the first time either table modifies it, so later writes to
+///       ht are never seen through the snapshot and vice versa. The snapshot is an ordinary
+///       table and must be freed with ioopm_hash_table_destroy; keys and values themselves
+///       are shared, not copied. The tables take no locks, so a snapshot handed to another
+///       thread must be created and destroyed while the live table is not being modified.
+ioopm_hash_table_t *ioopm_hash_table_snapshot(ioopm_hash_table_t *ht);
+
+/// @brief Report how much memory a hash table uses.
+/// @param ht Hash table operated upon.
+/// @param key_size_func Returns the number of bytes a key owns (e.g. strlen + 1 for
+///                      strdup:ed strings), or NULL if the table does not own its keys.
+/// @return A breakdown of the memory usage; all zero if ht is NULL.
+/// @note Buckets shared with snapshots are counted in full for every table referring to them.
+ioopm_memory_usage_t ioopm_hash_table_memory_usage(ioopm_hash_table_t *ht, ioopm_size_function key_size_func);
+
+/// @brief Release the storage of empty buckets, e.g. after many removes.
+/// @param ht Hash table operated upon.
+/// @return The estimated number of bytes returned to the allocator.
+/// @note Empty buckets are pointed at one empty head owned by the table (and shared with its
+///       snapshots), and get their own again on the next insert.
+size_t ioopm_hash_table_shrink_to_fit(ioopm_hash_table_t *ht);
+
+/// @brief Attach a blocked Bloom filter that lets lookups of absent keys skip the buckets.
+/// @param ht Hash table operated upon.
+/// @param expected_keys Number of keys the filter is sized for (about 10 bits per key,
+///                      under 1% false positives); never less than the current size.
+/// @return true on success, false if memory allocation fails (the old filter, if any, is kept).
+/// @note The filter is updated on insert and consulted by lookup, has_key and remove.
+///       Removed keys stay in the filter until it is rebuilt. Snapshots start without a filter.
+bool ioopm_hash_table_attach_bloom_filter(ioopm_hash_table_t *ht, size_t expected_keys);
+
+/// @brief Rebuild the Bloom filter from the current keys, e.g. after heavy removals.
+/// @param ht Hash table operated upon.
+/// @return true on success, false if no filter is attached or memory allocation fails.
+bool ioopm_hash_table_rebuild_bloom_filter(ioopm_hash_table_t *ht);
+
+/// @brief Remove and free the Bloom filter of a hash table, if any.
+/// @param ht Hash table operated upon.
+void ioopm_hash_table_detach_bloom_filter(ioopm_hash_table_t *ht);
+
+/// @brief Create a hash table whose values are 64-bit counters (elem_t.uint64Value).
+/// @param hash_func Function used to hash keys.
+/// @param key_eq_func Function used to compare keys for equality.
+/// @param copy_key_func Called when ioopm_counter_table_increment inserts a new key, e.g. to strdup
+///                      a transient string (returning a NULL ptrValue on failure); NULL stores keys as is.
+/// @return A new hash table, or NULL if memory allocation fails.
+/// @note All other hash table functions work on counter tables; values compare equal by count.
+ioopm_hash_table_t *ioopm_counter_table_create(ioopm_hash_function hash_func, ioopm_eq_function key_eq_func,
+                                               ioopm_copy_function copy_key_func);
+
+/// @brief Add delta to the counter of a key, inserting the key with count delta if it is missing.
+/// @param ht Counter table operated upon.
+/// @param key The key whose counter is incremented.
+/// @param delta The amount to add.
+/// @return The new count, or 0 if copying the key or memory allocation fails.
+/// @note The counter is updated in place, so existing keys cost a single bucket scan.
+uint64_t ioopm_counter_table_increment(ioopm_hash_table_t *ht, elem_t key, uint64_t delta);
+
 
 
 #endif // HASH_TABLE_H
@@ -52,7 +52,6 @@ static bool int_eq_function(elem_t a, elem_t b) {
     return a.intValue == b.intValue;
 }
 
-/*
 /// @brief Hash function for string keys.
 /// @param key The key to hash.
 /// @return The hash value.
@@ -65,7 +64,6 @@ static size_t string_hash_function(elem_t key) {
     }
     return hash;
 }
-*/
 
 /// @brief Equality function for string keys.
 /// @param a First string key.
@@ -119,6 +117,67 @@ static void destroy_value(elem_t key, elem_t *value, void *extra){
 }
 
 
+/// @brief A second hash function for integer keys, giving a different bucket layout.
+/// @param key The key to hash.
+/// @return The hash value.
+static size_t int_hash_function_shifted(elem_t key) {
+    return (size_t)key.intValue + 7;
+}
+
+/// @brief Combine function that adds two integer values.
+/// @param key The key (unused).
+/// @param dst_value The value in the destination table.
+/// @param src_value The value in the source table.
+/// @param extra Pointer to a counter of combined keys.
+/// @return The sum of both values.
+static elem_t sum_values(elem_t key, elem_t dst_value, elem_t src_value, void *extra) {
+  (void)key;
+  if (extra) {
+    *(int *)extra += 1;
+  }
+  return int_elem(dst_value.intValue + src_value.intValue);
+}
+
+
+/// @brief Size function for string keys owned by the table.
+/// @param key The key.
+/// @return The number of bytes of the string, including the terminator.
+static size_t string_size_function(elem_t key) {
+    return strlen(key.ptrValue) + 1;
+}
+
+
+/// @brief Number of key comparisons made through counting_eq_function.
+static size_t key_comparisons = 0;
+
+/// @brief Equality function for integer keys that counts how often it is called.
+/// @param a First integer key.
+/// @param b Second integer key.
+/// @return true if keys are equal, false otherwise.
+static bool counting_eq_function(elem_t a, elem_t b) {
+    key_comparisons++;
+    return a.intValue == b.intValue;
+}
+
+
+/// @brief Copy function for string keys inserted into counter tables.
+/// @param key The key to copy.
+/// @return A heap-allocated copy of the string.
+static elem_t string_copy_function(elem_t key) {
+    return ptr_elem(strdup(key.ptrValue));
+}
+
+/// @brief Apply function that frees string keys owned by the table.
+/// @param key The key to free.
+/// @param value The value (unused).
+/// @param extra Unused extra parameter.
+static void free_key(elem_t key, elem_t *value, void *extra) {
+  (void)value;
+  (void)extra;
+  free(key.ptrValue);
+}
+
+
 /*
  * =========================================
  * SECTION: Initialize and clean the suite
@@ -174,6 +233,13 @@ void test_insert_lookup(){
     CU_ASSERT(Successful(result));
     CU_ASSERT_STRING_EQUAL(result.value.ptrValue, "Two updated");
 
+    result = ioopm_hash_table_replace(ht, int_elem(2), ptr_elem("Two replaced"));
+    CU_ASSERT(Successful(result));
+    CU_ASSERT_STRING_EQUAL(result.value.ptrValue, "Two updated");
+    CU_ASSERT_STRING_EQUAL(ioopm_hash_table_lookup(ht, int_elem(2)).value.ptrValue, "Two replaced");
+    CU_ASSERT(Unsuccessful(ioopm_hash_table_replace(ht, int_elem(3), ptr_elem("Three"))));
+    CU_ASSERT_EQUAL(ioopm_hash_table_size(ht), 2);
+
     result = ioopm_hash_table_lookup(ht, int_elem(99));
     CU_ASSERT(Unsuccessful(result));
     
@@ -591,6 +657,351 @@ void test_apply_to_all_empty_table() {
 }
 
 
+void test_merge_same_layout() {
+    ioopm_hash_table_t *dst = ioopm_hash_table_create(int_hash_function, int_eq_function, NULL);
+    ioopm_hash_table_t *src = ioopm_hash_table_create(int_hash_function, int_eq_function, NULL);
+
+    // Keys 0..99 in dst and 50..149 in src, some of them sharing a bucket
+    for (int i = 0; i < 100; ++i) {
+      ioopm_hash_table_insert(dst, int_elem(i), int_elem(1));
+      ioopm_hash_table_insert(src, int_elem(i + 50), int_elem(2));
+    }
+    ioopm_hash_table_insert(src, int_elem(No_Buckets + 1), int_elem(2));
+
+    CU_ASSERT_EQUAL(ioopm_hash_table_merge(dst, NULL, NULL, NULL), IOOPM_ERROR_NULL_PROPERTY);
+    CU_ASSERT_EQUAL(ioopm_hash_table_merge(dst, dst, NULL, NULL), IOOPM_ERROR_SAME_LIST);
+    CU_ASSERT_EQUAL(ioopm_hash_table_size(dst), 100);
+
+    int combined = 0;
+    CU_ASSERT_EQUAL(ioopm_hash_table_merge(dst, src, sum_values, &combined), IOOPM_SUCCESS);
+
+    CU_ASSERT_EQUAL(combined, 50);
+    CU_ASSERT_EQUAL(ioopm_hash_table_size(dst), 151);
+    CU_ASSERT_TRUE(ioopm_hash_table_is_empty(src));
+    CU_ASSERT(Unsuccessful(ioopm_hash_table_lookup(src, int_elem(60))));
+
+    for (int i = 0; i < 150; ++i) {
+      option_t result = ioopm_hash_table_lookup(dst, int_elem(i));
+      CU_ASSERT(Successful(result));
+      CU_ASSERT_EQUAL(result.value.intValue, i < 50 ? 1 : (i < 100 ? 3 : 2));
+    }
+    CU_ASSERT(Successful(ioopm_hash_table_lookup(dst, int_elem(No_Buckets + 1))));
+
+    // src stays usable after the merge
+    ioopm_hash_table_insert(src, int_elem(1), int_elem(5));
+    CU_ASSERT_EQUAL(ioopm_hash_table_size(src), 1);
+
+    ioopm_hash_table_destroy(dst);
+    ioopm_hash_table_destroy(src);
+}
+
+void test_merge_different_layout() {
+    ioopm_hash_table_t *dst = ioopm_hash_table_create(int_hash_function, int_eq_function, NULL);
+    ioopm_hash_table_t *src = ioopm_hash_table_create(int_hash_function_shifted, int_eq_function, NULL);
+
+    for (int i = 0; i < 20; ++i) {
+      ioopm_hash_table_insert(dst, int_elem(i), int_elem(10));
+      ioopm_hash_table_insert(src, int_elem(i + 10), int_elem(20));
+    }
+
+    // Without a combine function the src value wins
+    CU_ASSERT_EQUAL(ioopm_hash_table_merge(dst, src, NULL, NULL), IOOPM_SUCCESS);
+
+    CU_ASSERT_EQUAL(ioopm_hash_table_size(dst), 30);
+    CU_ASSERT_EQUAL(ioopm_hash_table_size(src), 0);
+    for (int i = 0; i < 30; ++i) {
+      option_t result = ioopm_hash_table_lookup(dst, int_elem(i));
+      CU_ASSERT(Successful(result));
+      CU_ASSERT_EQUAL(result.value.intValue, i < 10 ? 10 : 20);
+    }
+
+    ioopm_hash_table_destroy(dst);
+    ioopm_hash_table_destroy(src);
+}
+
+
+void test_snapshot_isolation() {
+    ioopm_hash_table_t *ht = ioopm_hash_table_create(int_hash_function, int_eq_function, NULL);
+
+    for (int i = 0; i < 100; ++i) {
+      ioopm_hash_table_insert(ht, int_elem(i), int_elem(i));
+    }
+
+    ioopm_hash_table_t *snapshot = ioopm_hash_table_snapshot(ht);
+    CU_ASSERT_PTR_NOT_NULL(snapshot);
+    CU_ASSERT_EQUAL(ioopm_hash_table_size(snapshot), 100);
+
+    // Writes to the live table do not show up in the snapshot
+    ioopm_hash_table_insert(ht, int_elem(1), int_elem(1000));
+    ioopm_hash_table_insert(ht, int_elem(500), int_elem(500));
+    ioopm_hash_table_remove(ht, int_elem(2));
+
+    CU_ASSERT_EQUAL(ioopm_hash_table_lookup(ht, int_elem(1)).value.intValue, 1000);
+    CU_ASSERT_EQUAL(ioopm_hash_table_lookup(snapshot, int_elem(1)).value.intValue, 1);
+    CU_ASSERT(Unsuccessful(ioopm_hash_table_lookup(snapshot, int_elem(500))));
+    CU_ASSERT(Unsuccessful(ioopm_hash_table_lookup(ht, int_elem(2))));
+    CU_ASSERT(Successful(ioopm_hash_table_lookup(snapshot, int_elem(2))));
+    CU_ASSERT_EQUAL(ioopm_hash_table_size(ht), 100);
+    CU_ASSERT_EQUAL(ioopm_hash_table_size(snapshot), 100);
+
+    // Removing a missing key from a shared bucket leaves both untouched
+    CU_ASSERT(Unsuccessful(ioopm_hash_table_remove(ht, int_elem(No_Buckets + 3))));
+
+    // Writes to the snapshot do not show up in the live table
+    ioopm_hash_table_insert(snapshot, int_elem(3), int_elem(-3));
+    CU_ASSERT_EQUAL(ioopm_hash_table_lookup(ht, int_elem(3)).value.intValue, 3);
+
+    // Clearing the live table keeps the snapshot intact, also after the live table is gone
+    ioopm_hash_table_clear(ht);
+    CU_ASSERT_TRUE(ioopm_hash_table_is_empty(ht));
+    CU_ASSERT(Unsuccessful(ioopm_hash_table_lookup(ht, int_elem(99))));
+    ioopm_hash_table_insert(ht, int_elem(99), int_elem(-99));
+    CU_ASSERT_EQUAL(ioopm_hash_table_size(ht), 1);
+    ioopm_hash_table_destroy(ht);
+
+    CU_ASSERT_EQUAL(ioopm_hash_table_size(snapshot), 100);
+    CU_ASSERT_EQUAL(ioopm_hash_table_lookup(snapshot, int_elem(99)).value.intValue, 99);
+
+    ioopm_hash_table_destroy(snapshot);
+}
+
+void test_snapshot_apply_to_all() {
+    ioopm_hash_table_t *ht = ioopm_hash_table_create(int_hash_function, int_eq_function, string_eq_function);
+
+    ioopm_hash_table_insert(ht, int_elem(1), ptr_elem("one"));
+    ioopm_hash_table_insert(ht, int_elem(2), ptr_elem("two"));
+
+    ioopm_hash_table_t *snapshot = ioopm_hash_table_snapshot(ht);
+
+    ioopm_hash_table_apply_to_all(ht, append_suffix, "_modified");
+    CU_ASSERT_STRING_EQUAL(ioopm_hash_table_lookup(ht, int_elem(1)).value.ptrValue, "one_modified");
+    CU_ASSERT_STRING_EQUAL(ioopm_hash_table_lookup(snapshot, int_elem(1)).value.ptrValue, "one");
+    CU_ASSERT_STRING_EQUAL(ioopm_hash_table_lookup(snapshot, int_elem(2)).value.ptrValue, "two");
+
+    ioopm_hash_table_apply_to_all(ht, destroy_value, NULL);
+    ioopm_hash_table_destroy(ht);
+    ioopm_hash_table_destroy(snapshot);
+}
+
+
+void test_memory_usage() {
+    ioopm_hash_table_t *ht = ioopm_hash_table_create(int_hash_function, int_eq_function, NULL);
+
+    ioopm_memory_usage_t empty = ioopm_hash_table_memory_usage(ht, NULL);
+    CU_ASSERT(empty.buckets > 0);
+    CU_ASSERT_EQUAL(empty.entries, 0);
+    CU_ASSERT_EQUAL(empty.owned_keys, 0);
+    CU_ASSERT_EQUAL(empty.total, empty.buckets + empty.allocator_overhead);
+
+    for (int i = 0; i < 100; ++i) {
+      ioopm_hash_table_insert(ht, int_elem(i), int_elem(i));
+    }
+
+    ioopm_memory_usage_t full = ioopm_hash_table_memory_usage(ht, NULL);
+    CU_ASSERT_EQUAL(full.buckets, empty.buckets);
+    CU_ASSERT(full.entries > 0);
+    CU_ASSERT_EQUAL(full.entries % 100, 0);
+    CU_ASSERT(full.allocator_overhead > empty.allocator_overhead);
+    CU_ASSERT_EQUAL(full.total, full.buckets + full.entries + full.allocator_overhead + full.owned_keys);
+
+    ioopm_hash_table_destroy(ht);
+}
+
+void test_memory_usage_owned_keys() {
+    ioopm_hash_table_t *ht = ioopm_hash_table_create(string_hash_function, string_eq_function, NULL);
+
+    ioopm_hash_table_insert(ht, ptr_elem("abc"), int_elem(1));
+    ioopm_hash_table_insert(ht, ptr_elem("hello"), int_elem(2));
+
+    ioopm_memory_usage_t usage = ioopm_hash_table_memory_usage(ht, string_size_function);
+    CU_ASSERT_EQUAL(usage.owned_keys, 4 + 6);
+
+    ioopm_hash_table_destroy(ht);
+}
+
+void test_shrink_to_fit() {
+    ioopm_hash_table_t *ht = ioopm_hash_table_create(int_hash_function, int_eq_function, NULL);
+
+    for (int i = 0; i < No_Buckets; ++i) {
+      ioopm_hash_table_insert(ht, int_elem(i), int_elem(i));
+    }
+    for (int i = 0; i < No_Buckets; i += 2) {
+      ioopm_hash_table_remove(ht, int_elem(i));
+    }
+
+    ioopm_memory_usage_t before = ioopm_hash_table_memory_usage(ht, NULL);
+    size_t released = ioopm_hash_table_shrink_to_fit(ht);
+    ioopm_memory_usage_t after = ioopm_hash_table_memory_usage(ht, NULL);
+
+    CU_ASSERT(released > 0);
+    CU_ASSERT_EQUAL(before.total - after.total, released);
+    CU_ASSERT_EQUAL(after.entries, before.entries);
+    CU_ASSERT_EQUAL(ioopm_hash_table_shrink_to_fit(ht), 0);
+
+    // Every table has its own empty head, so another table coming and going does not touch it
+    ioopm_hash_table_t *other = ioopm_hash_table_create(int_hash_function, int_eq_function, NULL);
+    CU_ASSERT(ioopm_hash_table_shrink_to_fit(other) > 0);
+    ioopm_hash_table_insert(other, int_elem(0), int_elem(0));
+    ioopm_hash_table_destroy(other);
+
+    // The table keeps working after shrinking
+    CU_ASSERT_EQUAL(ioopm_hash_table_size(ht), No_Buckets / 2);
+    CU_ASSERT(Unsuccessful(ioopm_hash_table_lookup(ht, int_elem(0))));
+    CU_ASSERT(Unsuccessful(ioopm_hash_table_remove(ht, int_elem(0))));
+    CU_ASSERT(Successful(ioopm_hash_table_lookup(ht, int_elem(1))));
+
+    ioopm_hash_table_t *snapshot = ioopm_hash_table_snapshot(ht);
+    ioopm_hash_table_insert(ht, int_elem(0), int_elem(0));
+    CU_ASSERT(Successful(ioopm_hash_table_lookup(ht, int_elem(0))));
+    CU_ASSERT(Unsuccessful(ioopm_hash_table_lookup(snapshot, int_elem(0))));
+    ioopm_hash_table_destroy(snapshot);
+
+    ioopm_hash_table_clear(ht);
+    CU_ASSERT_TRUE(ioopm_hash_table_is_empty(ht));
+    ioopm_hash_table_insert(ht, int_elem(2), int_elem(2));
+    CU_ASSERT(Successful(ioopm_hash_table_lookup(ht, int_elem(2))));
+
+    ioopm_hash_table_destroy(ht);
+}
+
+
+void test_bloom_filter_lookup() {
+    ioopm_hash_table_t *ht = ioopm_hash_table_create(int_hash_function, counting_eq_function, NULL);
+
+    for (int i = 0; i < 10000; ++i) {
+      ioopm_hash_table_insert(ht, int_elem(i), int_elem(i));
+    }
+    CU_ASSERT_TRUE(ioopm_hash_table_attach_bloom_filter(ht, 20000));
+
+    // Keys inserted before and after attaching are all found
+    ioopm_hash_table_insert(ht, int_elem(-1), int_elem(-1));
+    for (int i = -1; i < 10000; ++i) {
+      CU_ASSERT(Successful(ioopm_hash_table_lookup(ht, int_elem(i))));
+    }
+
+    // Almost all misses are answered without comparing any keys
+    key_comparisons = 0;
+    for (int i = 10000; i < 20000; ++i) {
+      CU_ASSERT(Unsuccessful(ioopm_hash_table_lookup(ht, int_elem(i))));
+      CU_ASSERT_FALSE(ioopm_hash_table_has_key(ht, int_elem(i)));
+    }
+    CU_ASSERT(key_comparisons < 20000 / 10);
+
+    ioopm_hash_table_destroy(ht);
+}
+
+void test_bloom_filter_remove_rebuild() {
+    ioopm_hash_table_t *ht = ioopm_hash_table_create(int_hash_function, counting_eq_function, NULL);
+
+    CU_ASSERT_FALSE(ioopm_hash_table_rebuild_bloom_filter(ht));
+    CU_ASSERT_TRUE(ioopm_hash_table_attach_bloom_filter(ht, 1000));
+
+    for (int i = 0; i < 1000; ++i) {
+      ioopm_hash_table_insert(ht, int_elem(i), int_elem(i));
+    }
+    for (int i = 0; i < 1000; ++i) {
+      CU_ASSERT(Successful(ioopm_hash_table_remove(ht, int_elem(i))));
+    }
+    CU_ASSERT(Unsuccessful(ioopm_hash_table_lookup(ht, int_elem(5))));
+
+    // After a rebuild the removed keys no longer reach the buckets
+    CU_ASSERT_TRUE(ioopm_hash_table_rebuild_bloom_filter(ht));
+    ioopm_hash_table_insert(ht, int_elem(No_Buckets), int_elem(0));
+    key_comparisons = 0;
+    for (int i = 0; i < 1000; ++i) {
+      CU_ASSERT_FALSE(ioopm_hash_table_has_key(ht, int_elem(i)));
+    }
+    CU_ASSERT(key_comparisons < 1000 / 10);
+    CU_ASSERT_TRUE(ioopm_hash_table_has_key(ht, int_elem(No_Buckets)));
+
+    ioopm_memory_usage_t usage = ioopm_hash_table_memory_usage(ht, NULL);
+    CU_ASSERT(usage.bloom_filter > 0);
+
+    ioopm_hash_table_clear(ht);
+    CU_ASSERT_FALSE(ioopm_hash_table_has_key(ht, int_elem(No_Buckets)));
+
+    ioopm_hash_table_detach_bloom_filter(ht);
+    ioopm_hash_table_insert(ht, int_elem(3), int_elem(3));
+    CU_ASSERT_TRUE(ioopm_hash_table_has_key(ht, int_elem(3)));
+
+    ioopm_hash_table_destroy(ht);
+}
+
+
+void test_clear_and_reuse() {
+    ioopm_hash_table_t *ht = ioopm_hash_table_create(int_hash_function, int_eq_function, int_eq_function);
+
+    for (int round = 0; round < 100; ++round) {
+      for (int i = 0; i < 5; ++i) {
+        ioopm_hash_table_insert(ht, int_elem(round * 64 + i * No_Buckets), int_elem(round));
+      }
+      // Empty one bucket again through remove
+      ioopm_hash_table_remove(ht, int_elem(round * 64 + 4 * No_Buckets));
+
+      ioopm_list_t *keys = ioopm_hash_table_keys(ht);
+      size_t no_keys = 0;
+      ioopm_linked_list_size(keys, &no_keys);
+      CU_ASSERT_EQUAL(no_keys, 4);
+      ioopm_linked_list_destroy(keys);
+
+      CU_ASSERT_TRUE(ioopm_hash_table_has_value(ht, int_elem(round)));
+
+      ioopm_hash_table_clear(ht);
+      CU_ASSERT_TRUE(ioopm_hash_table_is_empty(ht));
+      CU_ASSERT(Unsuccessful(ioopm_hash_table_lookup(ht, int_elem(round * 64))));
+    }
+
+    ioopm_list_t *values = ioopm_hash_table_values(ht);
+    bool empty = false;
+    ioopm_linked_list_is_empty(values, &empty);
+    CU_ASSERT_TRUE(empty);
+    ioopm_linked_list_destroy(values);
+
+    ioopm_hash_table_destroy(ht);
+}
+
+
+void test_counter_table_increment() {
+    ioopm_hash_table_t *ht = ioopm_counter_table_create(int_hash_function, int_eq_function, NULL);
+
+    CU_ASSERT_EQUAL(ioopm_counter_table_increment(ht, int_elem(1), 1), 1);
+    CU_ASSERT_EQUAL(ioopm_counter_table_increment(ht, int_elem(1), 1), 2);
+    CU_ASSERT_EQUAL(ioopm_counter_table_increment(ht, int_elem(1 + No_Buckets), 5), 5);
+
+    // Counters are 64 bits wide
+    CU_ASSERT_EQUAL(ioopm_counter_table_increment(ht, int_elem(1), 1ULL << 40), (1ULL << 40) + 2);
+    CU_ASSERT_EQUAL(ioopm_hash_table_size(ht), 2);
+
+    option_t counter = ioopm_hash_table_lookup(ht, int_elem(1 + No_Buckets));
+    CU_ASSERT(Successful(counter));
+    CU_ASSERT_EQUAL(counter.value.uint64Value, 5);
+    CU_ASSERT_TRUE(ioopm_hash_table_has_value(ht, (elem_t){.uint64Value = 5}));
+
+    CU_ASSERT_EQUAL(ioopm_counter_table_increment(NULL, int_elem(1), 1), 0);
+
+    ioopm_hash_table_destroy(ht);
+}
+
+void test_counter_table_copies_keys() {
+    ioopm_hash_table_t *ht = ioopm_counter_table_create(string_hash_function, string_eq_function, string_copy_function);
+    char buf[16];
+
+    for (int i = 0; i < 10; ++i) {
+      // The table must not keep pointers into the caller's buffer
+      strcpy(buf, i % 2 == 0 ? "even" : "odd");
+      ioopm_counter_table_increment(ht, ptr_elem(buf), 1);
+    }
+    strcpy(buf, "neither");
+
+    CU_ASSERT_EQUAL(ioopm_hash_table_size(ht), 2);
+    CU_ASSERT_EQUAL(ioopm_hash_table_lookup(ht, ptr_elem("even")).value.uint64Value, 5);
+    CU_ASSERT_EQUAL(ioopm_hash_table_lookup(ht, ptr_elem("odd")).value.uint64Value, 5);
+
+    ioopm_hash_table_apply_to_all(ht, free_key, NULL);
+    ioopm_hash_table_destroy(ht);
+}
+
+
 /*
  * =========================================
  * SECTION: Main
@@ -641,6 +1052,18 @@ int main() {
     (CU_add_test(my_test_suite, "Hash table with some KV:s - All - All match", test_hash_table_all_all_match) == NULL) ||
     (CU_add_test(my_test_suite, "Hash table with some KV:s - apply_all - Applied to all", test_apply_to_all_modify_values) == NULL) ||
     (CU_add_test(my_test_suite, "Hash table with none KV:s - apply_all - Applied to all", test_apply_to_all_empty_table) == NULL) ||
+    (CU_add_test(my_test_suite, "Merge two tables with the same layout", test_merge_same_layout) == NULL) ||
+    (CU_add_test(my_test_suite, "Merge two tables with different hash functions", test_merge_different_layout) == NULL) ||
+    (CU_add_test(my_test_suite, "Snapshot is isolated from the live table", test_snapshot_isolation) == NULL) ||
+    (CU_add_test(my_test_suite, "Snapshot survives apply_to_all on the live table", test_snapshot_apply_to_all) == NULL) ||
+    (CU_add_test(my_test_suite, "Memory usage breakdown", test_memory_usage) == NULL) ||
+    (CU_add_test(my_test_suite, "Memory usage of owned keys", test_memory_usage_owned_keys) == NULL) ||
+    (CU_add_test(my_test_suite, "Shrink to fit after removes", test_shrink_to_fit) == NULL) ||
+    (CU_add_test(my_test_suite, "Bloom filter answers misses without probing", test_bloom_filter_lookup) == NULL) ||
+    (CU_add_test(my_test_suite, "Bloom filter after removes and rebuild", test_bloom_filter_remove_rebuild) == NULL) ||
+    (CU_add_test(my_test_suite, "Clear and reuse a table in a loop", test_clear_and_reuse) == NULL) ||
+    (CU_add_test(my_test_suite, "Counter table increments in place", test_counter_table_increment) == NULL) ||
+    (CU_add_test(my_test_suite, "Counter table copies new keys", test_counter_table_copies_keys) == NULL) ||
     0
   )
     {
@@ -0,0 +1,237 @@
+// hyperloglog.c
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "hyperloglog.h"
+
+/// Initial number of entries in the sparse array.
+#define Sparse_Initial_Capacity 16
+
+/// A sparse entry packs the register index above its 8-bit value.
+#define Sparse_Entry(index, rank) ((uint32_t)(index) << 8 | (rank))
+#define Sparse_Index(entry) ((entry) >> 8)
+#define Sparse_Rank(entry) ((uint8_t)((entry) & 0xff))
+
+/*
+ * =========================================
+ * SECTION: Custom Data Types And Aliases
+ * =========================================
+ */
+
+/// Exactly one of sparse and registers is in use: registers is NULL while the sketch is sparse.
+struct hyperloglog
+{
+  uint8_t precision;
+  ioopm_hash_function hash_func;
+  uint8_t *registers;
+  uint32_t *sparse;                   /// Sorted by register index, one entry per non-zero register.
+  size_t sparse_size;
+  size_t sparse_capacity;
+};
+
+
+/*
+ * =========================================
+ * SECTION: Function Definitions
+ * =========================================
+ */
+
+/// @brief Returns the number of registers of a sketch.
+static size_t no_registers(ioopm_hll_t *hll){
+  return (size_t)1 << hll->precision;
+}
+
+/// @brief Raises a register of a dense sketch.
+/// @param hll The sketch.
+/// @param index The register.
+/// @param rank The new value, kept only if larger than the current one.
+static void dense_update(ioopm_hll_t *hll, uint32_t index, uint8_t rank){
+  if(hll->registers[index] < rank) hll->registers[index] = rank;
+}
+
+/// @brief Replaces the sparse array with the dense registers.
+/// @param hll The sketch, which must be sparse.
+/// @return true on success, false if memory allocation fails.
+static bool convert_to_dense(ioopm_hll_t *hll){
+  uint8_t *registers = calloc(no_registers(hll), sizeof(uint8_t));
+  if(!registers) return false;
+
+  for(size_t i = 0; i < hll->sparse_size; ++i){
+    registers[Sparse_Index(hll->sparse[i])] = Sparse_Rank(hll->sparse[i]);
+  }
+
+  free(hll->sparse);
+  hll->sparse = NULL;
+  hll->sparse_size = hll->sparse_capacity = 0;
+  hll->registers = registers;
+
+  return true;
+}
+
+/// @brief Raises a register of a sparse sketch, converting it to dense when the array gets too large.
+/// @param hll The sketch.
+/// @param index The register.
+/// @param rank The new value, kept only if larger than the current one.
+/// @return true on success, false if memory allocation fails.
+static bool sparse_update(ioopm_hll_t *hll, uint32_t index, uint8_t rank){
+  // Binary search for the first entry with an index >= index
+  size_t low = 0;
+  size_t high = hll->sparse_size;
+  while(low < high){
+    size_t middle = low + (high - low) / 2;
+    if(Sparse_Index(hll->sparse[middle]) < index) low = middle + 1;
+    else high = middle;
+  }
+
+  if(low < hll->sparse_size && Sparse_Index(hll->sparse[low]) == index){
+    if(Sparse_Rank(hll->sparse[low]) < rank) hll->sparse[low] = Sparse_Entry(index, rank);
+    return true;
+  }
+
+  if(hll->sparse_size == hll->sparse_capacity){
+    // A dense sketch takes one byte per register, so beyond m / 4 entries sparse stops paying off
+    size_t capacity = hll->sparse_capacity * 2;
+    if(capacity > no_registers(hll) / sizeof(uint32_t)){
+      if(!convert_to_dense(hll)) return false;
+      dense_update(hll, index, rank);
+      return true;
+    }
+
+    uint32_t *sparse = realloc(hll->sparse, capacity * sizeof(uint32_t));
+    if(!sparse) return false;
+    hll->sparse = sparse;
+    hll->sparse_capacity = capacity;
+  }
+
+  memmove(&hll->sparse[low + 1], &hll->sparse[low], (hll->sparse_size - low) * sizeof(uint32_t));
+  hll->sparse[low] = Sparse_Entry(index, rank);
+  hll->sparse_size++;
+
+  return true;
+}
+
+/// @brief Raises a register in whichever representation the sketch uses.
+static bool register_update(ioopm_hll_t *hll, uint32_t index, uint8_t rank){
+  if(hll->registers){
+    dense_update(hll, index, rank);
+    return true;
+  }
+  return sparse_update(hll, index, rank);
+}
+
+
+ioopm_hll_t *ioopm_hll_create(uint8_t precision, ioopm_hash_function hash_func){
+  if(precision < Hll_Min_Precision || precision > Hll_Max_Precision || !hash_func) return NULL;
+
+  ioopm_hll_t *hll = calloc(1, sizeof(ioopm_hll_t));
+  if(!hll) return NULL;
+
+  hll->precision = precision;
+  hll->hash_func = hash_func;
+
+  // The smallest precisions have no room for a sparse array that is smaller than the registers
+  hll->sparse_capacity = Sparse_Initial_Capacity;
+  if(hll->sparse_capacity > no_registers(hll) / sizeof(uint32_t)){
+    hll->sparse_capacity = 0;
+    hll->registers = calloc(no_registers(hll), sizeof(uint8_t));
+  }
+  else{
+    hll->sparse = calloc(hll->sparse_capacity, sizeof(uint32_t));
+  }
+
+  if(!hll->registers && !hll->sparse){
+    free(hll);
+    return NULL;
+  }
+
+  return hll;
+}
+
+void ioopm_hll_destroy(ioopm_hll_t *hll){
+  if(!hll) return;
+
+  free(hll->registers);
+  free(hll->sparse);
+  free(hll);
+}
+
+bool ioopm_hll_add(ioopm_hll_t *hll, elem_t key){
+  if(!hll) return false;
+
+  // The top precision bits pick the register, the rank is the position of the first 1 in the rest
+  uint64_t hash = ioopm_mix_hash(hll->hash_func(key));
+  uint32_t index = (uint32_t)(hash >> (64 - hll->precision));
+  uint64_t rest = hash << hll->precision;
+  uint8_t rank = rest ? (uint8_t)(__builtin_clzll(rest) + 1) : (uint8_t)(64 - hll->precision + 1);
+
+  return register_update(hll, index, rank);
+}
+
+uint64_t ioopm_hll_estimate(ioopm_hll_t *hll){
+  if(!hll) return 0;
+
+  double m = (double)no_registers(hll);
+
+  if(!hll->registers){
+    // Linear counting is the most accurate estimator while few registers are set
+    if(hll->sparse_size == 0) return 0;
+    return (uint64_t)(m * log(m / (m - hll->sparse_size)) + 0.5);
+  }
+
+  double sum = 0;
+  size_t zeros = 0;
+  for(size_t i = 0; i < no_registers(hll); ++i){
+    sum += ldexp(1.0, -hll->registers[i]);
+    if(hll->registers[i] == 0) zeros++;
+  }
+
+  double alpha;
+  switch(hll->precision){
+    case 4: alpha = 0.673; break;
+    case 5: alpha = 0.697; break;
+    case 6: alpha = 0.709; break;
+    default: alpha = 0.7213 / (1 + 1.079 / m);
+  }
+
+  double estimate = alpha * m * m / sum;
+  if(estimate <= 2.5 * m && zeros > 0){
+    estimate = m * log(m / zeros);
+  }
+
+  return (uint64_t)(estimate + 0.5);
+}
+
+bool ioopm_hll_merge(ioopm_hll_t *dst, ioopm_hll_t *src){
+  if(!dst || !src) return false;
+  if(dst->precision != src->precision || dst->hash_func != src->hash_func) return false;
+
+  if(src->registers){
+    if(!dst->registers && !convert_to_dense(dst)) return false;
+    for(size_t i = 0; i < no_registers(dst); ++i){
+      dense_update(dst, (uint32_t)i, src->registers[i]);
+    }
+    return true;
+  }
+
+  for(size_t i = 0; i < src->sparse_size; ++i){
+    if(!register_update(dst, Sparse_Index(src->sparse[i]), Sparse_Rank(src->sparse[i]))) return false;
+  }
+
+  return true;
+}
+
+uint8_t ioopm_hll_precision(ioopm_hll_t *hll){
+  return hll ? hll->precision : 0;
+}
+
+bool ioopm_hll_is_sparse(ioopm_hll_t *hll){
+  return hll && !hll->registers;
+}
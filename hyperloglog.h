@@ -0,0 +1,92 @@
+// hyperloglog.h
+
+#ifndef HYPERLOGLOG_H
+#define HYPERLOGLOG_H
+
+/**
+ * @file hyperloglog.h
+ * @brief HyperLogLog estimator for the number of distinct keys in a stream.
+ *
+ * A sketch of precision p has m = 2^p registers of one byte each, and its
+ * estimates have a standard error of about 1.04 / sqrt(m) (0.8 % for p = 14)
+ * no matter how many keys are added. While few registers are set, the sketch
+ * stores them in a sorted sparse array instead, which uses far less memory
+ * and is estimated with linear counting, the most accurate estimator while
+ * most registers are zero (it is still an estimate: keys that share a
+ * register are counted once). The sketch switches to the dense array once
+ * the sparse one would be a quarter of its size. Sketches with the same
+ * precision and hash function can be merged, e.g. to combine workers.
+ */
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hash_table.h"
+
+/// Supported range of precisions (16 to 262144 registers).
+#define Hll_Min_Precision 4
+#define Hll_Max_Precision 18
+
+/*
+ * =========================================
+ * SECTION: Custom Data Types And Aliases
+ * =========================================
+ */
+
+typedef struct hyperloglog ioopm_hll_t;
+
+
+/*
+ * =========================================
+ * SECTION: Function Declarations
+ * =========================================
+ */
+
+/// @brief Create a new, empty sketch.
+/// @param precision Number of index bits p, between Hll_Min_Precision and Hll_Max_Precision.
+/// @param hash_func Function used to hash keys (the result is mixed before use).
+/// @return A new sketch, or NULL if an argument is invalid or memory allocation fails.
+ioopm_hll_t *ioopm_hll_create(uint8_t precision, ioopm_hash_function hash_func);
+
+/// @brief Delete a sketch and free its memory.
+/// @param hll The sketch to delete.
+void ioopm_hll_destroy(ioopm_hll_t *hll);
+
+/// @brief Add a key to the sketch; adding the same key again has no effect.
+/// @param hll The sketch operated upon.
+/// @param key The key to add.
+/// @return true on success, false if memory allocation fails.
+bool ioopm_hll_add(ioopm_hll_t *hll, elem_t key);
+
+/// @brief Estimate the number of distinct keys added.
+/// @param hll The sketch operated upon.
+/// @return The estimated cardinality.
+uint64_t ioopm_hll_estimate(ioopm_hll_t *hll);
+
+/// @brief Add all keys of src into dst, so dst estimates the size of the union.
+/// @param dst The sketch that receives the keys.
+/// @param src The sketch to add; left unchanged.
+/// @return true on success, false if the sketches differ in precision or hash function,
+///         or memory allocation fails.
+bool ioopm_hll_merge(ioopm_hll_t *dst, ioopm_hll_t *src);
+
+/// @brief Returns the precision of the sketch.
+/// @param hll The sketch operated upon.
+/// @return The number of index bits.
+uint8_t ioopm_hll_precision(ioopm_hll_t *hll);
+
+/// @brief Checks if the sketch still uses the sparse representation.
+/// @param hll The sketch operated upon.
+/// @return true if sparse, false if dense.
+bool ioopm_hll_is_sparse(ioopm_hll_t *hll);
+
+
+
+#endif // HYPERLOGLOG_H
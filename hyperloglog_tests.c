@@ -0,0 +1,214 @@
+// hyperloglog_tests.c
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include <CUnit/Basic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hyperloglog.h"
+
+/// @brief Number of distinct keys used in the accuracy tests.
+#define NUM_KEYS 10000
+
+
+/*
+ * =========================================
+ * SECTION: Private Function Definitions
+ * =========================================
+ */
+
+/// @brief Hash function for integer keys.
+/// @param key The key to hash.
+/// @return The hash value.
+static size_t int_hash_function(elem_t key) {
+    return (size_t)key.intValue;
+}
+
+/// @brief Checks that an estimate is within a relative error of the true cardinality.
+/// @param estimate The estimate.
+/// @param expected The true cardinality.
+/// @param tolerance The allowed relative error.
+/// @return true if within tolerance.
+static bool close_to(uint64_t estimate, uint64_t expected, double tolerance) {
+  double difference = (double)estimate - (double)expected;
+  if (difference < 0) difference = -difference;
+  return difference <= tolerance * expected;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Initialize and clean the suite
+ * =========================================
+ */
+
+int init_suite(void) {
+  return 0;
+}
+
+int clean_suite(void) {
+  return 0;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Tests
+ * =========================================
+ */
+
+void test_create_destroy() {
+  ioopm_hll_t *hll = ioopm_hll_create(14, int_hash_function);
+  CU_ASSERT_PTR_NOT_NULL(hll);
+  CU_ASSERT_EQUAL(ioopm_hll_precision(hll), 14);
+  CU_ASSERT_TRUE(ioopm_hll_is_sparse(hll));
+  CU_ASSERT_EQUAL(ioopm_hll_estimate(hll), 0);
+  ioopm_hll_destroy(hll);
+
+  // Too few registers for a sparse array to be worth it
+  hll = ioopm_hll_create(Hll_Min_Precision, int_hash_function);
+  CU_ASSERT_FALSE(ioopm_hll_is_sparse(hll));
+  CU_ASSERT_EQUAL(ioopm_hll_estimate(hll), 0);
+  ioopm_hll_destroy(hll);
+
+  CU_ASSERT_PTR_NULL(ioopm_hll_create(Hll_Min_Precision - 1, int_hash_function));
+  CU_ASSERT_PTR_NULL(ioopm_hll_create(Hll_Max_Precision + 1, int_hash_function));
+  CU_ASSERT_PTR_NULL(ioopm_hll_create(14, NULL));
+}
+
+void test_small_cardinalities_are_sparse() {
+  ioopm_hll_t *hll = ioopm_hll_create(14, int_hash_function);
+
+  for (int i = 0; i < 100; ++i) {
+    CU_ASSERT_TRUE(ioopm_hll_add(hll, int_elem(i)));
+    CU_ASSERT_TRUE(ioopm_hll_add(hll, int_elem(i)));
+  }
+  CU_ASSERT_TRUE(ioopm_hll_is_sparse(hll));
+  CU_ASSERT(close_to(ioopm_hll_estimate(hll), 100, 0.02));
+
+  ioopm_hll_destroy(hll);
+}
+
+void test_large_cardinalities_are_dense() {
+  ioopm_hll_t *hll = ioopm_hll_create(14, int_hash_function);
+
+  for (int i = 0; i < NUM_KEYS; ++i) {
+    ioopm_hll_add(hll, int_elem(i));
+  }
+  CU_ASSERT_FALSE(ioopm_hll_is_sparse(hll));
+  CU_ASSERT(close_to(ioopm_hll_estimate(hll), NUM_KEYS, 0.03));
+
+  // Duplicates do not change the estimate
+  uint64_t estimate = ioopm_hll_estimate(hll);
+  for (int i = 0; i < NUM_KEYS; ++i) {
+    ioopm_hll_add(hll, int_elem(i));
+  }
+  CU_ASSERT_EQUAL(ioopm_hll_estimate(hll), estimate);
+
+  for (int i = NUM_KEYS; i < 100 * NUM_KEYS; ++i) {
+    ioopm_hll_add(hll, int_elem(i));
+  }
+  CU_ASSERT(close_to(ioopm_hll_estimate(hll), 100 * NUM_KEYS, 0.03));
+
+  ioopm_hll_destroy(hll);
+}
+
+void test_merge() {
+  ioopm_hll_t *sparse = ioopm_hll_create(12, int_hash_function);
+  ioopm_hll_t *dense = ioopm_hll_create(12, int_hash_function);
+  ioopm_hll_t *other = ioopm_hll_create(10, int_hash_function);
+
+  // Overlapping ranges [0, 500) and [250, NUM_KEYS)
+  for (int i = 0; i < 500; ++i) {
+    ioopm_hll_add(sparse, int_elem(i));
+  }
+  for (int i = 250; i < NUM_KEYS; ++i) {
+    ioopm_hll_add(dense, int_elem(i));
+  }
+  CU_ASSERT_TRUE(ioopm_hll_is_sparse(sparse));
+  CU_ASSERT_FALSE(ioopm_hll_is_sparse(dense));
+
+  uint64_t sparse_estimate = ioopm_hll_estimate(sparse);
+  CU_ASSERT_TRUE(ioopm_hll_merge(dense, sparse));
+  CU_ASSERT(close_to(ioopm_hll_estimate(dense), NUM_KEYS, 0.05));
+  CU_ASSERT_EQUAL(ioopm_hll_estimate(sparse), sparse_estimate);
+
+  // Merging dense into sparse converts the destination
+  CU_ASSERT_TRUE(ioopm_hll_merge(sparse, dense));
+  CU_ASSERT_FALSE(ioopm_hll_is_sparse(sparse));
+  CU_ASSERT_EQUAL(ioopm_hll_estimate(sparse), ioopm_hll_estimate(dense));
+
+  CU_ASSERT_FALSE(ioopm_hll_merge(dense, other));
+
+  ioopm_hll_destroy(sparse);
+  ioopm_hll_destroy(dense);
+  ioopm_hll_destroy(other);
+}
+
+void test_merge_sparse() {
+  ioopm_hll_t *a = ioopm_hll_create(14, int_hash_function);
+  ioopm_hll_t *b = ioopm_hll_create(14, int_hash_function);
+
+  for (int i = 0; i < 60; ++i) {
+    ioopm_hll_add(a, int_elem(i));
+    ioopm_hll_add(b, int_elem(i + 30));
+  }
+
+  CU_ASSERT_TRUE(ioopm_hll_merge(a, b));
+  CU_ASSERT_TRUE(ioopm_hll_is_sparse(a));
+  CU_ASSERT(close_to(ioopm_hll_estimate(a), 90, 0.02));
+
+  ioopm_hll_destroy(a);
+  ioopm_hll_destroy(b);
+}
+
+
+/*
+ * =========================================
+ * SECTION: Main
+ * =========================================
+ */
+
+int main() {
+  // First we try to set up CUnit, and exit if we fail
+  if (CU_initialize_registry() != CUE_SUCCESS)
+    return CU_get_error();
+
+  // We then create an empty test suite and specify the name and
+  // the init and cleanup functions
+  CU_pSuite my_test_suite = CU_add_suite("Unit tests for hyperloglog", init_suite, clean_suite);
+  if (my_test_suite == NULL) {
+      // If the test suite could not be added, tear down CUnit and exit
+      CU_cleanup_registry();
+      return CU_get_error();
+  }
+
+  if (
+    (CU_add_test(my_test_suite, "Create and destroy sketch", test_create_destroy) == NULL) ||
+    (CU_add_test(my_test_suite, "Small cardinalities stay sparse and exact", test_small_cardinalities_are_sparse) == NULL) ||
+    (CU_add_test(my_test_suite, "Large cardinalities are estimated from dense registers", test_large_cardinalities_are_dense) == NULL) ||
+    (CU_add_test(my_test_suite, "Merge sparse and dense sketches", test_merge) == NULL) ||
+    (CU_add_test(my_test_suite, "Merge two sparse sketches", test_merge_sparse) == NULL) ||
+    0
+  )
+    {
+      // If adding any of the tests fails, we tear down CUnit and exit
+      CU_cleanup_registry();
+      return CU_get_error();
+    }
+
+  // Set the running mode. Use CU_BRM_VERBOSE for maximum output.
+  // Use CU_BRM_NORMAL to only print errors and a summary
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+
+  // This is where the tests are actually run!
+  CU_basic_run_tests();
+
+  // Tear down CUnit before exiting
+  CU_cleanup_registry();
+  return CU_get_error();
+}
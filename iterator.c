@@ -8,7 +8,9 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "linked_list.h"
+#include "linked_list_internal.h"
 #include "iterator.h"
 
 
@@ -19,13 +21,234 @@
  */
 
 /// @brief Struct representing an iterator over a linked list.
+/// @note Over an unrolled list the current element is chunk->data[offset]. At the end of
+///       the list chunk stays on the last chunk with offset == chunk->count. Over an array,
+///       skip or deque list offset is the index of the current element, and over a skip list
+///       skip is its node, or NULL until it is needed after the iterator jumped.
+/// @note While trail_valid, trail holds every node before current (so its top is previous), or
+///       every chunk before chunk, in list order. It lets previous step back without a walk, and
+///       is only built by the first step back, so iterators that only go forwards do not keep it.
 struct list_iterator{
     ioopm_list_t *list;
     node_t *current;
     node_t *previous;
+    chunk_t *chunk;
+    size_t offset;
+    skip_node_t *skip;
+    void **trail;
+    size_t trail_size;
+    size_t trail_capacity;
+    bool trail_valid;
 };
 
 
+/*
+ * =========================================
+ * SECTION: Trail
+ * =========================================
+ */
+
+/// @brief Records a node or chunk that the iterator has moved past.
+/// @param iter The iterator.
+/// @param passed The node or chunk, which is now the last one before the iterator.
+/// @note If memory runs out the trail is dropped, and rebuilt by the next step back.
+static void trail_push(ioopm_list_iterator_t *iter, void *passed){
+    if(!iter->trail_valid) return;
+
+    if(iter->trail_size == iter->trail_capacity){
+        size_t capacity = iter->trail_capacity ? iter->trail_capacity * 2 : 16;
+        void **trail = realloc(iter->trail, capacity * sizeof(void *));
+        if(!trail){
+            iter->trail_valid = false;
+            return;
+        }
+        iter->trail = trail;
+        iter->trail_capacity = capacity;
+    }
+
+    iter->trail[iter->trail_size++] = passed;
+}
+
+/// @brief Drops the trail, which the next step back then builds again.
+static void trail_drop(ioopm_list_iterator_t *iter){
+    free(iter->trail);
+    iter->trail = NULL;
+    iter->trail_size = 0;
+    iter->trail_capacity = 0;
+    iter->trail_valid = false;
+}
+
+/// @brief Collects the nodes or chunks before the iterator by walking from the head.
+/// @param iter The iterator, over a node or unrolled list.
+/// @return true if the trail is valid afterwards, false if memory ran out.
+static bool trail_rebuild(ioopm_list_iterator_t *iter){
+    iter->trail_size = 0;
+    iter->trail_valid = true;
+
+    if(iter->list->storage == IOOPM_LIST_UNROLLED){
+        for(chunk_t *chunk = iter->list->first_chunk; chunk != iter->chunk; chunk = chunk->next){
+            trail_push(iter, chunk);
+        }
+    }
+    else{
+        for(node_t *node = iter->list->head; node != iter->current; node = node->next){
+            trail_push(iter, node);
+        }
+    }
+
+    return iter->trail_valid;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Indexed Storage
+ * =========================================
+ */
+
+/// @brief Checks if an iterator walks its list by index (array, skip and deque lists).
+static bool by_index(ioopm_list_iterator_t *iter){
+    return iter->list->storage == IOOPM_LIST_ARRAY || iter->list->storage == IOOPM_LIST_SKIP ||
+           iter->list->storage == IOOPM_LIST_DEQUE;
+}
+
+
+/// @brief Checks if an iterator walks a skip list, whose level-0 links it follows.
+static bool by_skip_node(ioopm_list_iterator_t *iter){
+    return iter->list->storage == IOOPM_LIST_SKIP;
+}
+
+/// @brief Returns the node of the current element of an iterator over a skip list.
+/// @param iter The iterator, pointing at an element.
+/// @return The node, found from the head in O(log n) only if the iterator does not know it.
+static skip_node_t *skip_current(ioopm_list_iterator_t *iter){
+    if(!iter->skip) iter->skip = ioopm_linked_list_skip_node_at(iter->list, iter->offset);
+    return iter->skip;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Unrolled Storage
+ * =========================================
+ */
+
+/// @brief Checks if an iterator over an unrolled list points at an element.
+static bool chunk_has_current(ioopm_list_iterator_t *iter){
+    return iter->chunk && iter->offset < iter->chunk->count;
+}
+
+/// @brief Steps to the next chunk once the iterator has passed the last element of its chunk.
+static void chunk_settle(ioopm_list_iterator_t *iter){
+    if(iter->offset == iter->chunk->count && iter->chunk->next){
+        trail_push(iter, iter->chunk);
+        iter->chunk = iter->chunk->next;
+        iter->offset = 0;
+    }
+}
+
+/// @brief Removes the current element of an iterator over an unrolled list.
+/// @param iter The iterator, pointing at an element.
+/// @return The removed element.
+static elem_t chunk_remove(ioopm_list_iterator_t *iter){
+    ioopm_list_t *list = iter->list;
+    chunk_t *chunk = iter->chunk;
+
+    elem_t value = chunk->data[iter->offset];
+    chunk->count--;
+    memmove(chunk->data + iter->offset, chunk->data + iter->offset + 1, (chunk->count - iter->offset) * sizeof(elem_t));
+    list->size--;
+    ioopm_linked_list_index_remove(list, value);
+
+    chunk_t *next = chunk->next;
+    if(next && (chunk->count == 0 || (chunk->count < List_Chunk_Capacity / 2 && chunk->count + next->count <= List_Chunk_Capacity))){
+        // Pull the next chunk into this one, so no chunk before the iterator has to change
+        memcpy(chunk->data + chunk->count, next->data, next->count * sizeof(elem_t));
+        chunk->count += next->count;
+        chunk->next = next->next;
+        if(list->last_chunk == next) list->last_chunk = chunk;
+
+        free(next);
+    }
+    else if(chunk->count == 0){
+        // The last chunk became empty, which is the only case that needs the chunk before it
+        chunk_t *prev = NULL;
+        if(list->first_chunk != chunk){
+            if(iter->trail_valid){
+                prev = iter->trail[--iter->trail_size];
+            }
+            else{
+                prev = list->first_chunk;
+                while(prev->next != chunk){
+                    prev = prev->next;
+                }
+            }
+            prev->next = NULL;
+        }
+        else{
+            list->first_chunk = NULL;
+        }
+        list->last_chunk = prev;
+
+        free(chunk);
+        iter->chunk = prev;
+        iter->offset = prev ? prev->count : 0;
+        return value;
+    }
+
+    chunk_settle(iter);
+    return value;
+}
+
+/// @brief Inserts an element before the current element of an iterator over an unrolled list.
+/// @param iter The iterator; the new element becomes its current element.
+/// @param element The element to insert.
+/// @return IOOPM_SUCCESS on success, or IOOPM_ERROR_MEMORY_ALLOCATION.
+static ioopm_status_t chunk_insert(ioopm_list_iterator_t *iter, elem_t element){
+    ioopm_list_t *list = iter->list;
+
+    if(!iter->chunk){
+        chunk_t *new_chunk = calloc(1, sizeof(chunk_t));
+        CHECK_NULL(new_chunk, "Memory allocation failed for the new chunk.", IOOPM_ERROR_MEMORY_ALLOCATION);
+
+        list->first_chunk = new_chunk;
+        list->last_chunk = new_chunk;
+        iter->chunk = new_chunk;
+        iter->offset = 0;
+    }
+
+    chunk_t *chunk = iter->chunk;
+    if(chunk->count == List_Chunk_Capacity){
+        chunk_t *new_chunk = calloc(1, sizeof(chunk_t));
+        CHECK_NULL(new_chunk, "Memory allocation failed for the new chunk.", IOOPM_ERROR_MEMORY_ALLOCATION);
+
+        size_t half = List_Chunk_Capacity / 2;
+        new_chunk->count = List_Chunk_Capacity - half;
+        memcpy(new_chunk->data, chunk->data + half, new_chunk->count * sizeof(elem_t));
+        chunk->count = half;
+
+        new_chunk->next = chunk->next;
+        chunk->next = new_chunk;
+        if(list->last_chunk == chunk) list->last_chunk = new_chunk;
+
+        if(iter->offset > half){
+            trail_push(iter, chunk);
+            chunk = new_chunk;
+            iter->chunk = new_chunk;
+            iter->offset -= half;
+        }
+    }
+
+    memmove(chunk->data + iter->offset + 1, chunk->data + iter->offset, (chunk->count - iter->offset) * sizeof(elem_t));
+    chunk->data[iter->offset] = element;
+    chunk->count++;
+    list->size++;
+    ioopm_linked_list_index_add(list, element);
+
+    return IOOPM_SUCCESS;
+}
+
+
 /*
  * =========================================
  * SECTION: Function Definitions
@@ -41,6 +264,9 @@ ioopm_list_iterator_t *ioopm_iterator_create(ioopm_list_t *list){
     iter->list = list;
     iter->current = list->head;
     iter->previous = NULL;
+    iter->chunk = list->first_chunk;
+    iter->offset = 0;
+    trail_drop(iter);
 
     return iter;
 }
@@ -48,6 +274,7 @@ ioopm_list_iterator_t *ioopm_iterator_create(ioopm_list_t *list){
 void ioopm_iterator_destroy(ioopm_list_iterator_t *iter){
     if(!iter) return;
 
+    free(iter->trail);
     free(iter);
 }
 
@@ -55,7 +282,9 @@ ioopm_status_t ioopm_iterator_has_next(ioopm_list_iterator_t *iter, bool *result
     CHECK_NULL(iter, "The iterator is NULL, unable to operate on it", IOOPM_ERROR_NULL_ITERATOR);
     
     if(result){
-        *result = (iter->current != NULL);
+        if(by_index(iter)) *result = iter->offset < iter->list->size;
+        else if(iter->list->storage == IOOPM_LIST_UNROLLED) *result = chunk_has_current(iter);
+        else *result = (iter->current != NULL);
     }
 
     return IOOPM_SUCCESS;
@@ -63,6 +292,33 @@ ioopm_status_t ioopm_iterator_has_next(ioopm_list_iterator_t *iter, bool *result
 
 ioopm_status_t ioopm_iterator_next(ioopm_list_iterator_t *iter, elem_t *next){
     CHECK_NULL(iter, "The iterator is NULL, unable to operate on it", IOOPM_ERROR_NULL_ITERATOR);
+
+    if(by_index(iter)){
+        CHECK_NULL(iter->offset < iter->list->size, "The iterator has no more values to access", IOOPM_ERROR_INVALID_INDEX);
+        if(by_skip_node(iter)){
+            skip_node_t *node = skip_current(iter);
+            if(next){
+                *next = node->data;
+            }
+            iter->skip = node->links[0].next;
+        }
+        else{
+            ioopm_linked_list_get(iter->list, iter->offset, next);
+        }
+        iter->offset++;
+
+        return IOOPM_SUCCESS;
+    }
+    if(iter->list->storage == IOOPM_LIST_UNROLLED){
+        CHECK_NULL(chunk_has_current(iter), "The iterator has no more values to access", IOOPM_ERROR_INVALID_INDEX);
+        if(next){
+            *next = iter->chunk->data[iter->offset];
+        }
+        iter->offset++;
+        chunk_settle(iter);
+
+        return IOOPM_SUCCESS;
+    }
     CHECK_NULL(iter->current, "The iterator has no more values to access", IOOPM_ERROR_INVALID_INDEX);
 
     if(next){
@@ -71,15 +327,36 @@ ioopm_status_t ioopm_iterator_next(ioopm_list_iterator_t *iter, elem_t *next){
 
     iter->previous = iter->current;
     iter->current = iter->current->next;
+    trail_push(iter, iter->previous);
 
     return IOOPM_SUCCESS;
 }
 
 ioopm_status_t ioopm_iterator_remove(ioopm_list_iterator_t *iter, elem_t *removed){
     CHECK_NULL(iter, "The iterator is NULL, unable to operate on it", IOOPM_ERROR_NULL_ITERATOR);
+
+    if(by_index(iter)){
+        CHECK_NULL(iter->offset < iter->list->size, "The iterator has no more values to access", IOOPM_ERROR_INVALID_INDEX);
+        skip_node_t *following = by_skip_node(iter) ? skip_current(iter)->links[0].next : NULL;
+        ioopm_status_t status = ioopm_linked_list_remove(iter->list, iter->offset, removed);
+        if(status == IOOPM_SUCCESS) iter->skip = following;
+
+        return status;
+    }
+    if(iter->list->storage == IOOPM_LIST_UNROLLED){
+        CHECK_NULL(chunk_has_current(iter), "The iterator has no more values to access", IOOPM_ERROR_INVALID_INDEX);
+        ioopm_linked_list_forget_cursor(iter->list);
+        elem_t value = chunk_remove(iter);
+        if(removed){
+            *removed = value;
+        }
+
+        return IOOPM_SUCCESS;
+    }
     CHECK_NULL(iter->current, "The iterator has no more values to access", IOOPM_ERROR_INVALID_INDEX);
 
     node_t *to_remove = iter->current;
+    ioopm_linked_list_forget_cursor(iter->list);
 
     if(iter->previous){
         iter->previous->next = iter->current->next;
@@ -98,7 +375,8 @@ ioopm_status_t ioopm_iterator_remove(ioopm_list_iterator_t *iter, elem_t *remove
 
     iter->current = iter->current->next;
 
-    free(to_remove);
+    ioopm_linked_list_index_remove(iter->list, to_remove->data);
+    ioopm_linked_list_node_free(iter->list, to_remove);
     iter->list->size--;
 
     return IOOPM_SUCCESS;
@@ -109,10 +387,19 @@ ioopm_status_t ioopm_iterator_remove(ioopm_list_iterator_t *iter, elem_t *remove
 ioopm_status_t ioopm_iterator_insert(ioopm_list_iterator_t *iter, elem_t element){
     CHECK_NULL(iter, "The iterator is NULL, unable to operate on it.", IOOPM_ERROR_NULL_ITERATOR);
 
-    node_t *new_entry = calloc(1, sizeof(node_t));
+    if(by_index(iter)){
+        iter->skip = NULL;
+        return ioopm_linked_list_insert(iter->list, iter->offset, element);
+    }
+
+    ioopm_linked_list_forget_cursor(iter->list);
+    if(iter->list->storage == IOOPM_LIST_UNROLLED){
+        return chunk_insert(iter, element);
+    }
+
+    node_t *new_entry = ioopm_linked_list_node_alloc(iter->list, element);
     CHECK_NULL(new_entry, "Memory allocation failed for the new node.", IOOPM_ERROR_MEMORY_ALLOCATION);
 
-    new_entry->data = element;
     new_entry->next = iter->current;
 
     if(!(iter->previous)){
@@ -130,6 +417,7 @@ ioopm_status_t ioopm_iterator_insert(ioopm_list_iterator_t *iter, elem_t element
 
     iter->current = new_entry;
     iter->list->size++;
+    ioopm_linked_list_index_add(iter->list, element);
 
     return IOOPM_SUCCESS;
 }
@@ -139,12 +427,38 @@ ioopm_status_t ioopm_iterator_reset(ioopm_list_iterator_t *iter){
     
     iter->current = iter->list->head;
     iter->previous = NULL;
+    iter->chunk = iter->list->first_chunk;
+    iter->offset = 0;
+    iter->skip = NULL;
+    trail_drop(iter);
 
     return IOOPM_SUCCESS;
 }
 
 ioopm_status_t ioopm_iterator_current(ioopm_list_iterator_t *iter, elem_t *current){
     CHECK_NULL(iter, "The iterator is NULL, unable to retrieve current element", IOOPM_ERROR_NULL_ITERATOR);
+
+    if(by_index(iter)){
+        CHECK_NULL(iter->offset < iter->list->size, "Iterator is not pointing to a valid element (end of list or not started)", IOOPM_ERROR_INVALID_INDEX);
+        if(by_skip_node(iter)){
+            if(current){
+                *current = skip_current(iter)->data;
+            }
+        }
+        else{
+            ioopm_linked_list_get(iter->list, iter->offset, current);
+        }
+
+        return IOOPM_SUCCESS;
+    }
+    if(iter->list->storage == IOOPM_LIST_UNROLLED){
+        CHECK_NULL(chunk_has_current(iter), "Iterator is not pointing to a valid element (end of list or not started)", IOOPM_ERROR_INVALID_INDEX);
+        if(current){
+            *current = iter->chunk->data[iter->offset];
+        }
+
+        return IOOPM_SUCCESS;
+    }
     CHECK_NULL(iter->current, "Iterator is not pointing to a valid element (end of list or not started)", IOOPM_ERROR_INVALID_INDEX);
     
     if(current){
@@ -153,3 +467,93 @@ ioopm_status_t ioopm_iterator_current(ioopm_list_iterator_t *iter, elem_t *curre
 
     return IOOPM_SUCCESS;
 }
+
+ioopm_status_t ioopm_iterator_reset_to_end(ioopm_list_iterator_t *iter){
+    CHECK_NULL(iter, "The iterator is NULL, unable to reset it", IOOPM_ERROR_NULL_ITERATOR);
+
+    iter->current = NULL;
+    iter->previous = iter->list->tail;
+    iter->chunk = iter->list->last_chunk;
+    iter->offset = by_index(iter) ? iter->list->size : (iter->chunk ? iter->chunk->count : 0);
+    iter->skip = NULL;
+    trail_drop(iter);
+
+    return IOOPM_SUCCESS;
+}
+
+ioopm_status_t ioopm_iterator_has_previous(ioopm_list_iterator_t *iter, bool *result){
+    CHECK_NULL(iter, "The iterator is NULL, unable to operate on it", IOOPM_ERROR_NULL_ITERATOR);
+
+    if(result){
+        if(by_index(iter)) *result = iter->offset > 0;
+        else if(iter->list->storage == IOOPM_LIST_UNROLLED) *result = iter->chunk && (iter->offset > 0 || iter->chunk != iter->list->first_chunk);
+        else *result = (iter->previous != NULL);
+    }
+
+    return IOOPM_SUCCESS;
+}
+
+ioopm_status_t ioopm_iterator_previous(ioopm_list_iterator_t *iter, elem_t *previous){
+    CHECK_NULL(iter, "The iterator is NULL, unable to operate on it", IOOPM_ERROR_NULL_ITERATOR);
+
+    if(by_index(iter)){
+        CHECK_NULL(iter->offset > 0, "The iterator is at the start of the list", IOOPM_ERROR_INVALID_INDEX);
+        iter->offset--;
+        iter->skip = NULL;
+        ioopm_linked_list_get(iter->list, iter->offset, previous);
+
+        return IOOPM_SUCCESS;
+    }
+    if(iter->list->storage == IOOPM_LIST_UNROLLED){
+        CHECK_NULL(iter->chunk && (iter->offset > 0 || iter->chunk != iter->list->first_chunk),
+                   "The iterator is at the start of the list", IOOPM_ERROR_INVALID_INDEX);
+        if(iter->offset == 0){
+            // Chunks only link forwards, so the chunk before comes from the trail, or from
+            // a walk from the first chunk if the trail could not be built
+            chunk_t *prev;
+            if(iter->trail_valid || trail_rebuild(iter)){
+                prev = iter->trail[--iter->trail_size];
+            }
+            else{
+                prev = iter->list->first_chunk;
+                while(prev->next != iter->chunk){
+                    prev = prev->next;
+                }
+            }
+            iter->chunk = prev;
+            iter->offset = prev->count;
+        }
+        iter->offset--;
+        if(previous){
+            *previous = iter->chunk->data[iter->offset];
+        }
+
+        return IOOPM_SUCCESS;
+    }
+    CHECK_NULL(iter->previous, "The iterator is at the start of the list", IOOPM_ERROR_INVALID_INDEX);
+
+    if(previous){
+        *previous = iter->previous->data;
+    }
+
+    // Nodes only link forwards, so the node before comes from the trail, or from a walk
+    // from the head if the trail could not be built
+    if(iter->trail_valid || trail_rebuild(iter)){
+        iter->trail_size--;
+        iter->current = iter->previous;
+        iter->previous = iter->trail_size ? iter->trail[iter->trail_size - 1] : NULL;
+
+        return IOOPM_SUCCESS;
+    }
+
+    iter->current = iter->previous;
+    iter->previous = NULL;
+    if(iter->current != iter->list->head){
+        iter->previous = iter->list->head;
+        while(iter->previous->next != iter->current){
+            iter->previous = iter->previous->next;
+        }
+    }
+
+    return IOOPM_SUCCESS;
+}
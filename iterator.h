@@ -49,6 +49,8 @@ ioopm_status_t ioopm_iterator_has_next(ioopm_list_iterator_t *iter, bool *result
 /// @param iter The iterator.
 /// @param next Pointer to store the next value.
 /// @return IOOPM_SUCCESS on success, or an appropriate error code on failure.
+/// @note O(1) for every kind of list. Over a skip list the iterator follows the level-0 links,
+///       so only the first step after create, reset, insert or previous searches in O(log n).
 ioopm_status_t ioopm_iterator_next(ioopm_list_iterator_t *iter, elem_t *next);
 
 
@@ -76,6 +78,28 @@ ioopm_status_t ioopm_iterator_reset(ioopm_list_iterator_t *iter);
 /// @return IOOPM_SUCCESS on success, or an appropriate error code on failure.
 ioopm_status_t ioopm_iterator_current(ioopm_list_iterator_t *iter, elem_t *current);
 
+/// @brief Move the iterator past the last element, so that iterating backwards visits the whole list.
+/// @param iter The iterator.
+/// @return IOOPM_SUCCESS on success, or an appropriate error code on failure.
+ioopm_status_t ioopm_iterator_reset_to_end(ioopm_list_iterator_t *iter);
+
+/// @brief Check if there are elements before the current one.
+/// @param iter The iterator.
+/// @param result Pointer to store the result (true if an earlier element exists).
+/// @return IOOPM_SUCCESS on success, or an appropriate error code on failure.
+ioopm_status_t ioopm_iterator_has_previous(ioopm_list_iterator_t *iter, bool *result);
+
+/// @brief Move the iterator back to the previous element, which becomes the current element.
+/// @param iter The iterator.
+/// @param previous Pointer to store the previous value.
+/// @return IOOPM_SUCCESS on success, or an appropriate error code on failure.
+/// @note next and previous undo each other. O(1) for array and deque lists and O(log n) for skip
+///       lists. Node and unrolled lists only link forwards, so the first step back walks from the
+///       head once to collect the nodes (or chunks) before the iterator, and later steps back are
+///       O(1). That costs one pointer per node (or chunk) before the iterator, held until the
+///       iterator is reset or destroyed; an iterator that only moves forwards uses O(1) memory.
+ioopm_status_t ioopm_iterator_previous(ioopm_list_iterator_t *iter, elem_t *previous);
+
 
 
 
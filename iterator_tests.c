@@ -7,6 +7,8 @@
  */
 
 #include <CUnit/Basic.h>
+#include <stdlib.h>
+#include <string.h>
 #include "iterator.h"
 
 /*
@@ -25,6 +27,14 @@ static bool elem_eq(elem_t a, elem_t b) {
     return a.intValue == b.intValue;
 }
 
+/// @brief Hash function for integer elements.
+/// @param key The element.
+/// @return The integer value as a hash.
+static size_t int_hash(elem_t key){
+    return (size_t)key.uintValue;
+}
+
+
 /*
  * =========================================
  * SECTION: Initialize and clean the suite
@@ -267,6 +277,254 @@ void test_iter_reset(){
 //     ioopm_linked_list_destroy(list);
 // }
 
+/// @brief Checks that a list holds the same elements in the same order as a node list.
+static void assert_same_elements(ioopm_list_t *expected, ioopm_list_t *actual){
+    ioopm_list_iterator_t *expected_iter = ioopm_iterator_create(expected);
+    ioopm_list_iterator_t *actual_iter = ioopm_iterator_create(actual);
+    bool expected_more = false;
+    bool actual_more = false;
+
+    do{
+        ioopm_iterator_has_next(expected_iter, &expected_more);
+        ioopm_iterator_has_next(actual_iter, &actual_more);
+        CU_ASSERT_EQUAL(actual_more, expected_more);
+        if(!expected_more || !actual_more) break;
+
+        elem_t a, b;
+        ioopm_iterator_next(expected_iter, &a);
+        ioopm_iterator_next(actual_iter, &b);
+        CU_ASSERT_EQUAL(b.intValue, a.intValue);
+    } while(true);
+
+    ioopm_iterator_destroy(expected_iter);
+    ioopm_iterator_destroy(actual_iter);
+}
+
+void test_iter_unrolled(){
+    ioopm_list_t *list = ioopm_linked_list_create_with_storage(*elem_eq, IOOPM_LIST_UNROLLED);
+    ioopm_list_iterator_t *iter = ioopm_iterator_create(list);
+    elem_t current;
+    bool has_next = true;
+
+    CU_ASSERT_EQUAL(ioopm_iterator_has_next(iter, &has_next), IOOPM_SUCCESS);
+    CU_ASSERT_FALSE(has_next);
+    for(int i = 0; i < 40; ++i){
+        CU_ASSERT_EQUAL(ioopm_iterator_insert(iter, int_elem(i)), IOOPM_SUCCESS);
+    }
+
+    // Every insert went before the previous one, so the list counts down
+    for(int i = 39; i >= 0; --i){
+        CU_ASSERT_EQUAL(ioopm_iterator_current(iter, &current), IOOPM_SUCCESS);
+        CU_ASSERT_EQUAL(current.intValue, i);
+        CU_ASSERT_EQUAL(ioopm_iterator_next(iter, &current), IOOPM_SUCCESS);
+        CU_ASSERT_EQUAL(current.intValue, i);
+    }
+    CU_ASSERT_EQUAL(ioopm_iterator_has_next(iter, &has_next), IOOPM_SUCCESS);
+    CU_ASSERT_FALSE(has_next);
+    CU_ASSERT_EQUAL(ioopm_iterator_next(iter, &current), IOOPM_ERROR_INVALID_INDEX);
+
+    CU_ASSERT_EQUAL(ioopm_iterator_reset(iter), IOOPM_SUCCESS);
+    while(ioopm_iterator_remove(iter, &current) == IOOPM_SUCCESS);
+    size_t list_size = 1;
+    CU_ASSERT_EQUAL(ioopm_linked_list_size(list, &list_size), IOOPM_SUCCESS);
+    CU_ASSERT_EQUAL(list_size, 0);
+    CU_ASSERT_EQUAL(current.intValue, 0);
+
+    ioopm_iterator_destroy(iter);
+    ioopm_linked_list_destroy(list);
+}
+
+/// @brief Runs random iterator operations on a node list and a list with other storage, and compares them.
+static void check_random_operations(ioopm_list_storage_t storage){
+    ioopm_list_t *nodes = ioopm_linked_list_create(*elem_eq);
+    ioopm_list_t *other = ioopm_linked_list_create_with_storage(*elem_eq, storage);
+    ioopm_list_iterator_t *nodes_iter = ioopm_iterator_create(nodes);
+    ioopm_list_iterator_t *other_iter = ioopm_iterator_create(other);
+    srand(41);
+
+    for(int i = 0; i < 20000; ++i){
+        int op = rand() % 8;
+        elem_t expected, actual;
+        bool expected_more = false;
+        bool actual_more = false;
+
+        ioopm_iterator_has_next(nodes_iter, &expected_more);
+        ioopm_iterator_has_next(other_iter, &actual_more);
+        CU_ASSERT_EQUAL(actual_more, expected_more);
+
+        if(op < 3){
+            ioopm_iterator_insert(nodes_iter, int_elem(i));
+            CU_ASSERT_EQUAL(ioopm_iterator_insert(other_iter, int_elem(i)), IOOPM_SUCCESS);
+        }
+        else if(op < 5 && expected_more){
+            ioopm_iterator_remove(nodes_iter, &expected);
+            CU_ASSERT_EQUAL(ioopm_iterator_remove(other_iter, &actual), IOOPM_SUCCESS);
+            CU_ASSERT_EQUAL(actual.intValue, expected.intValue);
+        }
+        else if(op < 7 && expected_more){
+            ioopm_iterator_next(nodes_iter, &expected);
+            CU_ASSERT_EQUAL(ioopm_iterator_next(other_iter, &actual), IOOPM_SUCCESS);
+            CU_ASSERT_EQUAL(actual.intValue, expected.intValue);
+        }
+        else if(!expected_more || rand() % 8 == 0){
+            ioopm_iterator_reset(nodes_iter);
+            ioopm_iterator_reset(other_iter);
+        }
+
+        if(i % 1000 == 0){
+            assert_same_elements(nodes, other);
+        }
+    }
+    assert_same_elements(nodes, other);
+
+    ioopm_iterator_destroy(nodes_iter);
+    ioopm_iterator_destroy(other_iter);
+    ioopm_linked_list_destroy(nodes);
+    ioopm_linked_list_destroy(other);
+}
+
+void test_iter_random_operations(){
+    check_random_operations(IOOPM_LIST_UNROLLED);
+    check_random_operations(IOOPM_LIST_ARRAY);
+    check_random_operations(IOOPM_LIST_SKIP);
+    check_random_operations(IOOPM_LIST_DEQUE);
+}
+
+
+/// @brief Walks a list of a given storage back and forth at random, inserting and removing on the way,
+///        and checks every step against an array.
+static void check_backwards(ioopm_list_storage_t storage){
+    ioopm_list_t *list = ioopm_linked_list_create_with_storage(*elem_eq, storage);
+    ioopm_list_iterator_t *iter = ioopm_iterator_create(list);
+    int expected[2000];
+    size_t size = 0;
+    size_t position = 0;
+    srand(49);
+
+    for(int i = 0; i < 300; ++i){
+        ioopm_linked_list_append(list, int_elem(i));
+        expected[size++] = i;
+    }
+
+    // Backwards from the end visits the whole list in reverse
+    bool more = false;
+    CU_ASSERT_EQUAL(ioopm_iterator_reset_to_end(iter), IOOPM_SUCCESS);
+    CU_ASSERT_EQUAL(ioopm_iterator_has_next(iter, &more), IOOPM_SUCCESS);
+    CU_ASSERT_FALSE(more);
+    for(size_t i = size; i > 0; --i){
+        elem_t value;
+        CU_ASSERT_EQUAL(ioopm_iterator_has_previous(iter, &more), IOOPM_SUCCESS);
+        CU_ASSERT_TRUE(more);
+        CU_ASSERT_EQUAL(ioopm_iterator_previous(iter, &value), IOOPM_SUCCESS);
+        CU_ASSERT_EQUAL(value.intValue, expected[i - 1]);
+    }
+    CU_ASSERT_EQUAL(ioopm_iterator_has_previous(iter, &more), IOOPM_SUCCESS);
+    CU_ASSERT_FALSE(more);
+    CU_ASSERT_EQUAL(ioopm_iterator_previous(iter, NULL), IOOPM_ERROR_INVALID_INDEX);
+
+    for(int i = 0; i < 5000; ++i){
+        int op = rand() % 6;
+        elem_t value;
+
+        if(op < 2 && position < size){
+            CU_ASSERT_EQUAL(ioopm_iterator_next(iter, &value), IOOPM_SUCCESS);
+            CU_ASSERT_EQUAL(value.intValue, expected[position]);
+            ++position;
+        }
+        else if(op < 4 && position > 0){
+            CU_ASSERT_EQUAL(ioopm_iterator_previous(iter, &value), IOOPM_SUCCESS);
+            --position;
+            CU_ASSERT_EQUAL(value.intValue, expected[position]);
+        }
+        else if(op == 4 && size < 2000){
+            CU_ASSERT_EQUAL(ioopm_iterator_insert(iter, int_elem(1000 + i)), IOOPM_SUCCESS);
+            memmove(expected + position + 1, expected + position, (size - position) * sizeof(int));
+            expected[position] = 1000 + i;
+            ++size;
+        }
+        else if(op == 5 && position < size){
+            CU_ASSERT_EQUAL(ioopm_iterator_remove(iter, &value), IOOPM_SUCCESS);
+            CU_ASSERT_EQUAL(value.intValue, expected[position]);
+            memmove(expected + position, expected + position + 1, (size - position - 1) * sizeof(int));
+            --size;
+        }
+
+        CU_ASSERT_EQUAL(ioopm_iterator_has_previous(iter, &more), IOOPM_SUCCESS);
+        CU_ASSERT_EQUAL(more, position > 0);
+        CU_ASSERT_EQUAL(ioopm_iterator_has_next(iter, &more), IOOPM_SUCCESS);
+        CU_ASSERT_EQUAL(more, position < size);
+    }
+
+    ioopm_iterator_destroy(iter);
+    ioopm_linked_list_destroy(list);
+}
+
+void test_iter_backwards(){
+    check_backwards(IOOPM_LIST_NODES);
+    check_backwards(IOOPM_LIST_UNROLLED);
+    check_backwards(IOOPM_LIST_ARRAY);
+    check_backwards(IOOPM_LIST_SKIP);
+    check_backwards(IOOPM_LIST_DEQUE);
+
+    CU_ASSERT_EQUAL(ioopm_iterator_previous(NULL, NULL), IOOPM_ERROR_NULL_ITERATOR);
+    CU_ASSERT_EQUAL(ioopm_iterator_has_previous(NULL, NULL), IOOPM_ERROR_NULL_ITERATOR);
+    CU_ASSERT_EQUAL(ioopm_iterator_reset_to_end(NULL), IOOPM_ERROR_NULL_ITERATOR);
+}
+
+
+/// @brief Inserts and removes through an iterator over an indexed list, checking contains against
+///        counts of the values.
+static void check_index(ioopm_list_storage_t storage){
+    ioopm_list_t *list = ioopm_linked_list_create_with_storage(*elem_eq, storage);
+    ioopm_linked_list_enable_index(list, int_hash);
+    ioopm_list_iterator_t *iter = ioopm_iterator_create(list);
+    int counts[100] = {0};
+    srand(47);
+
+    for(int i = 0; i < 5000; ++i){
+        int op = rand() % 6;
+        bool more = false;
+        elem_t value;
+        ioopm_iterator_has_next(iter, &more);
+
+        if(op < 2){
+            int v = rand() % 100;
+            ioopm_iterator_insert(iter, int_elem(v));
+            counts[v]++;
+        }
+        else if(op < 4 && more){
+            ioopm_iterator_remove(iter, &value);
+            counts[value.intValue]--;
+        }
+        else if(more){
+            ioopm_iterator_next(iter, &value);
+        }
+        else{
+            ioopm_iterator_reset(iter);
+        }
+
+        if(i % 250 == 0){
+            for(int v = 0; v < 100; ++v){
+                bool found = !counts[v];
+                ioopm_linked_list_contains(list, int_elem(v), &found);
+                CU_ASSERT_EQUAL(found, counts[v] > 0);
+            }
+        }
+    }
+
+    ioopm_iterator_destroy(iter);
+    ioopm_linked_list_destroy(list);
+}
+
+void test_iter_index(){
+    check_index(IOOPM_LIST_NODES);
+    check_index(IOOPM_LIST_UNROLLED);
+    check_index(IOOPM_LIST_ARRAY);
+    check_index(IOOPM_LIST_SKIP);
+    check_index(IOOPM_LIST_DEQUE);
+}
+
+
 /*
  * =========================================
  * SECTION: Main
@@ -304,6 +562,10 @@ int main() {
     (CU_add_test(my_test_suite, "Iterator remove", test_iter_remove) == NULL) ||
     (CU_add_test(my_test_suite, "Iterator insert", test_iter_insert) == NULL) ||
     (CU_add_test(my_test_suite, "Iterator reset", test_iter_reset) == NULL) ||
+    (CU_add_test(my_test_suite, "Iterator over unrolled list", test_iter_unrolled) == NULL) ||
+    (CU_add_test(my_test_suite, "Iterator random operations on unrolled and array lists", test_iter_random_operations) == NULL) ||
+    (CU_add_test(my_test_suite, "Iterator backwards", test_iter_backwards) == NULL) ||
+    (CU_add_test(my_test_suite, "Iterator keeps the hash index", test_iter_index) == NULL) ||
     0
   )
     {
@@ -9,49 +9,1277 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include "linked_list.h"
+#include "linked_list_internal.h"
+
+/// Nodes in the first block of a list's node pool; every following block is twice as large.
+#define Min_Node_Block 16
+
+/// Upper bound on the nodes in one block, so a long list does not need one huge allocation.
+#define Max_Node_Block 4096
+
+/// Capacity of an array list when its first element is added; it doubles whenever it is full.
+#define Min_Array_Capacity 8
+
+/// Length of the runs that sorting an array of elements starts with, sorted by insertion.
+#define Sort_Run 16
+
+/// Number of pending runs when sorting nodes; run i holds 2^i nodes, enough for any list.
+#define Sort_Bins 64
+
+/// Levels of a skip list; with a quarter of the nodes reaching each next level, 4^16 elements fit.
+#define Max_Skip_Levels 16
+
+/// Slots of a new hash index; the index is kept at most half full, so probe sequences stay short.
+#define Min_Index_Slots 16
+
+/// Elements copied out of a list at a time while its elements are added to a hash index.
+#define Index_Batch 64
 
 
 /*
  * =========================================
- * SECTION: Function Definitions
+ * SECTION: Custom Data Types And Aliases
  * =========================================
  */
 
-/// @brief Create a new node with the given data.
-/// @param data The data to store in the node.
-/// @return Pointer to the new node on success, or NULL on failure.
-static node_t *create_entry(elem_t data){
-    node_t *new_entry = calloc(1, sizeof(node_t));
-    if(!new_entry) return NULL;
+/// @brief A distinct element of an indexed list and the number of times it occurs.
+typedef struct index_slot{
+    elem_t value;
+    size_t hash;            /// Mixed hash of value.
+    size_t count;           /// Occurrences of value in the list; 0 marks an empty slot.
+} index_slot_t;
+
+/// @brief Open-addressing multiset of the elements of a list, with linear probing and
+///        backward-shift deletion, so it has no tombstones.
+struct hash_index{
+    ioopm_hash_function hash_func;
+    index_slot_t *slots;
+    size_t mask;            /// Number of slots minus one (a power of two minus one).
+    size_t used;            /// Number of slots in use, i.e. of distinct elements.
+};
+
+/// @brief A block of nodes; the first used nodes have been handed out.
+struct node_block{
+    node_block_t *next;     /// The previously allocated block.
+    size_t capacity;        /// Number of nodes in the block.
+    size_t used;            /// Number of nodes handed out from the block.
+    node_t nodes[];
+};
 
-    new_entry->data = data;
-    new_entry->next = NULL;
 
-    return new_entry;
+/*
+ * =========================================
+ * SECTION: Function Definitions
+ * =========================================
+ */
+
+/// @brief Free all node blocks of a list, which frees every node at once.
+/// @param list The list.
+static void release_node_blocks(ioopm_list_t *list){
+    node_block_t *block = list->node_blocks;
+    while(block){
+        node_block_t *next_block = block->next;
+        free(block);
+        block = next_block;
+    }
+
+    list->node_blocks = NULL;
+    list->last_node_block = NULL;
+    list->free_nodes = NULL;
+    list->last_free_node = NULL;
 }
 
-/// @brief Get the node at a specific index in the list.
+/// @brief Get the node at a specific index in the list, and remember it as the cursor.
 /// @param list The linked list.
 /// @param index The index of the node to retrieve.
 /// @return Pointer to the node at the given index, or NULL if not found.
+/// @note The walk starts at the cursor if it is at or before index, so a loop over increasing
+///       indices takes O(1) per call.
 static node_t *get_entry_at(ioopm_list_t *list, size_t index){
     if(!list || index >= list->size) return NULL;
 
     node_t *current = list->head;
-    for(size_t i = 0; i < index; ++i){
+    size_t i = 0;
+    if(index == list->size - 1){
+        current = list->tail;
+        i = index;
+    }
+    else if(list->cursor && list->cursor_index <= index){
+        current = list->cursor;
+        i = list->cursor_index;
+    }
+
+    for(; i < index; ++i){
         if(!current){
             return NULL;
         }
 
-        current = current->next;
+        current = current->next;
+    }
+
+    list->cursor = current;
+    list->cursor_index = index;
+    return current;
+}
+
+void ioopm_linked_list_forget_cursor(ioopm_list_t *list){
+    list->cursor = NULL;
+    list->cursor_chunk = NULL;
+    list->cursor_previous_chunk = NULL;
+}
+
+/*
+ * =========================================
+ * SECTION: Node Pool
+ * =========================================
+ */
+
+node_t *ioopm_linked_list_node_alloc(ioopm_list_t *list, elem_t data){
+    node_t *new_entry = list->free_nodes;
+
+    if(new_entry){
+        list->free_nodes = new_entry->next;
+        if(!list->free_nodes) list->last_free_node = NULL;
+    }
+    else{
+        node_block_t *block = list->node_blocks;
+        if(!block || block->used == block->capacity){
+            size_t capacity = block ? block->capacity * 2 : Min_Node_Block;
+            if(capacity > Max_Node_Block) capacity = Max_Node_Block;
+
+            node_block_t *new_block = malloc(sizeof(node_block_t) + capacity * sizeof(node_t));
+            if(!new_block) return NULL;
+
+            new_block->next = block;
+            new_block->capacity = capacity;
+            new_block->used = 0;
+            list->node_blocks = new_block;
+            if(!block) list->last_node_block = new_block;
+            block = new_block;
+        }
+        new_entry = &block->nodes[block->used++];
+    }
+
+    new_entry->data = data;
+    new_entry->next = NULL;
+
+    return new_entry;
+}
+
+void ioopm_linked_list_node_free(ioopm_list_t *list, node_t *node){
+    node->next = list->free_nodes;
+    list->free_nodes = node;
+    if(!node->next) list->last_free_node = node;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Hash Index
+ * =========================================
+ */
+
+/// @brief Find the slot of a value in the hash index of a list.
+/// @param list The list, which has an index.
+/// @param value The value to find.
+/// @param hash The mixed hash of value.
+/// @return The slot holding value, or the empty slot that ended the probe.
+static size_t index_probe(ioopm_list_t *list, elem_t value, size_t hash){
+    hash_index_t *index = list->hash_index;
+    size_t i = hash & index->mask;
+
+    while(index->slots[i].count &&
+          !(index->slots[i].hash == hash && list->eq_func(index->slots[i].value, value))){
+        i = (i + 1) & index->mask;
+    }
+
+    return i;
+}
+
+/// @brief Move the slots of a hash index to a new array of slots.
+/// @param index The hash index.
+/// @param no_slots The new number of slots, a power of two larger than the number in use.
+/// @return true on success, false if memory allocation fails (the index is then unchanged).
+static bool index_resize(hash_index_t *index, size_t no_slots){
+    index_slot_t *slots = calloc(no_slots, sizeof(index_slot_t));
+    if(!slots) return false;
+
+    for(size_t j = 0; j <= index->mask; ++j){
+        if(!index->slots[j].count) continue;
+
+        size_t i = index->slots[j].hash & (no_slots - 1);
+        while(slots[i].count){
+            i = (i + 1) & (no_slots - 1);
+        }
+        slots[i] = index->slots[j];
+    }
+
+    free(index->slots);
+    index->slots = slots;
+    index->mask = no_slots - 1;
+    return true;
+}
+
+/// @brief Free the hash index of a list, if it has one.
+/// @param list The list.
+static void index_drop(ioopm_list_t *list){
+    if(!list->hash_index) return;
+
+    free(list->hash_index->slots);
+    free(list->hash_index);
+    list->hash_index = NULL;
+}
+
+/// @brief Remove every element from the hash index of a list, keeping its slots.
+/// @param list The list.
+static void index_clear(ioopm_list_t *list){
+    if(!list->hash_index) return;
+
+    memset(list->hash_index->slots, 0, (list->hash_index->mask + 1) * sizeof(index_slot_t));
+    list->hash_index->used = 0;
+}
+
+/// @brief Add elements to the hash index of a list, if it has one.
+/// @param list The list whose index is updated.
+/// @param elements The elements.
+/// @param count Number of elements.
+static void index_add_elements(ioopm_list_t *list, const elem_t *elements, size_t count){
+    for(size_t i = 0; i < count && list->hash_index; ++i){
+        ioopm_linked_list_index_add(list, elements[i]);
+    }
+}
+
+/// @brief Add every element of a list to the hash index of a list, if it has one.
+/// @param list The list whose index is updated.
+/// @param from The list to read the elements from; may be list itself.
+static void index_add_list(ioopm_list_t *list, ioopm_list_t *from){
+    elem_t batch[Index_Batch];
+    size_t copied = 0;
+
+    // Copying a range at a time reads every storage in order, without walking from the start
+    for(size_t start = 0; start < from->size && list->hash_index; start += copied){
+        ioopm_linked_list_copy_range(from, start, Index_Batch, batch, &copied);
+        index_add_elements(list, batch, copied);
+    }
+}
+
+void ioopm_linked_list_index_add(ioopm_list_t *list, elem_t value){
+    hash_index_t *index = list->hash_index;
+    if(!index) return;
+
+    size_t hash = ioopm_mix_hash(index->hash_func(value));
+    size_t i = index_probe(list, value, hash);
+    if(index->slots[i].count){
+        index->slots[i].count++;
+        return;
+    }
+
+    if((index->used + 1) * 2 > index->mask + 1){
+        if(!index_resize(index, (index->mask + 1) * 2)){
+            // The element is already in the list, so give up the index rather than the element
+            LOG_ERROR("Failed to grow the hash index, contains falls back to a linear scan");
+            index_drop(list);
+            return;
+        }
+        i = index_probe(list, value, hash);
+    }
+
+    index->slots[i] = (index_slot_t){.value = value, .hash = hash, .count = 1};
+    index->used++;
+}
+
+void ioopm_linked_list_index_remove(ioopm_list_t *list, elem_t value){
+    hash_index_t *index = list->hash_index;
+    if(!index) return;
+
+    size_t slot = index_probe(list, value, ioopm_mix_hash(index->hash_func(value)));
+    if(!index->slots[slot].count) return;
+    if(--index->slots[slot].count) return;
+
+    size_t hole = slot;
+    size_t i = (slot + 1) & index->mask;
+    while(index->slots[i].count){
+        size_t home = index->slots[i].hash & index->mask;
+        // The slot may fill the hole if the hole lies on its probe sequence (between home and i)
+        if(((i - home) & index->mask) >= ((i - hole) & index->mask)){
+            index->slots[hole] = index->slots[i];
+            hole = i;
+        }
+        i = (i + 1) & index->mask;
+    }
+
+    index->slots[hole].count = 0;
+    index->used--;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Sorting
+ * =========================================
+ */
+
+/// @brief Merge two sorted chains of nodes, taking from the first on ties so the merge is stable.
+/// @param first The chain with the earlier elements.
+/// @param second The chain with the later elements.
+/// @param cmp Compare function.
+/// @return The first node of the merged chain.
+static node_t *merge_nodes(node_t *first, node_t *second, ioopm_cmp_function cmp){
+    node_t head;
+    node_t *last = &head;
+
+    while(first && second){
+        if(cmp(second->data, first->data) < 0){
+            last->next = second;
+            second = second->next;
+        }
+        else{
+            last->next = first;
+            first = first->next;
+        }
+        last = last->next;
+    }
+
+    last->next = first ? first : second;
+    return head.next;
+}
+
+/// @brief Sort the nodes of a list by relinking them.
+/// @param list The node list.
+/// @param cmp Compare function.
+/// @note Each node is added as a run of one, and runs of equal length are merged like the
+///       carries of a binary counter, so bins[i] holds a run of 2^i nodes or nothing and the
+///       runs in higher bins hold earlier elements.
+static void sort_nodes(ioopm_list_t *list, ioopm_cmp_function cmp){
+    node_t *bins[Sort_Bins] = {NULL};
+
+    node_t *current = list->head;
+    while(current){
+        node_t *run = current;
+        current = current->next;
+        run->next = NULL;
+
+        size_t i = 0;
+        for(; bins[i]; ++i){
+            run = merge_nodes(bins[i], run, cmp);
+            bins[i] = NULL;
+        }
+        bins[i] = run;
+    }
+
+    node_t *sorted = NULL;
+    for(size_t i = 0; i < Sort_Bins; ++i){
+        if(bins[i]){
+            sorted = sorted ? merge_nodes(bins[i], sorted, cmp) : bins[i];
+        }
+    }
+
+    node_t *tail = sorted;
+    while(tail && tail->next){
+        tail = tail->next;
+    }
+
+    list->head = sorted;
+    list->tail = tail;
+}
+
+/// @brief Stable bottom-up merge sort of an array of elements.
+/// @param data The elements.
+/// @param scratch Room for size elements.
+/// @param size Number of elements.
+/// @param cmp Compare function.
+static void sort_elements(elem_t *data, elem_t *scratch, size_t size, ioopm_cmp_function cmp){
+    for(size_t start = 0; start < size; start += Sort_Run){
+        size_t end = start + Sort_Run < size ? start + Sort_Run : size;
+        for(size_t i = start + 1; i < end; ++i){
+            elem_t value = data[i];
+            size_t j = i;
+            for(; j > start && cmp(value, data[j - 1]) < 0; --j){
+                data[j] = data[j - 1];
+            }
+            data[j] = value;
+        }
+    }
+
+    elem_t *from = data;
+    elem_t *to = scratch;
+    for(size_t width = Sort_Run; width < size; width *= 2){
+        for(size_t low = 0; low < size; low += 2 * width){
+            size_t mid = low + width < size ? low + width : size;
+            size_t high = low + 2 * width < size ? low + 2 * width : size;
+            size_t i = low, j = mid, k = low;
+
+            while(i < mid && j < high){
+                to[k++] = cmp(from[j], from[i]) < 0 ? from[j++] : from[i++];
+            }
+            while(i < mid) to[k++] = from[i++];
+            while(j < high) to[k++] = from[j++];
+        }
+
+        elem_t *swap = from;
+        from = to;
+        to = swap;
+    }
+
+    if(from != data){
+        memcpy(data, from, size * sizeof(elem_t));
+    }
+}
+
+
+/*
+ * =========================================
+ * SECTION: Array Storage
+ * =========================================
+ */
+
+/// @brief Grow the array of an array list to a capacity.
+/// @param list The array list.
+/// @param capacity The new capacity, larger than the current one.
+/// @return IOOPM_SUCCESS on success, or IOOPM_ERROR_MEMORY_ALLOCATION (the array is then unchanged).
+static ioopm_status_t array_grow(ioopm_list_t *list, size_t capacity){
+    elem_t *new_array = realloc(list->array, capacity * sizeof(elem_t));
+    CHECK_NULL(new_array, "Failed to allocate memory for the array", IOOPM_ERROR_MEMORY_ALLOCATION);
+
+    list->array = new_array;
+    list->capacity = capacity;
+
+    return IOOPM_SUCCESS;
+}
+
+/// @brief Insert a value at an index of an array list, moving the later elements up.
+/// @param list The array list.
+/// @param index The index to insert at, at most the size of the list.
+/// @param value The value to insert.
+/// @return IOOPM_SUCCESS on success, or IOOPM_ERROR_MEMORY_ALLOCATION.
+static ioopm_status_t array_insert(ioopm_list_t *list, size_t index, elem_t value){
+    if(list->size == list->capacity){
+        ioopm_status_t status = array_grow(list, list->capacity ? list->capacity * 2 : Min_Array_Capacity);
+        if(status != IOOPM_SUCCESS) return status;
+    }
+
+    memmove(list->array + index + 1, list->array + index, (list->size - index) * sizeof(elem_t));
+    list->array[index] = value;
+    list->size++;
+    ioopm_linked_list_index_add(list, value);
+
+    return IOOPM_SUCCESS;
+}
+
+/// @brief Remove the value at an index of an array list, moving the later elements down.
+/// @param list The array list.
+/// @param index The index of the value, below the size of the list.
+/// @return The removed value.
+static elem_t array_remove(ioopm_list_t *list, size_t index){
+    elem_t value = list->array[index];
+    list->size--;
+    memmove(list->array + index, list->array + index + 1, (list->size - index) * sizeof(elem_t));
+    ioopm_linked_list_index_remove(list, value);
+
+    return value;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Deque Storage
+ * =========================================
+ */
+
+/// @brief Get the slot of the element at an index of a deque list.
+/// @param list The deque list, with a capacity that is a power of two.
+/// @param index The index of the element.
+/// @return Pointer to the slot in the ring.
+static elem_t *ring_slot(ioopm_list_t *list, size_t index){
+    return &list->array[(list->front + index) & (list->capacity - 1)];
+}
+
+/// @brief Grow the ring of a deque list, putting the elements back in order from the start.
+/// @param list The deque list.
+/// @param capacity Number of elements the ring should have room for, larger than its capacity.
+/// @return IOOPM_SUCCESS on success, or IOOPM_ERROR_MEMORY_ALLOCATION (the ring is then unchanged).
+static ioopm_status_t ring_grow(ioopm_list_t *list, size_t capacity){
+    // A power of two, so that positions wrap around with a mask
+    size_t new_capacity = list->capacity ? list->capacity * 2 : Min_Array_Capacity;
+    while(new_capacity < capacity) new_capacity *= 2;
+
+    elem_t *new_array = malloc(new_capacity * sizeof(elem_t));
+    CHECK_NULL(new_array, "Failed to allocate memory for the ring", IOOPM_ERROR_MEMORY_ALLOCATION);
+
+    for(size_t i = 0; i < list->size; ++i){
+        new_array[i] = *ring_slot(list, i);
+    }
+
+    free(list->array);
+    list->array = new_array;
+    list->capacity = new_capacity;
+    list->front = 0;
+
+    return IOOPM_SUCCESS;
+}
+
+/// @brief Insert a value at an index of a deque list, moving the elements on the shorter side.
+/// @param list The deque list.
+/// @param index The index to insert at, at most the size of the list.
+/// @param value The value to insert.
+/// @return IOOPM_SUCCESS on success, or IOOPM_ERROR_MEMORY_ALLOCATION.
+static ioopm_status_t ring_insert(ioopm_list_t *list, size_t index, elem_t value){
+    if(list->size == list->capacity){
+        ioopm_status_t status = ring_grow(list, list->size + 1);
+        if(status != IOOPM_SUCCESS) return status;
+    }
+
+    if(index < list->size / 2){
+        // The front moves back a slot and the elements before index follow it
+        list->front = (list->front - 1) & (list->capacity - 1);
+        for(size_t i = 0; i < index; ++i){
+            *ring_slot(list, i) = *ring_slot(list, i + 1);
+        }
+    }
+    else{
+        for(size_t i = list->size; i > index; --i){
+            *ring_slot(list, i) = *ring_slot(list, i - 1);
+        }
+    }
+
+    *ring_slot(list, index) = value;
+    list->size++;
+    ioopm_linked_list_index_add(list, value);
+
+    return IOOPM_SUCCESS;
+}
+
+/// @brief Remove the value at an index of a deque list, moving the elements on the shorter side.
+/// @param list The deque list.
+/// @param index The index of the value, below the size of the list.
+/// @return The removed value.
+static elem_t ring_remove(ioopm_list_t *list, size_t index){
+    elem_t value = *ring_slot(list, index);
+
+    if(index < list->size / 2){
+        for(size_t i = index; i > 0; --i){
+            *ring_slot(list, i) = *ring_slot(list, i - 1);
+        }
+        list->front = (list->front + 1) & (list->capacity - 1);
+    }
+    else{
+        for(size_t i = index; i + 1 < list->size; ++i){
+            *ring_slot(list, i) = *ring_slot(list, i + 1);
+        }
+    }
+    list->size--;
+    ioopm_linked_list_index_remove(list, value);
+
+    return value;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Unrolled Storage
+ * =========================================
+ */
+
+/// @brief Create a new, empty chunk.
+/// @return Pointer to the new chunk on success, or NULL on failure.
+static chunk_t *create_chunk(void){
+    return calloc(1, sizeof(chunk_t));
+}
+
+/// @brief Find the chunk holding the element at a specific index.
+/// @param list The unrolled list.
+/// @param index The index of the element, below the size of the list.
+/// @param offset Set to the position of the element within the chunk.
+/// @param previous Set to the chunk before the returned one (NULL for the first chunk).
+/// @return Pointer to the chunk, which also becomes the cursor.
+static chunk_t *find_chunk(ioopm_list_t *list, size_t index, size_t *offset, chunk_t **previous){
+    chunk_t *prev = NULL;
+    chunk_t *current = list->first_chunk;
+    size_t start = 0;
+    if(list->cursor_chunk && list->cursor_index <= index){
+        prev = list->cursor_previous_chunk;
+        current = list->cursor_chunk;
+        start = list->cursor_index;
+    }
+
+    while(index - start >= current->count){
+        start += current->count;
+        prev = current;
+        current = current->next;
+    }
+
+    // Only the chunk found here is split or merged with its successor, so the cursor stays valid
+    list->cursor_chunk = current;
+    list->cursor_previous_chunk = prev;
+    list->cursor_index = start;
+
+    *offset = index - start;
+    if(previous) *previous = prev;
+    return current;
+}
+
+/// @brief Insert a value at an index of an unrolled list, splitting a full chunk in two.
+/// @param list The unrolled list.
+/// @param index The index to insert at, at most the size of the list.
+/// @param value The value to insert.
+/// @return IOOPM_SUCCESS on success, or IOOPM_ERROR_MEMORY_ALLOCATION.
+static ioopm_status_t unrolled_insert(ioopm_list_t *list, size_t index, elem_t value){
+    chunk_t *chunk;
+    size_t offset;
+
+    if(index == list->size){
+        chunk = list->last_chunk;
+        if(!chunk || chunk->count == List_Chunk_Capacity){
+            chunk_t *new_chunk = create_chunk();
+            CHECK_NULL(new_chunk, "Failed to allocate memory for the new chunk", IOOPM_ERROR_MEMORY_ALLOCATION);
+
+            if(chunk) chunk->next = new_chunk;
+            else list->first_chunk = new_chunk;
+            list->last_chunk = new_chunk;
+            chunk = new_chunk;
+        }
+        offset = chunk->count;
+    }
+    else{
+        chunk = find_chunk(list, index, &offset, NULL);
+
+        if(chunk->count == List_Chunk_Capacity){
+            chunk_t *new_chunk = create_chunk();
+            CHECK_NULL(new_chunk, "Failed to allocate memory for the new chunk", IOOPM_ERROR_MEMORY_ALLOCATION);
+
+            // Move the upper half to a new chunk after this one
+            size_t half = List_Chunk_Capacity / 2;
+            new_chunk->count = List_Chunk_Capacity - half;
+            memcpy(new_chunk->data, chunk->data + half, new_chunk->count * sizeof(elem_t));
+            chunk->count = half;
+
+            new_chunk->next = chunk->next;
+            chunk->next = new_chunk;
+            if(list->last_chunk == chunk) list->last_chunk = new_chunk;
+
+            if(offset > half){
+                chunk = new_chunk;
+                offset -= half;
+            }
+        }
+
+        memmove(chunk->data + offset + 1, chunk->data + offset, (chunk->count - offset) * sizeof(elem_t));
+    }
+
+    chunk->data[offset] = value;
+    chunk->count++;
+    list->size++;
+    ioopm_linked_list_index_add(list, value);
+
+    return IOOPM_SUCCESS;
+}
+
+/// @brief Remove the value at an index of an unrolled list, merging chunks that get less than half full.
+/// @param list The unrolled list.
+/// @param index The index of the value, below the size of the list.
+/// @return The removed value.
+static elem_t unrolled_remove(ioopm_list_t *list, size_t index){
+    size_t offset;
+    chunk_t *prev;
+    chunk_t *chunk = find_chunk(list, index, &offset, &prev);
+
+    elem_t value = chunk->data[offset];
+    chunk->count--;
+    memmove(chunk->data + offset, chunk->data + offset + 1, (chunk->count - offset) * sizeof(elem_t));
+    list->size--;
+    ioopm_linked_list_index_remove(list, value);
+
+    if(chunk->count == 0){
+        if(prev) prev->next = chunk->next;
+        else list->first_chunk = chunk->next;
+        if(list->last_chunk == chunk) list->last_chunk = prev;
+
+        ioopm_linked_list_forget_cursor(list);
+        free(chunk);
+    }
+    else if(chunk->count < List_Chunk_Capacity / 2 && chunk->next &&
+            chunk->count + chunk->next->count <= List_Chunk_Capacity){
+        chunk_t *next = chunk->next;
+        memcpy(chunk->data + chunk->count, next->data, next->count * sizeof(elem_t));
+        chunk->count += next->count;
+        chunk->next = next->next;
+        if(list->last_chunk == next) list->last_chunk = chunk;
+
+        free(next);
+    }
+
+    return value;
+}
+
+/// @brief Free all chunks of an unrolled list.
+/// @param list The unrolled list.
+static void unrolled_clear(ioopm_list_t *list){
+    chunk_t *current = list->first_chunk;
+    while(current){
+        chunk_t *next_chunk = current->next;
+        free(current);
+        current = next_chunk;
+    }
+
+    list->first_chunk = NULL;
+    list->last_chunk = NULL;
+    list->size = 0;
+    ioopm_linked_list_forget_cursor(list);
+}
+
+
+/*
+ * =========================================
+ * SECTION: Skip List Storage
+ * =========================================
+ */
+
+/// @brief Pick the height of a new skip list node: h levels with probability (3/4) * (1/4)^(h - 1).
+/// @param list The skip list, whose generator state advances.
+/// @return The height, between 1 and Max_Skip_Levels.
+static size_t skip_random_height(ioopm_list_t *list){
+    // xorshift32, then two bits per extra level
+    unsigned int bits = list->skip_seed;
+    bits ^= bits << 13;
+    bits ^= bits >> 17;
+    bits ^= bits << 5;
+    list->skip_seed = bits;
+
+    size_t height = 1;
+    while(height < Max_Skip_Levels && (bits & 3) == 0){
+        ++height;
+        bits >>= 2;
+    }
+    return height;
+}
+
+/// @brief Find, on every level, the last node before an index.
+/// @param list The skip list.
+/// @param index An index, at most the size of the list.
+/// @param update Receives per level the last node at a position up to index, where the head is
+///               at position 0 and the element at index i at position i + 1.
+/// @param rank Receives the position of each node in update.
+static void skip_find(ioopm_list_t *list, size_t index, skip_node_t **update, size_t *rank){
+    skip_node_t *current = list->skip_head;
+    size_t position = 0;
+
+    for(size_t level = list->skip_levels; level-- > 0;){
+        while(current->links[level].next && position + current->links[level].span <= index){
+            position += current->links[level].span;
+            current = current->links[level].next;
+        }
+        update[level] = current;
+        rank[level] = position;
+    }
+}
+
+/// @brief Find, on every level, the last node whose element compares less than or equal to a value.
+/// @param list The skip list, sorted by cmp.
+/// @param value The value to find the place of.
+/// @param cmp Compare function, negative/zero/positive like strcmp.
+/// @param update Receives the nodes, as for skip_find.
+/// @param rank Receives the position of each node in update.
+/// @return The index after the last element equal to value, so equal elements keep their insertion order.
+static size_t skip_find_sorted(ioopm_list_t *list, elem_t value, ioopm_cmp_function cmp, skip_node_t **update, size_t *rank){
+    skip_node_t *current = list->skip_head;
+    size_t position = 0;
+
+    for(size_t level = list->skip_levels; level-- > 0;){
+        while(current->links[level].next && cmp(current->links[level].next->data, value) <= 0){
+            position += current->links[level].span;
+            current = current->links[level].next;
+        }
+        update[level] = current;
+        rank[level] = position;
+    }
+
+    return position;
+}
+
+skip_node_t *ioopm_linked_list_skip_node_at(ioopm_list_t *list, size_t index){
+    skip_node_t *current = list->skip_head;
+    size_t position = 0;
+
+    for(size_t level = list->skip_levels; level-- > 0;){
+        while(current->links[level].next && position + current->links[level].span <= index + 1){
+            position += current->links[level].span;
+            current = current->links[level].next;
+        }
+        if(position == index + 1) break;
+    }
+
+    return current;
+}
+
+/// @brief Link a new node into a skip list after the nodes found by skip_find.
+/// @param list The skip list.
+/// @param index The index of the new element.
+/// @param value The value to insert.
+/// @param update The nodes found for index, with room for Max_Skip_Levels entries.
+/// @param rank The positions of the nodes in update.
+/// @return IOOPM_SUCCESS on success, or IOOPM_ERROR_MEMORY_ALLOCATION.
+/// @note A link that ends the level counts its span to position size + 1, just after the last element.
+static ioopm_status_t skip_link(ioopm_list_t *list, size_t index, elem_t value, skip_node_t **update, size_t *rank){
+    size_t height = skip_random_height(list);
+    skip_node_t *node = malloc(sizeof(skip_node_t) + height * sizeof(skip_link_t));
+    CHECK_NULL(node, "Failed to allocate memory for the new node", IOOPM_ERROR_MEMORY_ALLOCATION);
+    node->data = value;
+
+    for(size_t level = list->skip_levels; level < height; ++level){
+        update[level] = list->skip_head;
+        rank[level] = 0;
+        list->skip_head->links[level].next = NULL;
+        list->skip_head->links[level].span = list->size + 1;
+    }
+    if(height > list->skip_levels) list->skip_levels = height;
+
+    for(size_t level = 0; level < height; ++level){
+        skip_link_t *link = &update[level]->links[level];
+        node->links[level].next = link->next;
+        node->links[level].span = link->span - (index - rank[level]);
+        link->next = node;
+        link->span = index - rank[level] + 1;
+    }
+    // Higher links pass over the new node
+    for(size_t level = height; level < list->skip_levels; ++level){
+        update[level]->links[level].span++;
+    }
+
+    list->size++;
+    ioopm_linked_list_index_add(list, value);
+    return IOOPM_SUCCESS;
+}
+
+/// @brief Insert a value at an index of a skip list.
+/// @param list The skip list.
+/// @param index The index to insert at, at most the size of the list.
+/// @param value The value to insert.
+/// @return IOOPM_SUCCESS on success, or IOOPM_ERROR_MEMORY_ALLOCATION.
+static ioopm_status_t skip_insert(ioopm_list_t *list, size_t index, elem_t value){
+    skip_node_t *update[Max_Skip_Levels];
+    size_t rank[Max_Skip_Levels];
+
+    skip_find(list, index, update, rank);
+    return skip_link(list, index, value, update, rank);
+}
+
+/// @brief Remove the value at an index of a skip list.
+/// @param list The skip list.
+/// @param index The index of the value, below the size of the list.
+/// @return The removed value.
+static elem_t skip_remove(ioopm_list_t *list, size_t index){
+    skip_node_t *update[Max_Skip_Levels] = {NULL};
+    size_t rank[Max_Skip_Levels];
+
+    skip_find(list, index, update, rank);
+    skip_node_t *node = update[0]->links[0].next;
+
+    for(size_t level = 0; level < list->skip_levels; ++level){
+        skip_link_t *link = &update[level]->links[level];
+        if(link->next == node){
+            link->span += node->links[level].span - 1;
+            link->next = node->links[level].next;
+        }
+        else{
+            link->span--;
+        }
+    }
+    while(list->skip_levels > 1 && !list->skip_head->links[list->skip_levels - 1].next){
+        list->skip_levels--;
+    }
+
+    elem_t value = node->data;
+    free(node);
+    list->size--;
+    ioopm_linked_list_index_remove(list, value);
+
+    return value;
+}
+
+/// @brief Free all nodes of a skip list, keeping its head.
+/// @param list The skip list.
+static void skip_clear(ioopm_list_t *list){
+    skip_node_t *current = list->skip_head->links[0].next;
+    while(current){
+        skip_node_t *next = current->links[0].next;
+        free(current);
+        current = next;
+    }
+
+    list->skip_head->links[0].next = NULL;
+    list->skip_head->links[0].span = 1;
+    list->skip_levels = 1;
+    list->size = 0;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Moving Elements Between Lists
+ * =========================================
+ */
+
+/// @brief Make dst the owner of the node blocks and spare nodes of src.
+/// @param dst The list that takes over the nodes.
+/// @param src The list that gives them up; it has no blocks afterwards.
+/// @note O(1). dst keeps allocating from its own newest block, since src's blocks go at the
+///       end, and src's spare nodes are joined on after dst's.
+static void take_node_blocks(ioopm_list_t *dst, ioopm_list_t *src){
+    if(!src->node_blocks) return;
+
+    if(dst->last_node_block) dst->last_node_block->next = src->node_blocks;
+    else dst->node_blocks = src->node_blocks;
+    dst->last_node_block = src->last_node_block;
+
+    if(!dst->free_nodes){
+        dst->free_nodes = src->free_nodes;
+        dst->last_free_node = src->last_free_node;
+    }
+    else if(src->free_nodes){
+        dst->last_free_node->next = src->free_nodes;
+        dst->last_free_node = src->last_free_node;
+    }
+
+    src->node_blocks = NULL;
+    src->last_node_block = NULL;
+    src->free_nodes = NULL;
+    src->last_free_node = NULL;
+}
+
+/// @brief Make a list empty after its elements have been moved to another list.
+/// @param list The list.
+static void reset_moved_list(ioopm_list_t *list){
+    list->head = NULL;
+    list->tail = NULL;
+    list->first_chunk = NULL;
+    list->last_chunk = NULL;
+    list->size = 0;
+    ioopm_linked_list_forget_cursor(list);
+    index_clear(list);
+}
+
+/// @brief Copy the elements of src into dst at an index, then empty src.
+/// @param dst The list to insert into.
+/// @param index The index to insert at, at most the size of dst.
+/// @param src The list to copy from.
+/// @return IOOPM_SUCCESS on success, or IOOPM_ERROR_MEMORY_ALLOCATION (dst may then hold some of the elements).
+/// @note Used when the storage of the lists does not allow moving nodes. Reading src by
+///       increasing index, and inserting into a node or unrolled dst at increasing indices,
+///       walks from the cursor each time, so this is linear.
+static ioopm_status_t copy_elements(ioopm_list_t *dst, size_t index, ioopm_list_t *src){
+    size_t count = src->size;
+
+    if(dst->storage == IOOPM_LIST_ARRAY){
+        if(dst->size + count > dst->capacity){
+            ioopm_status_t status = array_grow(dst, dst->size + count);
+            if(status != IOOPM_SUCCESS) return status;
+        }
+
+        memmove(dst->array + index + count, dst->array + index, (dst->size - index) * sizeof(elem_t));
+        for(size_t i = 0; i < count; ++i){
+            ioopm_linked_list_get(src, i, &dst->array[index + i]);
+        }
+        dst->size += count;
+        index_add_elements(dst, dst->array + index, count);
+    }
+    else{
+        for(size_t i = 0; i < count; ++i){
+            elem_t value;
+            ioopm_linked_list_get(src, i, &value);
+
+            ioopm_status_t status = ioopm_linked_list_insert(dst, index + i, value);
+            if(status != IOOPM_SUCCESS) return status;
+        }
+    }
+
+    return ioopm_linked_list_clear(src);
+}
+
+/// @brief Link the nodes of src into dst after a node.
+/// @param dst The node list to insert into.
+/// @param prev The node of dst the nodes of src follow, or NULL to put them first.
+/// @param src The node list to move from, with at least one node.
+static void splice_nodes(ioopm_list_t *dst, node_t *prev, ioopm_list_t *src){
+    node_t *next = prev ? prev->next : dst->head;
+
+    // The moved elements never pass through insert, so they are added to the index of dst here
+    index_add_list(dst, src);
+
+    if(prev) prev->next = src->head;
+    else dst->head = src->head;
+
+    src->tail->next = next;
+    if(!next) dst->tail = src->tail;
+
+    dst->size += src->size;
+    take_node_blocks(dst, src);
+    reset_moved_list(src);
+}
+
+/// @brief Link the chunks of src into dst at an index, splitting the chunk at the index if needed.
+/// @param dst The unrolled list to insert into.
+/// @param index The index to insert at, at most the size of dst.
+/// @param src The unrolled list to move from, with at least one chunk.
+/// @return IOOPM_SUCCESS on success, or IOOPM_ERROR_MEMORY_ALLOCATION (both lists are then unchanged).
+static ioopm_status_t splice_chunks(ioopm_list_t *dst, size_t index, ioopm_list_t *src){
+    chunk_t *prev = dst->last_chunk;
+
+    if(index < dst->size){
+        size_t offset;
+        chunk_t *chunk = find_chunk(dst, index, &offset, &prev);
+
+        if(offset > 0){
+            // The elements from offset on move to a new chunk after the spliced ones
+            chunk_t *rest = create_chunk();
+            CHECK_NULL(rest, "Failed to allocate memory for the new chunk", IOOPM_ERROR_MEMORY_ALLOCATION);
+
+            rest->count = chunk->count - offset;
+            memcpy(rest->data, chunk->data + offset, rest->count * sizeof(elem_t));
+            chunk->count = offset;
+
+            rest->next = chunk->next;
+            chunk->next = rest;
+            if(dst->last_chunk == chunk) dst->last_chunk = rest;
+            prev = chunk;
+        }
+    }
+
+    index_add_list(dst, src);
+
+    chunk_t *next = prev ? prev->next : dst->first_chunk;
+    if(prev) prev->next = src->first_chunk;
+    else dst->first_chunk = src->first_chunk;
+
+    src->last_chunk->next = next;
+    if(!next) dst->last_chunk = src->last_chunk;
+
+    dst->size += src->size;
+    ioopm_linked_list_forget_cursor(dst);
+    reset_moved_list(src);
+
+    return IOOPM_SUCCESS;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Bulk Import and Export
+ * =========================================
+ */
+
+/// @brief Link nodes carved from a block after the tail of a node list, one for each element.
+/// @param list The node list.
+/// @param block A block with at least count unused nodes.
+/// @param elements The elements to store.
+/// @param count The number of elements, at least 1.
+static void append_from_block(ioopm_list_t *list, node_block_t *block, const elem_t *elements, size_t count){
+    node_t *node = &block->nodes[block->used];
+    block->used += count;
+
+    if(list->tail){
+        list->tail->next = node;
+    }
+    else{
+        list->head = node;
+    }
+
+    for(size_t i = 0; i < count - 1; ++i){
+        node[i].data = elements[i];
+        node[i].next = &node[i + 1];
+    }
+    node[count - 1].data = elements[count - 1];
+    node[count - 1].next = NULL;
+
+    list->tail = &node[count - 1];
+    list->size += count;
+}
+
+/// @brief Append elements to a node list, allocating at most one block of nodes.
+/// @param list The node list.
+/// @param elements The elements to append.
+/// @param count The number of elements, at least 1.
+/// @return IOOPM_SUCCESS on success, or IOOPM_ERROR_MEMORY_ALLOCATION (the list is then unchanged).
+/// @note The rest of the newest block is used first; spare nodes on the free list are left for
+///       later appends.
+static ioopm_status_t append_nodes(ioopm_list_t *list, const elem_t *elements, size_t count){
+    node_block_t *block = list->node_blocks;
+    size_t available = block ? block->capacity - block->used : 0;
+    node_block_t *new_block = NULL;
+
+    if(count > available){
+        size_t capacity = count - available < Min_Node_Block ? Min_Node_Block : count - available;
+        new_block = malloc(sizeof(node_block_t) + capacity * sizeof(node_t));
+        CHECK_NULL(new_block, "Failed to allocate memory for the nodes", IOOPM_ERROR_MEMORY_ALLOCATION);
+
+        new_block->capacity = capacity;
+        new_block->used = 0;
+    }
+
+    size_t taken = count < available ? count : available;
+    if(taken > 0){
+        append_from_block(list, block, elements, taken);
+    }
+
+    if(new_block){
+        new_block->next = block;
+        list->node_blocks = new_block;
+        if(!block) list->last_node_block = new_block;
+        append_from_block(list, new_block, elements + taken, count - taken);
+    }
+
+    return IOOPM_SUCCESS;
+}
+
+/// @brief Append elements to an unrolled list, filling the last chunk and then new full chunks.
+/// @param list The unrolled list.
+/// @param elements The elements to append.
+/// @param count The number of elements, at least 1.
+/// @return IOOPM_SUCCESS on success, or IOOPM_ERROR_MEMORY_ALLOCATION (the list is then unchanged).
+static ioopm_status_t append_chunks(ioopm_list_t *list, const elem_t *elements, size_t count){
+    chunk_t *last = list->last_chunk;
+    size_t taken = last ? List_Chunk_Capacity - last->count : 0;
+    if(taken > count) taken = count;
+
+    // Allocate every new chunk before touching the list, so a failure leaves it as it was
+    chunk_t *first_new = NULL;
+    chunk_t *last_new = NULL;
+    for(size_t i = taken; i < count; i += List_Chunk_Capacity){
+        chunk_t *chunk = malloc(sizeof(chunk_t));
+        if(!chunk){
+            while(first_new){
+                chunk_t *next = first_new->next;
+                free(first_new);
+                first_new = next;
+            }
+            LOG_ERROR("Failed to allocate memory for the chunks");
+            return IOOPM_ERROR_MEMORY_ALLOCATION;
+        }
+
+        chunk->count = count - i < List_Chunk_Capacity ? count - i : List_Chunk_Capacity;
+        chunk->next = NULL;
+        memcpy(chunk->data, elements + i, chunk->count * sizeof(elem_t));
+
+        if(last_new){
+            last_new->next = chunk;
+        }
+        else{
+            first_new = chunk;
+        }
+        last_new = chunk;
+    }
+
+    if(taken > 0){
+        memcpy(last->data + last->count, elements, taken * sizeof(elem_t));
+        last->count += taken;
+    }
+    if(first_new){
+        if(last){
+            last->next = first_new;
+        }
+        else{
+            list->first_chunk = first_new;
+        }
+        list->last_chunk = last_new;
+    }
+
+    list->size += count;
+    return IOOPM_SUCCESS;
+}
+
+/// @brief Append the elements of an array to an array list.
+/// @param list The array list.
+/// @param elements The elements to append.
+/// @param count Number of elements, at least 1.
+/// @return IOOPM_SUCCESS on success, or IOOPM_ERROR_MEMORY_ALLOCATION (the list is then unchanged).
+static ioopm_status_t append_to_array(ioopm_list_t *list, const elem_t *elements, size_t count){
+    if(list->size + count > list->capacity){
+        // Grow geometrically, so that appending many small batches stays amortized O(1) per element
+        size_t capacity = list->capacity * 2;
+        if(capacity < list->size + count) capacity = list->size + count;
+        ioopm_status_t status = array_grow(list, capacity);
+        if(status != IOOPM_SUCCESS) return status;
+    }
+
+    memcpy(list->array + list->size, elements, count * sizeof(elem_t));
+    list->size += count;
+    return IOOPM_SUCCESS;
+}
+
+/// @brief Append the elements of an array to a deque list.
+/// @param list The deque list.
+/// @param elements The elements to append.
+/// @param count Number of elements, at least 1.
+/// @return IOOPM_SUCCESS on success, or IOOPM_ERROR_MEMORY_ALLOCATION (the list is then unchanged).
+static ioopm_status_t append_to_ring(ioopm_list_t *list, const elem_t *elements, size_t count){
+    if(list->size + count > list->capacity){
+        ioopm_status_t status = ring_grow(list, list->size + count);
+        if(status != IOOPM_SUCCESS) return status;
+    }
+
+    for(size_t i = 0; i < count; ++i){
+        *ring_slot(list, list->size + i) = elements[i];
+    }
+    list->size += count;
+    return IOOPM_SUCCESS;
+}
+
+/// @brief Copy consecutive elements of a node list into a buffer, leaving the cursor on the last one.
+/// @param list The node list.
+/// @param start The index of the first element, below the size of the list.
+/// @param count The number of elements, at least 1 and at most size - start.
+/// @param buffer Receives the elements.
+static void copy_nodes_out(ioopm_list_t *list, size_t start, size_t count, elem_t *buffer){
+    node_t *node = get_entry_at(list, start);
+    for(size_t i = 0; i < count - 1; ++i){
+        buffer[i] = node->data;
+        node = node->next;
+    }
+    buffer[count - 1] = node->data;
+
+    // The next range then starts one step away
+    list->cursor = node;
+    list->cursor_index = start + count - 1;
+}
+
+/// @brief Copy consecutive elements of an unrolled list into a buffer, a chunk at a time.
+/// @param list The unrolled list.
+/// @param start The index of the first element, below the size of the list.
+/// @param count The number of elements, at least 1 and at most size - start.
+/// @param buffer Receives the elements.
+static void copy_chunks_out(ioopm_list_t *list, size_t start, size_t count, elem_t *buffer){
+    size_t offset;
+    chunk_t *prev;
+    chunk_t *chunk = find_chunk(list, start, &offset, &prev);
+    size_t chunk_start = start - offset;
+    size_t copied = 0;
+
+    while(true){
+        size_t n = chunk->count - offset;
+        if(n > count - copied) n = count - copied;
+        memcpy(buffer + copied, chunk->data + offset, n * sizeof(elem_t));
+        copied += n;
+        if(copied == count) break;
+
+        chunk_start += chunk->count;
+        prev = chunk;
+        chunk = chunk->next;
+        offset = 0;
     }
 
-    return current;
+    // The next range then starts in this chunk or the one after it
+    list->cursor_chunk = chunk;
+    list->cursor_previous_chunk = prev;
+    list->cursor_index = chunk_start;
 }
 
 
 ioopm_list_t *ioopm_linked_list_create(ioopm_eq_function eq_func){
+    return ioopm_linked_list_create_with_storage(eq_func, IOOPM_LIST_NODES);
+}
+
+ioopm_list_t *ioopm_linked_list_create_with_storage(ioopm_eq_function eq_func, ioopm_list_storage_t storage){
     ioopm_list_t *new_list = calloc(1, sizeof(ioopm_list_t));
     if(!new_list) return NULL;
 
@@ -59,6 +1287,18 @@ ioopm_list_t *ioopm_linked_list_create(ioopm_eq_function eq_func){
     new_list->tail = NULL;
     new_list->size = 0;
     new_list->eq_func = eq_func;
+    new_list->storage = storage;
+
+    if(storage == IOOPM_LIST_SKIP){
+        new_list->skip_head = calloc(1, sizeof(skip_node_t) + Max_Skip_Levels * sizeof(skip_link_t));
+        if(!new_list->skip_head){
+            free(new_list);
+            return NULL;
+        }
+        new_list->skip_head->links[0].span = 1;
+        new_list->skip_levels = 1;
+        new_list->skip_seed = 2463534242u;
+    }
 
     return new_list;
 }
@@ -66,20 +1306,50 @@ ioopm_list_t *ioopm_linked_list_create(ioopm_eq_function eq_func){
 void ioopm_linked_list_destroy(ioopm_list_t *list){
     if(!list) return;
 
-    node_t *current = list->head;
-    while(current != NULL){
-        node_t *next_entry = current->next;
-        free(current);
-        current = next_entry;
+    if(list->storage == IOOPM_LIST_UNROLLED){
+        unrolled_clear(list);
+    }
+    if(list->storage == IOOPM_LIST_SKIP){
+        skip_clear(list);
+        free(list->skip_head);
     }
 
+    release_node_blocks(list);
+    index_drop(list);
+    free(list->array);
     free(list);
 }
 
+ioopm_status_t ioopm_linked_list_reserve(ioopm_list_t *list, size_t capacity){
+    CHECK_NULL(list, "The list is NULL, unable to reserve", IOOPM_ERROR_NULL_LIST);
+
+    if(list->storage == IOOPM_LIST_ARRAY && capacity > list->capacity){
+        return array_grow(list, capacity);
+    }
+    if(list->storage == IOOPM_LIST_DEQUE && capacity > list->capacity){
+        return ring_grow(list, capacity);
+    }
+
+    return IOOPM_SUCCESS;
+}
+
 ioopm_status_t ioopm_linked_list_append(ioopm_list_t *list, elem_t value){
     CHECK_NULL(list, "The list is Null, unable to append", IOOPM_ERROR_NULL_LIST);
 
-    node_t *new_entry = create_entry(value);
+    if(list->storage == IOOPM_LIST_UNROLLED){
+        return unrolled_insert(list, list->size, value);
+    }
+    if(list->storage == IOOPM_LIST_ARRAY){
+        return array_insert(list, list->size, value);
+    }
+    if(list->storage == IOOPM_LIST_SKIP){
+        return skip_insert(list, list->size, value);
+    }
+    if(list->storage == IOOPM_LIST_DEQUE){
+        return ring_insert(list, list->size, value);
+    }
+
+    node_t *new_entry = ioopm_linked_list_node_alloc(list, value);
     CHECK_NULL(new_entry, "Failed to allocate memory for the new entry/node", IOOPM_ERROR_MEMORY_ALLOCATION);
 
     if(list->tail){
@@ -91,6 +1361,7 @@ ioopm_status_t ioopm_linked_list_append(ioopm_list_t *list, elem_t value){
 
     list->tail = new_entry;
     list->size++;
+    ioopm_linked_list_index_add(list, value);
 
     return IOOPM_SUCCESS;
 }
@@ -98,7 +1369,20 @@ ioopm_status_t ioopm_linked_list_append(ioopm_list_t *list, elem_t value){
 ioopm_status_t ioopm_linked_list_prepend(ioopm_list_t *list, elem_t value){
     CHECK_NULL(list, "The list is NULL, failed to prepend", IOOPM_ERROR_NULL_LIST);
 
-    node_t *new_entry = create_entry(value);
+    if(list->storage == IOOPM_LIST_UNROLLED){
+        return unrolled_insert(list, 0, value);
+    }
+    if(list->storage == IOOPM_LIST_ARRAY){
+        return array_insert(list, 0, value);
+    }
+    if(list->storage == IOOPM_LIST_SKIP){
+        return skip_insert(list, 0, value);
+    }
+    if(list->storage == IOOPM_LIST_DEQUE){
+        return ring_insert(list, 0, value);
+    }
+
+    node_t *new_entry = ioopm_linked_list_node_alloc(list, value);
     CHECK_NULL(new_entry, "Failed to allocate memory for the new entry/node", IOOPM_ERROR_MEMORY_ALLOCATION);
 
     if(!list->head){
@@ -110,7 +1394,11 @@ ioopm_status_t ioopm_linked_list_prepend(ioopm_list_t *list, elem_t value){
         list->head = new_entry;
     }
 
+    if(list->cursor){
+        list->cursor_index++;
+    }
     list->size++;
+    ioopm_linked_list_index_add(list, value);
 
     return IOOPM_SUCCESS;
 }
@@ -123,7 +1411,20 @@ ioopm_status_t ioopm_linked_list_insert(ioopm_list_t *list, size_t index, elem_t
         return IOOPM_ERROR_INVALID_INDEX;
     }
 
-    node_t *new_entry = create_entry(value);
+    if(list->storage == IOOPM_LIST_UNROLLED){
+        return unrolled_insert(list, index, value);
+    }
+    if(list->storage == IOOPM_LIST_ARRAY){
+        return array_insert(list, index, value);
+    }
+    if(list->storage == IOOPM_LIST_SKIP){
+        return skip_insert(list, index, value);
+    }
+    if(list->storage == IOOPM_LIST_DEQUE){
+        return ring_insert(list, index, value);
+    }
+
+    node_t *new_entry = ioopm_linked_list_node_alloc(list, value);
     CHECK_NULL(new_entry, "Failed to allocate memory for the new entry/node", IOOPM_ERROR_MEMORY_ALLOCATION);
 
     if(index == 0){
@@ -133,22 +1434,24 @@ ioopm_status_t ioopm_linked_list_insert(ioopm_list_t *list, size_t index, elem_t
         if(list->size == 0){
             list->tail = new_entry;
         }
+        if(list->cursor){
+            list->cursor_index++;
+        }
     }
     else if(index == list->size){
         list->tail->next = new_entry;
         list->tail = new_entry;
     }
     else{
-        node_t *current = list->head;
-        for(size_t i = 0; i < index - 1; ++i){
-            current = current->next;
-        }
+        // The cursor ends up on the node before the new one, so it stays valid
+        node_t *current = get_entry_at(list, index - 1);
 
         new_entry->next = current->next;
         current->next = new_entry;
     }
 
     list->size++;
+    ioopm_linked_list_index_add(list, value);
 
     return IOOPM_SUCCESS;
 }
@@ -161,6 +1464,19 @@ ioopm_status_t ioopm_linked_list_remove(ioopm_list_t *list, size_t index, elem_t
         return IOOPM_ERROR_INVALID_INDEX;
     }
 
+    if(list->storage != IOOPM_LIST_NODES){
+        elem_t value;
+        if(list->storage == IOOPM_LIST_UNROLLED) value = unrolled_remove(list, index);
+        else if(list->storage == IOOPM_LIST_ARRAY) value = array_remove(list, index);
+        else if(list->storage == IOOPM_LIST_DEQUE) value = ring_remove(list, index);
+        else value = skip_remove(list, index);
+        if(removed_value){
+            *removed_value = value;
+        }
+
+        return IOOPM_SUCCESS;
+    }
+
     node_t *to_remove;
 
     if(index == 0){
@@ -169,6 +1485,12 @@ ioopm_status_t ioopm_linked_list_remove(ioopm_list_t *list, size_t index, elem_t
         if(list->size == 1){
             list->tail = NULL;
         }
+        if(list->cursor == to_remove){
+            list->cursor = NULL;
+        }
+        else if(list->cursor){
+            list->cursor_index--;
+        }
     }
     else{
         node_t *prev = get_entry_at(list, index - 1);
@@ -187,7 +1509,8 @@ ioopm_status_t ioopm_linked_list_remove(ioopm_list_t *list, size_t index, elem_t
         *removed_value = to_remove->data;
     }
 
-    free(to_remove);
+    ioopm_linked_list_index_remove(list, to_remove->data);
+    ioopm_linked_list_node_free(list, to_remove);
     list->size--;
 
     return IOOPM_SUCCESS;
@@ -201,10 +1524,39 @@ ioopm_status_t ioopm_linked_list_get(ioopm_list_t *list, size_t index, elem_t *r
         return IOOPM_ERROR_INVALID_INDEX;
     }
 
-    node_t *current = list->head;
-    for(size_t i = 0; i < index; ++i){
-        current = current->next;
+    if(list->storage == IOOPM_LIST_UNROLLED){
+        size_t offset;
+        chunk_t *chunk = find_chunk(list, index, &offset, NULL);
+        if(retrieved_values){
+            *retrieved_values = chunk->data[offset];
+        }
+
+        return IOOPM_SUCCESS;
     }
+    if(list->storage == IOOPM_LIST_ARRAY){
+        if(retrieved_values){
+            *retrieved_values = list->array[index];
+        }
+
+        return IOOPM_SUCCESS;
+    }
+    if(list->storage == IOOPM_LIST_SKIP){
+        skip_node_t *node = ioopm_linked_list_skip_node_at(list, index);
+        if(retrieved_values){
+            *retrieved_values = node->data;
+        }
+
+        return IOOPM_SUCCESS;
+    }
+    if(list->storage == IOOPM_LIST_DEQUE){
+        if(retrieved_values){
+            *retrieved_values = *ring_slot(list, index);
+        }
+
+        return IOOPM_SUCCESS;
+    }
+
+    node_t *current = get_entry_at(list, index);
 
     if(retrieved_values){
         *retrieved_values = current->data;
@@ -216,6 +1568,62 @@ ioopm_status_t ioopm_linked_list_get(ioopm_list_t *list, size_t index, elem_t *r
 ioopm_status_t ioopm_linked_list_contains(ioopm_list_t *list, elem_t element, bool *result){
     CHECK_NULL(list, "The list is NULL, failed to check containment", IOOPM_ERROR_NULL_LIST);
 
+    if(list->hash_index){
+        size_t hash = ioopm_mix_hash(list->hash_index->hash_func(element));
+        if(result){
+            *result = list->hash_index->slots[index_probe(list, element, hash)].count > 0;
+        }
+
+        return IOOPM_SUCCESS;
+    }
+
+    if(list->storage == IOOPM_LIST_ARRAY){
+        bool found = false;
+        for(size_t i = 0; i < list->size && !found; ++i){
+            found = list->eq_func(list->array[i], element);
+        }
+        if(result){
+            *result = found;
+        }
+
+        return IOOPM_SUCCESS;
+    }
+    if(list->storage == IOOPM_LIST_UNROLLED){
+        bool found = false;
+        for(chunk_t *chunk = list->first_chunk; chunk && !found; chunk = chunk->next){
+            for(size_t i = 0; i < chunk->count && !found; ++i){
+                found = list->eq_func(chunk->data[i], element);
+            }
+        }
+        if(result){
+            *result = found;
+        }
+
+        return IOOPM_SUCCESS;
+    }
+    if(list->storage == IOOPM_LIST_SKIP){
+        bool found = false;
+        for(skip_node_t *node = list->skip_head->links[0].next; node && !found; node = node->links[0].next){
+            found = list->eq_func(node->data, element);
+        }
+        if(result){
+            *result = found;
+        }
+
+        return IOOPM_SUCCESS;
+    }
+    if(list->storage == IOOPM_LIST_DEQUE){
+        bool found = false;
+        for(size_t i = 0; i < list->size && !found; ++i){
+            found = list->eq_func(*ring_slot(list, i), element);
+        }
+        if(result){
+            *result = found;
+        }
+
+        return IOOPM_SUCCESS;
+    }
+
     node_t *current = list->head;
     for(size_t i = 0; i < list->size; ++i){
         if(list->eq_func(current->data, element)){
@@ -259,13 +1667,26 @@ ioopm_status_t ioopm_linked_list_is_empty(ioopm_list_t *list, bool *result){
 ioopm_status_t ioopm_linked_list_clear(ioopm_list_t *list){
     CHECK_NULL(list, "The list is NULL, unable to clear", IOOPM_ERROR_NULL_LIST);
 
-    node_t *current = list->head;
-    while(current){
-        node_t *next_entry = current->next;
-        free(current);
-        current = next_entry;
+    index_clear(list);
+
+    if(list->storage == IOOPM_LIST_UNROLLED){
+        unrolled_clear(list);
+        return IOOPM_SUCCESS;
+    }
+    if(list->storage == IOOPM_LIST_ARRAY || list->storage == IOOPM_LIST_DEQUE){
+        // The array is kept, so refilling the list does not allocate again
+        list->size = 0;
+        list->front = 0;
+        return IOOPM_SUCCESS;
+    }
+    if(list->storage == IOOPM_LIST_SKIP){
+        skip_clear(list);
+        return IOOPM_SUCCESS;
     }
 
+    release_node_blocks(list);
+    ioopm_linked_list_forget_cursor(list);
+
     list->head = NULL;
     list->tail = NULL;
     list->size = 0;
@@ -277,6 +1698,37 @@ ioopm_status_t ioopm_linked_list_all(ioopm_list_t *list, ioopm_predicate_lists *
     CHECK_NULL(list, "The list is NULL", IOOPM_ERROR_NULL_LIST);
     CHECK_NULL(prop, "The proprety is NULL, can not be applied to any element", IOOPM_ERROR_NULL_PROPERTY);
 
+    if(list->storage != IOOPM_LIST_NODES){
+        bool stopped = false;
+        if(list->storage == IOOPM_LIST_ARRAY){
+            for(size_t i = 0; i < list->size && !stopped; ++i){
+                stopped = !prop(list->array[i], extra);
+            }
+        }
+        else if(list->storage == IOOPM_LIST_UNROLLED){
+            for(chunk_t *chunk = list->first_chunk; chunk && !stopped; chunk = chunk->next){
+                for(size_t i = 0; i < chunk->count && !stopped; ++i){
+                    stopped = !prop(chunk->data[i], extra);
+                }
+            }
+        }
+        else if(list->storage == IOOPM_LIST_SKIP){
+            for(skip_node_t *node = list->skip_head->links[0].next; node && !stopped; node = node->links[0].next){
+                stopped = !prop(node->data, extra);
+            }
+        }
+        else if(list->storage == IOOPM_LIST_DEQUE){
+            for(size_t i = 0; i < list->size && !stopped; ++i){
+                stopped = !prop(*ring_slot(list, i), extra);
+            }
+        }
+        if(result){
+            *result = !stopped;
+        }
+
+        return IOOPM_SUCCESS;
+    }
+
     node_t *current = list->head;
     while(current){
         if(!prop(current->data, extra)){
@@ -301,6 +1753,37 @@ ioopm_status_t ioopm_linked_list_any(ioopm_list_t *list, ioopm_predicate_lists *
     CHECK_NULL(list, "The list is NULL", IOOPM_ERROR_NULL_LIST);
     CHECK_NULL(prop, "The proprety is NULL, can not be applied to any element", IOOPM_ERROR_NULL_PROPERTY);
 
+    if(list->storage != IOOPM_LIST_NODES){
+        bool stopped = false;
+        if(list->storage == IOOPM_LIST_ARRAY){
+            for(size_t i = 0; i < list->size && !stopped; ++i){
+                stopped = prop(list->array[i], extra);
+            }
+        }
+        else if(list->storage == IOOPM_LIST_UNROLLED){
+            for(chunk_t *chunk = list->first_chunk; chunk && !stopped; chunk = chunk->next){
+                for(size_t i = 0; i < chunk->count && !stopped; ++i){
+                    stopped = prop(chunk->data[i], extra);
+                }
+            }
+        }
+        else if(list->storage == IOOPM_LIST_SKIP){
+            for(skip_node_t *node = list->skip_head->links[0].next; node && !stopped; node = node->links[0].next){
+                stopped = prop(node->data, extra);
+            }
+        }
+        else if(list->storage == IOOPM_LIST_DEQUE){
+            for(size_t i = 0; i < list->size && !stopped; ++i){
+                stopped = prop(*ring_slot(list, i), extra);
+            }
+        }
+        if(result){
+            *result =stopped;
+        }
+
+        return IOOPM_SUCCESS;
+    }
+
     node_t *current = list->head;
     while(current){
         if(prop(current->data, extra)){
@@ -325,6 +1808,49 @@ ioopm_status_t ioopm_linked_list_apply_to_all(ioopm_list_t *list, ioopm_apply_fu
     CHECK_NULL(list, "The list is NULL", IOOPM_ERROR_NULL_LIST);
     CHECK_NULL(fun, "The function is NULL, can not be applied to any element", IOOPM_ERROR_NULL_FUNCTION);
 
+    if(list->hash_index){
+        // The function may change any element, so the index is built again afterwards
+        hash_index_t *index = list->hash_index;
+        list->hash_index = NULL;
+        ioopm_status_t status = ioopm_linked_list_apply_to_all(list, fun, extra);
+        list->hash_index = index;
+
+        index_clear(list);
+        index_add_list(list, list);
+        return status;
+    }
+
+    if(list->storage == IOOPM_LIST_ARRAY){
+        for(size_t i = 0; i < list->size; ++i){
+            fun(&list->array[i], extra);
+        }
+
+        return IOOPM_SUCCESS;
+    }
+    if(list->storage == IOOPM_LIST_UNROLLED){
+        for(chunk_t *chunk = list->first_chunk; chunk; chunk = chunk->next){
+            for(size_t i = 0; i < chunk->count; ++i){
+                fun(&chunk->data[i], extra);
+            }
+        }
+
+        return IOOPM_SUCCESS;
+    }
+    if(list->storage == IOOPM_LIST_SKIP){
+        for(skip_node_t *node = list->skip_head->links[0].next; node; node = node->links[0].next){
+            fun(&node->data, extra);
+        }
+
+        return IOOPM_SUCCESS;
+    }
+    if(list->storage == IOOPM_LIST_DEQUE){
+        for(size_t i = 0; i < list->size; ++i){
+            fun(ring_slot(list, i), extra);
+        }
+
+        return IOOPM_SUCCESS;
+    }
+
     node_t *current = list->head;
     while(current){
         fun(&current->data, extra);
@@ -334,3 +1860,322 @@ ioopm_status_t ioopm_linked_list_apply_to_all(ioopm_list_t *list, ioopm_apply_fu
 
     return IOOPM_SUCCESS;
 }
+
+ioopm_status_t ioopm_linked_list_sort(ioopm_list_t *list, ioopm_cmp_function cmp){
+    CHECK_NULL(list, "The list is NULL, unable to sort", IOOPM_ERROR_NULL_LIST);
+    CHECK_NULL(cmp, "The compare function is NULL, unable to sort", IOOPM_ERROR_NULL_FUNCTION);
+
+    // Elements change places, so the remembered position no longer holds
+    ioopm_linked_list_forget_cursor(list);
+
+    if(list->storage == IOOPM_LIST_NODES){
+        sort_nodes(list, cmp);
+        return IOOPM_SUCCESS;
+    }
+
+    if(list->size < 2) return IOOPM_SUCCESS;
+
+    size_t buffer_size = list->storage == IOOPM_LIST_ARRAY ? list->size : 2 * list->size;
+    elem_t *buffer = malloc(buffer_size * sizeof(elem_t));
+    CHECK_NULL(buffer, "Failed to allocate memory for sorting", IOOPM_ERROR_MEMORY_ALLOCATION);
+
+    if(list->storage == IOOPM_LIST_ARRAY){
+        sort_elements(list->array, buffer, list->size, cmp);
+    }
+    else if(list->storage == IOOPM_LIST_DEQUE){
+        for(size_t i = 0; i < list->size; ++i){
+            buffer[i] = *ring_slot(list, i);
+        }
+
+        sort_elements(buffer, buffer + list->size, list->size, cmp);
+
+        for(size_t i = 0; i < list->size; ++i){
+            *ring_slot(list, i) = buffer[i];
+        }
+    }
+    else if(list->storage == IOOPM_LIST_SKIP){
+        // The positions stay the same, so only the elements are put back and no span changes
+        size_t i = 0;
+        for(skip_node_t *node = list->skip_head->links[0].next; node; node = node->links[0].next){
+            buffer[i++] = node->data;
+        }
+
+        sort_elements(buffer, buffer + list->size, list->size, cmp);
+
+        i = 0;
+        for(skip_node_t *node = list->skip_head->links[0].next; node; node = node->links[0].next){
+            node->data = buffer[i++];
+        }
+    }
+    else{
+        // Gather the chunks into one array and put the sorted elements back, keeping the chunk sizes
+        size_t i = 0;
+        for(chunk_t *chunk = list->first_chunk; chunk; chunk = chunk->next){
+            memcpy(buffer + i, chunk->data, chunk->count * sizeof(elem_t));
+            i += chunk->count;
+        }
+
+        sort_elements(buffer, buffer + list->size, list->size, cmp);
+
+        i = 0;
+        for(chunk_t *chunk = list->first_chunk; chunk; chunk = chunk->next){
+            memcpy(chunk->data, buffer + i, chunk->count * sizeof(elem_t));
+            i += chunk->count;
+        }
+    }
+
+    free(buffer);
+    return IOOPM_SUCCESS;
+}
+
+ioopm_status_t ioopm_linked_list_insert_sorted(ioopm_list_t *list, elem_t value, ioopm_cmp_function cmp, size_t *index){
+    CHECK_NULL(list, "The list is NULL, failed to insert", IOOPM_ERROR_NULL_LIST);
+    CHECK_NULL(cmp, "The compare function is NULL, failed to insert", IOOPM_ERROR_NULL_FUNCTION);
+
+    // Find the index after the last element that compares less than or equal to value
+    size_t position = 0;
+    ioopm_status_t status;
+
+    if(list->storage == IOOPM_LIST_SKIP){
+        skip_node_t *update[Max_Skip_Levels];
+        size_t rank[Max_Skip_Levels];
+        position = skip_find_sorted(list, value, cmp, update, rank);
+        status = skip_link(list, position, value, update, rank);
+    }
+    else if(list->storage == IOOPM_LIST_ARRAY || list->storage == IOOPM_LIST_DEQUE){
+        size_t high = list->size;
+        while(position < high){
+            size_t middle = position + (high - position) / 2;
+            elem_t element = list->storage == IOOPM_LIST_ARRAY ? list->array[middle] : *ring_slot(list, middle);
+            if(cmp(element, value) <= 0) position = middle + 1;
+            else high = middle;
+        }
+        status = list->storage == IOOPM_LIST_ARRAY ? array_insert(list, position, value) : ring_insert(list, position, value);
+    }
+    else if(list->storage == IOOPM_LIST_UNROLLED){
+        chunk_t *prev = NULL;
+        chunk_t *chunk = list->first_chunk;
+        size_t offset = 0;
+        while(chunk){
+            for(offset = 0; offset < chunk->count && cmp(chunk->data[offset], value) <= 0; ++offset);
+            if(offset < chunk->count) break;
+
+            position += chunk->count;
+            prev = chunk;
+            chunk = chunk->next;
+        }
+
+        if(chunk){
+            // Leave the cursor on the chunk, so the insert does not walk again
+            list->cursor_chunk = chunk;
+            list->cursor_previous_chunk = prev;
+            list->cursor_index = position;
+            position += offset;
+        }
+        status = unrolled_insert(list, position, value);
+    }
+    else{
+        node_t *prev = NULL;
+        for(node_t *current = list->head; current && cmp(current->data, value) <= 0; current = current->next){
+            prev = current;
+            ++position;
+        }
+
+        if(prev){
+            // Leave the cursor on the node before the new one, so the insert does not walk again
+            list->cursor = prev;
+            list->cursor_index = position - 1;
+        }
+        status = ioopm_linked_list_insert(list, position, value);
+    }
+
+    if(status == IOOPM_SUCCESS && index){
+        *index = position;
+    }
+
+    return status;
+}
+
+ioopm_status_t ioopm_linked_list_concat(ioopm_list_t *dst, ioopm_list_t *src){
+    CHECK_NULL(dst, "The destination list is NULL, unable to concatenate", IOOPM_ERROR_NULL_LIST);
+
+    return ioopm_linked_list_splice(dst, dst->size, src);
+}
+
+ioopm_status_t ioopm_linked_list_splice(ioopm_list_t *dst, size_t index, ioopm_list_t *src){
+    CHECK_NULL(dst, "The destination list is NULL, unable to splice", IOOPM_ERROR_NULL_LIST);
+    CHECK_NULL(src, "The source list is NULL, unable to splice", IOOPM_ERROR_NULL_LIST);
+
+    if(dst == src){
+        LOG_ERROR("Can not splice a list into itself");
+        return IOOPM_ERROR_SAME_LIST;
+    }
+    if(index > dst->size){
+        LOG_ERROR("Invalid index - Out of bounds");
+        return IOOPM_ERROR_INVALID_INDEX;
+    }
+
+    if(src->size == 0) return IOOPM_SUCCESS;
+
+    if(dst->storage != src->storage || dst->storage == IOOPM_LIST_ARRAY || dst->storage == IOOPM_LIST_SKIP ||
+       dst->storage == IOOPM_LIST_DEQUE){
+        return copy_elements(dst, index, src);
+    }
+    if(dst->storage == IOOPM_LIST_UNROLLED){
+        return splice_chunks(dst, index, src);
+    }
+
+    if(index == 0){
+        // Every element of dst moves back by the size of src
+        if(dst->cursor) dst->cursor_index += src->size;
+        splice_nodes(dst, NULL, src);
+    }
+    else{
+        // The cursor ends up on the node before the spliced ones, so it stays valid
+        splice_nodes(dst, index == dst->size ? dst->tail : get_entry_at(dst, index - 1), src);
+    }
+
+    return IOOPM_SUCCESS;
+}
+
+ioopm_list_t *ioopm_linked_list_from_array(ioopm_eq_function eq_func, ioopm_list_storage_t storage, const elem_t *elements, size_t count){
+    ioopm_list_t *list = ioopm_linked_list_create_with_storage(eq_func, storage);
+    if(!list) return NULL;
+
+    if(ioopm_linked_list_append_array(list, elements, count) != IOOPM_SUCCESS){
+        ioopm_linked_list_destroy(list);
+        return NULL;
+    }
+
+    return list;
+}
+
+ioopm_status_t ioopm_linked_list_append_array(ioopm_list_t *list, const elem_t *elements, size_t count){
+    CHECK_NULL(list, "The list is NULL, unable to append", IOOPM_ERROR_NULL_LIST);
+
+    if(count == 0) return IOOPM_SUCCESS;
+    CHECK_NULL(elements, "The array is NULL, unable to append", IOOPM_ERROR_NULL_PROPERTY);
+
+    if(list->storage == IOOPM_LIST_SKIP){
+        // skip_insert adds every element to the index itself
+        for(size_t i = 0; i < count; ++i){
+            ioopm_status_t status = skip_insert(list, list->size, elements[i]);
+            if(status != IOOPM_SUCCESS){
+                // Take the appended elements out again, so a failure leaves the list as it was
+                for(; i > 0; --i) skip_remove(list, list->size - 1);
+                return status;
+            }
+        }
+
+        return IOOPM_SUCCESS;
+    }
+
+    ioopm_status_t status;
+    if(list->storage == IOOPM_LIST_UNROLLED){
+        status = append_chunks(list, elements, count);
+    }
+    else if(list->storage == IOOPM_LIST_ARRAY){
+        status = append_to_array(list, elements, count);
+    }
+    else if(list->storage == IOOPM_LIST_DEQUE){
+        status = append_to_ring(list, elements, count);
+    }
+    else{
+        status = append_nodes(list, elements, count);
+    }
+
+    if(status == IOOPM_SUCCESS){
+        index_add_elements(list, elements, count);
+    }
+
+    return status;
+}
+
+ioopm_status_t ioopm_linked_list_to_array(ioopm_list_t *list, elem_t **array, size_t *size){
+    CHECK_NULL(list, "The list is NULL, unable to copy to an array", IOOPM_ERROR_NULL_LIST);
+    CHECK_NULL(array, "The array pointer is NULL, unable to copy to an array", IOOPM_ERROR_NULL_PROPERTY);
+
+    *array = NULL;
+    if(size) *size = list->size;
+    if(list->size == 0) return IOOPM_SUCCESS;
+
+    *array = malloc(list->size * sizeof(elem_t));
+    CHECK_NULL(*array, "Failed to allocate memory for the array", IOOPM_ERROR_MEMORY_ALLOCATION);
+
+    return ioopm_linked_list_copy_range(list, 0, list->size, *array, NULL);
+}
+
+ioopm_status_t ioopm_linked_list_copy_range(ioopm_list_t *list, size_t start, size_t count, elem_t *buffer, size_t *copied){
+    CHECK_NULL(list, "The list is NULL, unable to copy", IOOPM_ERROR_NULL_LIST);
+
+    if(start > list->size){
+        LOG_ERROR("Invalid index - Out of bounds");
+        return IOOPM_ERROR_INVALID_INDEX;
+    }
+
+    if(count > list->size - start) count = list->size - start;
+    if(copied) *copied = count;
+    if(count == 0) return IOOPM_SUCCESS;
+    CHECK_NULL(buffer, "The buffer is NULL, unable to copy", IOOPM_ERROR_NULL_PROPERTY);
+
+    if(list->storage == IOOPM_LIST_UNROLLED){
+        copy_chunks_out(list, start, count, buffer);
+    }
+    else if(list->storage == IOOPM_LIST_ARRAY){
+        memcpy(buffer, list->array + start, count * sizeof(elem_t));
+    }
+    else if(list->storage == IOOPM_LIST_DEQUE){
+        for(size_t i = 0; i < count; ++i){
+            buffer[i] = *ring_slot(list, start + i);
+        }
+    }
+    else if(list->storage == IOOPM_LIST_SKIP){
+        skip_node_t *node = ioopm_linked_list_skip_node_at(list, start);
+        for(size_t i = 0; i < count; ++i){
+            buffer[i] = node->data;
+            node = node->links[0].next;
+        }
+    }
+    else{
+        copy_nodes_out(list, start, count, buffer);
+    }
+
+    return IOOPM_SUCCESS;
+}
+
+ioopm_status_t ioopm_linked_list_enable_index(ioopm_list_t *list, ioopm_hash_function hash_func){
+    CHECK_NULL(list, "The list is NULL, unable to index", IOOPM_ERROR_NULL_LIST);
+    CHECK_NULL(hash_func, "The hash function is NULL, unable to index", IOOPM_ERROR_NULL_FUNCTION);
+
+    index_drop(list);
+
+    // Room for every element without growing, even if all are distinct
+    size_t no_slots = Min_Index_Slots;
+    while(no_slots < list->size * 2){
+        no_slots *= 2;
+    }
+
+    hash_index_t *index = calloc(1, sizeof(hash_index_t));
+    CHECK_NULL(index, "Failed to allocate memory for the hash index", IOOPM_ERROR_MEMORY_ALLOCATION);
+    index->slots = calloc(no_slots, sizeof(index_slot_t));
+    if(!index->slots){
+        free(index);
+        LOG_ERROR("Failed to allocate memory for the hash index");
+        return IOOPM_ERROR_MEMORY_ALLOCATION;
+    }
+    index->hash_func = hash_func;
+    index->mask = no_slots - 1;
+
+    list->hash_index = index;
+    index_add_list(list, list);
+
+    return IOOPM_SUCCESS;
+}
+
+ioopm_status_t ioopm_linked_list_disable_index(ioopm_list_t *list){
+    CHECK_NULL(list, "The list is NULL, unable to remove the index", IOOPM_ERROR_NULL_LIST);
+
+    index_drop(list);
+
+    return IOOPM_SUCCESS;
+}
@@ -24,6 +24,9 @@
 /// @return An elem_t containing the pointer.
 #define ptr_elem(x) (elem_t){.ptrValue = x}
 
+/// @brief Number of elements an unrolled list keeps per chunk (a chunk is two cache lines).
+#define List_Chunk_Capacity 14
+
 /// @brief Macro to log an error message to stderr.
 /// @param msg The error message.
 #define LOG_ERROR(msg)  fprintf(stderr, "ERROR: %s:%d  %s \n", __FILE__, __LINE__, msg)
@@ -51,14 +54,48 @@ typedef bool ioopm_predicate_lists(elem_t value, void *extra);
 typedef void ioopm_apply_function_lists(elem_t *value, void *extra);    
 typedef struct list ioopm_list_t;
 typedef bool (*ioopm_eq_function)(elem_t a, elem_t b);
+typedef int (*ioopm_cmp_function)(elem_t a, elem_t b);
+typedef size_t (*ioopm_hash_function)(elem_t key);
 typedef struct node node_t;
+typedef struct chunk chunk_t;
+typedef struct node_block node_block_t;
+typedef struct skip_node skip_node_t;
+typedef struct hash_index hash_index_t;
 typedef enum ioopm_status ioopm_status_t;
+typedef enum ioopm_list_storage ioopm_list_storage_t;
+
+/// @brief How a list stores its elements; all functions work the same for every kind.
+enum ioopm_list_storage{
+    IOOPM_LIST_NODES,       /// One node per element (the default).
+    IOOPM_LIST_UNROLLED,    /// Chunks of up to List_Chunk_Capacity elements, for fast traversal.
+    IOOPM_LIST_ARRAY,       /// One growable array, for lists that are appended to and read by index.
+    IOOPM_LIST_SKIP,        /// An indexable skip list, for lists that are inserted into and removed from anywhere.
+    IOOPM_LIST_DEQUE        /// A ring buffer, for queues and stacks that add and remove at both ends.
+};
 
 struct list{
     node_t *head;                   /// Pointer to the first node in the list.
     node_t *tail;                   /// Pointer to the last node in the list.
     size_t size;                    /// Number of elements in the list.
     ioopm_eq_function eq_func;      /// Function to compare elements for equality.
+    ioopm_list_storage_t storage;   /// Kind of storage, fixed when the list is created.
+    chunk_t *first_chunk;           /// Used instead of head by unrolled lists.
+    chunk_t *last_chunk;            /// Used instead of tail by unrolled lists.
+    node_t *free_nodes;             /// Removed nodes kept for reuse, linked through next.
+    node_t *last_free_node;         /// The end of free_nodes, so another list's can be joined on.
+    node_block_t *node_blocks;      /// Blocks that all nodes of the list are carved from.
+    node_block_t *last_node_block;  /// The oldest block, at the end of node_blocks.
+    node_t *cursor;                 /// Last node looked up by index (NULL if unknown), and
+    size_t cursor_index;            /// its index (the index of the first element of cursor_chunk).
+    chunk_t *cursor_chunk;          /// Last chunk looked up by index in an unrolled list, and
+    chunk_t *cursor_previous_chunk; /// the chunk before it (NULL for the first chunk).
+    elem_t *array;                  /// Elements of an array list, in list order, or the ring of a deque list.
+    size_t capacity;                /// Number of elements array has room for (a power of two for a deque list).
+    size_t front;                   /// Position in the ring of the first element of a deque list.
+    hash_index_t *hash_index;       /// Counts of the distinct elements, if an index is enabled (else NULL).
+    skip_node_t *skip_head;         /// Head of a skip list, with links on every level.
+    size_t skip_levels;             /// Number of levels a skip list uses, at least 1.
+    unsigned int skip_seed;         /// State of the generator that picks the heights of skip list nodes.
 };
 
 struct node {
@@ -66,6 +103,13 @@ struct node {
     node_t *next;       /// Pointer to the next node in the list.
 };
 
+/// @brief A node of an unrolled list; only the first count elements are used, and never zero.
+struct chunk {
+    chunk_t *next;                          /// Pointer to the next chunk in the list.
+    size_t count;                           /// Number of elements in the chunk.
+    elem_t data[List_Chunk_Capacity];       /// The elements, in list order.
+};
+
 enum ioopm_status{
     IOOPM_SUCCESS,
     IOOPM_ERROR_NULL_LIST,
@@ -73,7 +117,8 @@ enum ioopm_status{
     IOOPM_ERROR_MEMORY_ALLOCATION,
     IOOPM_ERROR_NULL_PROPERTY,
     IOOPM_ERROR_NULL_FUNCTION,
-    IOOPM_ERROR_NULL_ITERATOR
+    IOOPM_ERROR_NULL_ITERATOR,
+    IOOPM_ERROR_SAME_LIST
 };
 
 /*
@@ -87,6 +132,33 @@ enum ioopm_status{
 /// @return Pointer to the new linked list.
 ioopm_list_t *ioopm_linked_list_create(ioopm_eq_function eq_func);
 
+/// @brief Creates a new empty list with a given kind of storage.
+/// @param eq_func Function to compare elements for equality.
+/// @param storage IOOPM_LIST_NODES, IOOPM_LIST_UNROLLED for lists that are mostly built and traversed,
+///                IOOPM_LIST_ARRAY for lists that are appended to and read by index, IOOPM_LIST_SKIP
+///                for lists that are inserted into and removed from at any index, or IOOPM_LIST_DEQUE
+///                for queues and stacks.
+/// @return Pointer to the new list, or NULL on failure.
+/// @note An unrolled list makes one allocation per List_Chunk_Capacity elements and traverses
+///       them like an array; inserting or removing in the middle moves up to a chunk of elements.
+/// @note An array list appends in amortized O(1) and gets any index in O(1), but inserting or
+///       removing moves every element after the index.
+/// @note A skip list gets, inserts and removes at any index in expected O(log n): every node
+///       link records how many elements it passes over. It allocates one node per element and
+///       is slower than the other kinds for short lists or work at the ends.
+/// @note A deque list appends, prepends and removes at either end in amortized O(1) and gets any
+///       index in O(1); inserting or removing in the middle moves the elements on the shorter side.
+///       The ring is one flat array, so the push that fills it copies every element into a ring
+///       twice the size and is O(n) on its own.
+ioopm_list_t *ioopm_linked_list_create_with_storage(ioopm_eq_function eq_func, ioopm_list_storage_t storage);
+
+/// @brief Makes room for a number of elements, so that appending them does not reallocate.
+/// @param list The linked list.
+/// @param capacity Number of elements the list should have room for.
+/// @return IOOPM_SUCCESS on success, or an appropriate error code on failure.
+/// @note Only array lists allocate room in advance; for other lists this does nothing.
+ioopm_status_t ioopm_linked_list_reserve(ioopm_list_t *list, size_t capacity);
+
 /// @brief Destroys the linked list and frees its memory.
 /// @param list The linked list to destroy.
 void ioopm_linked_list_destroy(ioopm_list_t *list);
@@ -171,6 +243,97 @@ ioopm_status_t ioopm_linked_list_any(ioopm_list_t *list, ioopm_predicate_lists *
 /// @return IOOPM_SUCCESS on success, or an appropriate error code on failure.
 ioopm_status_t ioopm_linked_list_apply_to_all(ioopm_list_t *list, ioopm_apply_function_lists *fun, void *extra);
 
+/// @brief Moves all elements of one list to the end of another.
+/// @param dst The list to append to.
+/// @param src The list whose elements are moved; it is empty afterwards but not destroyed.
+/// @return IOOPM_SUCCESS on success, IOOPM_ERROR_SAME_LIST if dst and src are the same list,
+///         or another error code on failure.
+/// @note O(1) when both lists store nodes, or both are unrolled: the nodes (and the blocks they
+///       were allocated from) change owner without being copied. Array lists, and lists with
+///       different storage, copy the elements of src.
+ioopm_status_t ioopm_linked_list_concat(ioopm_list_t *dst, ioopm_list_t *src);
+
+/// @brief Moves all elements of one list into another at an index.
+/// @param dst The list to insert into.
+/// @param index The index in dst where the first element of src ends up.
+/// @param src The list whose elements are moved; it is empty afterwards but not destroyed.
+/// @return IOOPM_SUCCESS on success, IOOPM_ERROR_INVALID_INDEX if index is larger than the size
+///         of dst, IOOPM_ERROR_SAME_LIST if dst and src are the same list, or another error code.
+/// @note Costs finding the index plus the same as ioopm_linked_list_concat; splitting an unrolled
+///       chunk at the index allocates one chunk.
+ioopm_status_t ioopm_linked_list_splice(ioopm_list_t *dst, size_t index, ioopm_list_t *src);
+
+/// @brief Sorts the linked list in place, keeping equal elements in their original order (stable).
+/// @param list The linked list.
+/// @param cmp Compare function, negative/zero/positive like strcmp.
+/// @return IOOPM_SUCCESS on success, or an appropriate error code on failure.
+/// @note A bottom-up merge sort in O(n log n). Node lists are sorted by relinking their nodes and
+///       never allocate; unrolled and array lists are sorted through a temporary array.
+ioopm_status_t ioopm_linked_list_sort(ioopm_list_t *list, ioopm_cmp_function cmp);
+
+/// @brief Inserts a value into a sorted list, after the elements that compare equal to it.
+/// @param list The linked list, sorted by cmp.
+/// @param value The value to insert.
+/// @param cmp Compare function, negative/zero/positive like strcmp.
+/// @param index Receives the index the value was inserted at, unless NULL.
+/// @return IOOPM_SUCCESS on success, or an appropriate error code on failure.
+/// @note O(log n) for skip lists, a binary search plus moving the later elements for array
+///       and deque lists, and a walk from the head for node and unrolled lists.
+ioopm_status_t ioopm_linked_list_insert_sorted(ioopm_list_t *list, elem_t value, ioopm_cmp_function cmp, size_t *index);
+
+/// @brief Creates a list holding the elements of an array, in order.
+/// @param eq_func Function to compare elements for equality.
+/// @param storage The kind of storage, as for ioopm_linked_list_create_with_storage.
+/// @param elements The elements to copy (may be NULL if count is 0).
+/// @param count The number of elements.
+/// @return Pointer to the new list, or NULL on failure.
+/// @note A node list gets all its nodes from a single allocation.
+ioopm_list_t *ioopm_linked_list_from_array(ioopm_eq_function eq_func, ioopm_list_storage_t storage, const elem_t *elements, size_t count);
+
+/// @brief Appends the elements of an array to the end of the linked list.
+/// @param list The linked list.
+/// @param elements The elements to append (may be NULL if count is 0).
+/// @param count The number of elements.
+/// @return IOOPM_SUCCESS on success, or an appropriate error code on failure (the list is then unchanged).
+/// @note Makes at most one allocation for a node or array list. Calling it once per buffer of a
+///       bounded size builds a large list from a stream without holding all of it in an array.
+ioopm_status_t ioopm_linked_list_append_array(ioopm_list_t *list, const elem_t *elements, size_t count);
+
+/// @brief Copies all elements of the linked list into a new array.
+/// @param list The linked list.
+/// @param array Receives the array (to be freed by the caller), or NULL if the list is empty.
+/// @param size Receives the number of elements, unless NULL.
+/// @return IOOPM_SUCCESS on success, or an appropriate error code on failure.
+ioopm_status_t ioopm_linked_list_to_array(ioopm_list_t *list, elem_t **array, size_t *size);
+
+/// @brief Copies up to count elements, starting at an index, into a buffer.
+/// @param list The linked list.
+/// @param start The index of the first element to copy, at most the size of the list.
+/// @param count The size of the buffer.
+/// @param buffer Receives the elements.
+/// @param copied Receives the number of elements copied, less than count at the end of the list, unless NULL.
+/// @return IOOPM_SUCCESS on success, or an appropriate error code on failure.
+/// @note The list remembers where the copy ended, so reading a large list a buffer at a time,
+///       with start advanced by copied, costs O(count) per call.
+ioopm_status_t ioopm_linked_list_copy_range(ioopm_list_t *list, size_t start, size_t count, elem_t *buffer, size_t *copied);
+
+/// @brief Attaches a hash index to the linked list, so that contains takes expected O(1).
+/// @param list The linked list.
+/// @param hash_func Function to hash elements; elements that are equal by the list's eq_func
+///                  must have the same hash.
+/// @return IOOPM_SUCCESS on success, or an appropriate error code on failure.
+/// @note The index counts every distinct element and is updated by every function that adds or
+///       removes elements, including the iterator, at expected O(1) per element. Concatenating or
+///       splicing into an indexed list then costs O(size of src), and apply_to_all rebuilds the
+///       index. If memory runs out while the index grows, the list drops the index and contains
+///       goes back to scanning, instead of failing the operation.
+ioopm_status_t ioopm_linked_list_enable_index(ioopm_list_t *list, ioopm_hash_function hash_func);
+
+/// @brief Removes the hash index of the linked list, if it has one.
+/// @param list The linked list.
+/// @return IOOPM_SUCCESS on success, or an appropriate error code on failure.
+ioopm_status_t ioopm_linked_list_disable_index(ioopm_list_t *list);
+
 
 
 
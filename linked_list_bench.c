@@ -0,0 +1,544 @@
+// linked_list_bench.c
+
+/**
+ * @file linked_list_bench.c
+ * @brief Sustained append/remove churn on linked lists.
+ *
+ * A list is filled with a number of live elements, then used as a queue:
+ * every operation appends at the tail and removes index 0, so elements
+ * keep passing through the list while its size stays the same. The node
+ * list reuses the nodes it removes from its pool; a calloc/free per element
+ * (what every append and remove used to do) is timed on the same queue
+ * shape for reference.
+ *
+ * The second table times a loop of ioopm_linked_list_get(list, i) over every
+ * index, which walks from the position of the previous call instead of from
+ * the head. The third builds a list by appending and then scans it with
+ * contains, for each kind of storage (array lists are left out of the
+ * churn, where removing index 0 moves every element). The last table sorts
+ * lists of random integers in place with ioopm_linked_list_sort, against
+ * copying a node list to an array, qsort and building a new list. The bulk
+ * table converts between arrays and lists: ioopm_linked_list_from_array
+ * against appending one element at a time, and ioopm_linked_list_to_array
+ * against copying through an iterator. The last table inserts and removes at
+ * random indices, where only the skip list avoids walking or moving half the
+ * list. The queue/stack table keeps a number of elements live while pushing
+ * batches at the tail and popping them at the head (queue) or tail (stack);
+ * only the deque does both in O(1). The dedupe table copies every value that
+ * has not been seen yet from an input where each value occurs twice, testing
+ * membership with contains: a plain list scans, so the loop is quadratic,
+ * while a list with a hash index answers in expected O(1). Build and run with:
+ * make bench_linked_list
+ */
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "linked_list.h"
+#include "iterator.h"
+
+/// Append/remove pairs per measurement.
+#define Bench_Operations (1 << 24)
+
+/// Elements pushed and then popped at a time by the queue/stack measurement.
+#define Bench_Batch 16
+
+
+/*
+ * =========================================
+ * SECTION: Private Function Definitions
+ * =========================================
+ */
+
+/// @brief Equality function for integer elements.
+static bool int_eq_function(elem_t a, elem_t b) {
+    return a.intValue == b.intValue;
+}
+
+/// @brief Compare function for integer elements.
+static int int_cmp_function(elem_t a, elem_t b) {
+    return (a.intValue > b.intValue) - (a.intValue < b.intValue);
+}
+
+/// @brief The same comparison, for qsort over an array of elements.
+static int int_qsort_cmp(const void *a, const void *b) {
+    return int_cmp_function(*(const elem_t *)a, *(const elem_t *)b);
+}
+
+/// @brief Hash function for integer elements.
+static size_t int_hash_function(elem_t key) {
+    return (size_t)key.uintValue;
+}
+
+/// @brief Returns the current time in nanoseconds.
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/// @brief Times queue churn on a list.
+/// @param storage Kind of list to create.
+/// @param live Number of elements kept in the list.
+/// @return ns per append/remove pair.
+static double bench_list_churn(ioopm_list_storage_t storage, size_t live) {
+    ioopm_list_t *list = ioopm_linked_list_create_with_storage(int_eq_function, storage);
+    for (size_t i = 0; i < live; ++i) {
+        ioopm_linked_list_append(list, int_elem(i));
+    }
+
+    long long checksum = 0;
+    double start = now_ns();
+    for (size_t i = 0; i < Bench_Operations; ++i) {
+        elem_t removed;
+        ioopm_linked_list_append(list, int_elem(i));
+        ioopm_linked_list_remove(list, 0, &removed);
+        checksum += removed.intValue;
+    }
+    double result = (now_ns() - start) / Bench_Operations;
+
+    if (checksum == 42) printf("unlikely\n");
+    ioopm_linked_list_destroy(list);
+    return result;
+}
+
+/// @brief Times the same churn with a calloc and a free per element, on a ring of node pointers.
+/// @param live Number of elements kept in the queue.
+/// @return ns per append/remove pair.
+static double bench_malloc_churn(size_t live) {
+    size_t capacity = live + 1;
+    node_t **ring = calloc(capacity, sizeof(node_t *));
+    size_t first = 0;
+    size_t end = 0;
+    for (size_t i = 0; i < live; ++i) {
+        ring[end] = calloc(1, sizeof(node_t));
+        ring[end]->data = int_elem(i);
+        end = (end + 1) % capacity;
+    }
+
+    long long checksum = 0;
+    double start = now_ns();
+    for (size_t i = 0; i < Bench_Operations; ++i) {
+        ring[end] = calloc(1, sizeof(node_t));
+        ring[end]->data = int_elem(i);
+        end = (end + 1) % capacity;
+
+        checksum += ring[first]->data.intValue;
+        free(ring[first]);
+        first = (first + 1) % capacity;
+    }
+    double result = (now_ns() - start) / Bench_Operations;
+
+    if (checksum == 42) printf("unlikely\n");
+    for (; first != end; first = (first + 1) % capacity) {
+        free(ring[first]);
+    }
+    free(ring);
+    return result;
+}
+
+/// @brief Times a loop that gets every element of a list by index.
+/// @param storage Kind of list to create.
+/// @param size Number of elements in the list.
+/// @return ns per get.
+static double bench_sequential_get(ioopm_list_storage_t storage, size_t size) {
+    ioopm_list_t *list = ioopm_linked_list_create_with_storage(int_eq_function, storage);
+    for (size_t i = 0; i < size; ++i) {
+        ioopm_linked_list_append(list, int_elem(i));
+    }
+
+    size_t rounds = Bench_Operations / size;
+    long long checksum = 0;
+    double start = now_ns();
+    for (size_t r = 0; r < rounds; ++r) {
+        for (size_t i = 0; i < size; ++i) {
+            elem_t value;
+            ioopm_linked_list_get(list, i, &value);
+            checksum += value.intValue;
+        }
+    }
+    double result = (now_ns() - start) / ((double)rounds * size);
+
+    if (checksum == 42) printf("unlikely\n");
+    ioopm_linked_list_destroy(list);
+    return result;
+}
+
+/// @brief Times building a list by appending and scanning it for an absent element.
+/// @param storage Kind of list to create.
+/// @param size Number of elements in the list.
+/// @param result Receives ns per element of the build and of the scan.
+static void bench_build_scan(ioopm_list_storage_t storage, size_t size, double result[2]) {
+    size_t rounds = Bench_Operations / size / 4;
+    if (rounds == 0) rounds = 1;
+    double build = 0;
+    double scan = 0;
+    bool found = false;
+
+    for (size_t r = 0; r < rounds; ++r) {
+        double start = now_ns();
+        ioopm_list_t *list = ioopm_linked_list_create_with_storage(int_eq_function, storage);
+        for (size_t i = 0; i < size; ++i) {
+            ioopm_linked_list_append(list, int_elem(i));
+        }
+        double built = now_ns();
+        bool contained;
+        ioopm_linked_list_contains(list, int_elem(-1), &contained);
+        found |= contained;
+        scan += now_ns() - built;
+
+        ioopm_linked_list_destroy(list);
+        build += built - start;
+    }
+
+    if (found) printf("unexpected result\n");
+    result[0] = build / ((double)rounds * size);
+    result[1] = scan / ((double)rounds * size);
+}
+
+/// @brief Creates a list of random integers.
+/// @param storage Kind of list to create.
+/// @param size Number of elements.
+static ioopm_list_t *random_list(ioopm_list_storage_t storage, size_t size) {
+    ioopm_list_t *list = ioopm_linked_list_create_with_storage(int_eq_function, storage);
+    ioopm_linked_list_reserve(list, size);
+
+    unsigned int state = 12345;
+    for (size_t i = 0; i < size; ++i) {
+        state = state * 1103515245u + 12345u;
+        ioopm_linked_list_append(list, int_elem((int)(state >> 1)));
+    }
+    return list;
+}
+
+/// @brief Times sorting a list in place.
+/// @param storage Kind of list to sort.
+/// @param size Number of elements.
+/// @return ms per sort.
+static double bench_sort(ioopm_list_storage_t storage, size_t size) {
+    ioopm_list_t *list = random_list(storage, size);
+
+    double start = now_ns();
+    ioopm_linked_list_sort(list, int_cmp_function);
+    double result = (now_ns() - start) / 1e6;
+
+    ioopm_linked_list_destroy(list);
+    return result;
+}
+
+/// @brief Times sorting a node list by copying it to an array, qsort and building a new list.
+/// @param size Number of elements.
+/// @return ms per sort.
+static double bench_qsort_rebuild(size_t size) {
+    ioopm_list_t *list = random_list(IOOPM_LIST_NODES, size);
+
+    double start = now_ns();
+    elem_t *array = malloc(size * sizeof(elem_t));
+    size_t i = 0;
+    for (node_t *node = list->head; node; node = node->next) {
+        array[i++] = node->data;
+    }
+    qsort(array, size, sizeof(elem_t), int_qsort_cmp);
+
+    ioopm_list_t *sorted = ioopm_linked_list_create(int_eq_function);
+    for (i = 0; i < size; ++i) {
+        ioopm_linked_list_append(sorted, array[i]);
+    }
+    free(array);
+    ioopm_linked_list_destroy(list);
+    double result = (now_ns() - start) / 1e6;
+
+    ioopm_linked_list_destroy(sorted);
+    return result;
+}
+
+/// @brief Times converting between an array and a list, in bulk and one element at a time.
+/// @param storage Kind of list to convert.
+/// @param size Number of elements.
+/// @param result Receives ns per element of: appending each element, from_array, copying
+///               through an iterator and to_array.
+static void bench_bulk(ioopm_list_storage_t storage, size_t size, double result[4]) {
+    size_t rounds = Bench_Operations / size / 4;
+    if (rounds == 0) rounds = 1;
+    elem_t *array = malloc(size * sizeof(elem_t));
+    for (size_t i = 0; i < size; ++i) {
+        array[i] = int_elem(i);
+    }
+    double times[4] = {0};
+    long checksum = 0;
+
+    for (size_t r = 0; r < rounds; ++r) {
+        double start = now_ns();
+        ioopm_list_t *list = ioopm_linked_list_create_with_storage(int_eq_function, storage);
+        for (size_t i = 0; i < size; ++i) {
+            ioopm_linked_list_append(list, array[i]);
+        }
+        times[0] += now_ns() - start;
+        ioopm_linked_list_destroy(list);
+
+        start = now_ns();
+        list = ioopm_linked_list_from_array(int_eq_function, storage, array, size);
+        times[1] += now_ns() - start;
+
+        start = now_ns();
+        elem_t *copy = malloc(size * sizeof(elem_t));
+        ioopm_list_iterator_t *iter = ioopm_iterator_create(list);
+        bool has_next;
+        size_t i = 0;
+        while (ioopm_iterator_has_next(iter, &has_next) == IOOPM_SUCCESS && has_next) {
+            ioopm_iterator_next(iter, &copy[i++]);
+        }
+        ioopm_iterator_destroy(iter);
+        times[2] += now_ns() - start;
+        checksum += copy[size - 1].intValue;
+        free(copy);
+
+        start = now_ns();
+        ioopm_linked_list_to_array(list, &copy, NULL);
+        times[3] += now_ns() - start;
+        checksum += copy[size - 1].intValue;
+        free(copy);
+
+        ioopm_linked_list_destroy(list);
+    }
+
+    if (checksum != 2 * (long)rounds * (long)(size - 1)) printf("unexpected result\n");
+    free(array);
+    for (int k = 0; k < 4; ++k) {
+        result[k] = times[k] / ((double)rounds * size);
+    }
+}
+
+/// @brief Times inserting and removing at random indices of a list that keeps its size.
+/// @param storage Kind of list.
+/// @param size Number of elements in the list.
+/// @return ns per insert/remove pair.
+static double bench_random_index(ioopm_list_storage_t storage, size_t size) {
+    ioopm_list_t *list = ioopm_linked_list_create_with_storage(int_eq_function, storage);
+    for (size_t i = 0; i < size; ++i) {
+        ioopm_linked_list_append(list, int_elem(i));
+    }
+
+    size_t pairs = Bench_Operations / size / 4;
+    if (pairs < 256) pairs = 256;
+    unsigned int state = 12345;
+    long checksum = 0;
+
+    double start = now_ns();
+    for (size_t i = 0; i < pairs; ++i) {
+        state = state * 1103515245u + 12345u;
+        ioopm_linked_list_insert(list, (state >> 1) % (size + 1), int_elem(i));
+        state = state * 1103515245u + 12345u;
+        elem_t removed;
+        ioopm_linked_list_remove(list, (state >> 1) % (size + 1), &removed);
+        checksum += removed.intValue;
+    }
+    double result = (now_ns() - start) / pairs;
+
+    if (checksum == 42) printf("unlikely\n");
+    ioopm_linked_list_destroy(list);
+    return result;
+}
+
+/// @brief Pushes Bench_Batch elements at the tail of a list, then pops as many at the head or tail.
+/// @param list The list.
+/// @param live Number of elements in the list before the push.
+/// @param stack true to pop at the tail, false to pop at the head.
+/// @return The sum of the popped elements.
+static long push_pop_batch(ioopm_list_t *list, size_t live, bool stack) {
+    long sum = 0;
+    for (size_t i = 0; i < Bench_Batch; ++i) {
+        ioopm_linked_list_append(list, int_elem(i));
+    }
+    for (size_t i = 0; i < Bench_Batch; ++i) {
+        elem_t removed;
+        ioopm_linked_list_remove(list, stack ? live + Bench_Batch - 1 - i : 0, &removed);
+        sum += removed.intValue;
+    }
+    return sum;
+}
+
+/// @brief Times pushing at the tail and popping at the head or tail of a list with live elements.
+/// @param storage Kind of list.
+/// @param live Number of elements that stay in the list.
+/// @param stack true to pop at the tail, false to pop at the head.
+/// @return ns per push/pop pair.
+/// @note Elements are pushed and popped Bench_Batch at a time, so a stack pops several elements
+///       in a row from the tail, as a work list that is drained does.
+static double bench_queue_stack(ioopm_list_storage_t storage, size_t live, bool stack) {
+    ioopm_list_t *list = ioopm_linked_list_create_with_storage(int_eq_function, storage);
+    for (size_t i = 0; i < live; ++i) {
+        ioopm_linked_list_append(list, int_elem(i));
+    }
+
+    size_t rounds = Bench_Operations / live / Bench_Batch;
+    if (rounds > (1 << 18)) rounds = 1 << 18;
+    if (rounds < 64) rounds = 64;
+
+    // One untimed round, so that the storage grows to its final size before the clock starts
+    long checksum = push_pop_batch(list, live, stack);
+
+    double start = now_ns();
+    for (size_t r = 0; r < rounds; ++r) {
+        checksum += push_pop_batch(list, live, stack);
+    }
+    double result = (now_ns() - start) / ((double)rounds * Bench_Batch);
+
+    if (checksum == 42) printf("unlikely\n");
+    ioopm_linked_list_destroy(list);
+    return result;
+}
+
+/// @brief Times removing duplicates by appending every value that the result does not contain.
+/// @param storage Kind of list for the result.
+/// @param size Number of input values; each of size / 2 values occurs twice.
+/// @param indexed true to give the result a hash index.
+/// @return ns per input value.
+static double bench_dedupe(ioopm_list_storage_t storage, size_t size, bool indexed) {
+    size_t rounds = (1 << 20) / size;
+    if (rounds == 0) rounds = 1;
+    size_t distinct = 0;
+
+    double start = now_ns();
+    for (size_t r = 0; r < rounds; ++r) {
+        ioopm_list_t *list = ioopm_linked_list_create_with_storage(int_eq_function, storage);
+        if (indexed) ioopm_linked_list_enable_index(list, int_hash_function);
+
+        for (size_t i = 0; i < size; ++i) {
+            // Odd multipliers spread the values, so duplicates are not next to each other
+            elem_t value = int_elem((int)((i * 2654435761u) % (size / 2)));
+            bool seen;
+            ioopm_linked_list_contains(list, value, &seen);
+            if (!seen) ioopm_linked_list_append(list, value);
+        }
+
+        ioopm_linked_list_size(list, &distinct);
+        ioopm_linked_list_destroy(list);
+    }
+    double result = (now_ns() - start) / ((double)rounds * size);
+
+    if (distinct != size / 2) printf("unexpected result\n");
+    return result;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Main
+ * =========================================
+ */
+
+int main() {
+    size_t sizes[] = {16, 1 << 10, 1 << 20};
+
+    printf("%d append/remove pairs per column, ns/pair\n", Bench_Operations);
+    printf("live     | nodes  unrolled  calloc/free\n");
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        double nodes = bench_list_churn(IOOPM_LIST_NODES, sizes[i]);
+        double unrolled = bench_list_churn(IOOPM_LIST_UNROLLED, sizes[i]);
+        double reference = bench_malloc_churn(sizes[i]);
+
+        printf("%-8zu | %6.2f  %6.2f    %6.2f\n", sizes[i], nodes, unrolled, reference);
+    }
+
+    printf("\nget(list, i) for every index, ns/get\n");
+    printf("size     | nodes  unrolled  array\n");
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        double nodes = bench_sequential_get(IOOPM_LIST_NODES, sizes[i]);
+        double unrolled = bench_sequential_get(IOOPM_LIST_UNROLLED, sizes[i]);
+        double array = bench_sequential_get(IOOPM_LIST_ARRAY, sizes[i]);
+
+        printf("%-8zu | %6.2f  %6.2f    %6.2f\n", sizes[i], nodes, unrolled, array);
+    }
+
+    printf("\nappend every element, then contains, ns/element\n");
+    printf("size     | build: nodes  unrolled  array | scan: nodes  unrolled  array\n");
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        double nodes[2], unrolled[2], array[2];
+        bench_build_scan(IOOPM_LIST_NODES, sizes[i], nodes);
+        bench_build_scan(IOOPM_LIST_UNROLLED, sizes[i], unrolled);
+        bench_build_scan(IOOPM_LIST_ARRAY, sizes[i], array);
+
+        printf("%-8zu |        %6.2f  %6.2f  %6.2f |       %6.2f  %6.2f  %6.2f\n", sizes[i],
+               nodes[0], unrolled[0], array[0], nodes[1], unrolled[1], array[1]);
+    }
+
+    printf("\nconvert between arrays and lists, ns/element\n");
+    printf("size     | nodes: append  from_array  iterator  to_array | unrolled: append  from_array  iterator  to_array\n");
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        double nodes[4], unrolled[4];
+        bench_bulk(IOOPM_LIST_NODES, sizes[i], nodes);
+        bench_bulk(IOOPM_LIST_UNROLLED, sizes[i], unrolled);
+
+        printf("%-8zu |        %6.2f      %6.2f    %6.2f    %6.2f |           %6.2f      %6.2f    %6.2f    %6.2f\n", sizes[i],
+               nodes[0], nodes[1], nodes[2], nodes[3], unrolled[0], unrolled[1], unrolled[2], unrolled[3]);
+    }
+
+    size_t sort_sizes[] = {1000000, 10000000};
+
+    printf("\nsort random integers, ms\n");
+    printf("size     | sort: nodes  unrolled  array | copy+qsort+rebuild\n");
+
+    for (size_t i = 0; i < sizeof(sort_sizes) / sizeof(sort_sizes[0]); ++i) {
+        double nodes = bench_sort(IOOPM_LIST_NODES, sort_sizes[i]);
+        double unrolled = bench_sort(IOOPM_LIST_UNROLLED, sort_sizes[i]);
+        double array = bench_sort(IOOPM_LIST_ARRAY, sort_sizes[i]);
+        double rebuild = bench_qsort_rebuild(sort_sizes[i]);
+
+        printf("%-8zu |      %7.1f  %7.1f  %7.1f |   %7.1f\n", sort_sizes[i], nodes, unrolled, array, rebuild);
+    }
+
+    printf("\ninsert and remove at random indices, ns/pair\n");
+    printf("size     | nodes      unrolled   array      skip\n");
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        double nodes = bench_random_index(IOOPM_LIST_NODES, sizes[i]);
+        double unrolled = bench_random_index(IOOPM_LIST_UNROLLED, sizes[i]);
+        double array = bench_random_index(IOOPM_LIST_ARRAY, sizes[i]);
+        double skip = bench_random_index(IOOPM_LIST_SKIP, sizes[i]);
+
+        printf("%-8zu | %9.1f  %9.1f  %9.1f  %9.1f\n", sizes[i], nodes, unrolled, array, skip);
+    }
+
+    printf("\npush %d at the tail, then pop them at the head (queue) or tail (stack), ns/pair\n", Bench_Batch);
+    printf("live     | queue: nodes  unrolled  array     deque | stack: nodes  unrolled  array     deque\n");
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        double queue[4], stack[4];
+        ioopm_list_storage_t storages[] = {IOOPM_LIST_NODES, IOOPM_LIST_UNROLLED, IOOPM_LIST_ARRAY, IOOPM_LIST_DEQUE};
+        for (int k = 0; k < 4; ++k) {
+            queue[k] = bench_queue_stack(storages[k], sizes[i], false);
+            stack[k] = bench_queue_stack(storages[k], sizes[i], true);
+        }
+
+        printf("%-8zu |   %9.1f %9.1f %9.1f %6.1f |   %9.1f %9.1f %9.1f %6.1f\n", sizes[i],
+               queue[0], queue[1], queue[2], queue[3], stack[0], stack[1], stack[2], stack[3]);
+    }
+
+    size_t dedupe_sizes[] = {1 << 10, 1 << 14, 1 << 17};
+
+    printf("\ndedupe with contains, ns/value\n");
+    printf("values   | scan: nodes     array      | index: nodes  array\n");
+
+    for (size_t i = 0; i < sizeof(dedupe_sizes) / sizeof(dedupe_sizes[0]); ++i) {
+        double nodes = bench_dedupe(IOOPM_LIST_NODES, dedupe_sizes[i], false);
+        double array = bench_dedupe(IOOPM_LIST_ARRAY, dedupe_sizes[i], false);
+        double nodes_indexed = bench_dedupe(IOOPM_LIST_NODES, dedupe_sizes[i], true);
+        double array_indexed = bench_dedupe(IOOPM_LIST_ARRAY, dedupe_sizes[i], true);
+
+        printf("%-8zu |       %9.1f  %9.1f |        %6.1f  %6.1f\n", dedupe_sizes[i],
+               nodes, array, nodes_indexed, array_indexed);
+    }
+
+    return 0;
+}
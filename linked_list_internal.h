@@ -0,0 +1,89 @@
+// linked_list_internal.h
+
+#ifndef LINKED_LIST_INTERNAL_H
+#define LINKED_LIST_INTERNAL_H
+
+/**
+ * @file linked_list_internal.h
+ * @brief List internals shared by linked_list.c and iterator.c only.
+ *
+ * The iterator links and unlinks nodes and chunks itself, so it needs the
+ * node pool and has to keep the cursor and the hash index of the list up to
+ * date. Nothing else should include this header.
+ */
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include "linked_list.h"
+
+
+/*
+ * =========================================
+ * SECTION: Custom Data Types And Aliases
+ * =========================================
+ */
+
+/// @brief A link of a skip list node on one level.
+typedef struct skip_link{
+    skip_node_t *next;      /// The next node on this level, or NULL.
+    size_t span;            /// Number of elements the link moves forward (see skip_link() in linked_list.c).
+} skip_link_t;
+
+/// @brief A node of a skip list, with one link per level it takes part in.
+struct skip_node{
+    elem_t data;
+    skip_link_t links[];
+};
+
+
+/*
+ * =========================================
+ * SECTION: Function Declarations
+ * =========================================
+ */
+
+/// @brief Takes a node for a list from the list's node pool.
+/// @param list The list the node will belong to.
+/// @param data The data to store in the node.
+/// @return Pointer to the node, with next set to NULL, or NULL if memory allocation fails.
+/// @note Nodes are carved from blocks that double in size up to 4096 nodes, and removed nodes
+///       are reused, so a list that is only appended to and removed from stops allocating.
+node_t *ioopm_linked_list_node_alloc(ioopm_list_t *list, elem_t data);
+
+/// @brief Returns a node that has been unlinked from a list to the list's node pool.
+/// @param list The list the node belonged to.
+/// @param node The node, which must not be used afterwards.
+void ioopm_linked_list_node_free(ioopm_list_t *list, node_t *node);
+
+/// @brief Makes a list forget the position it remembers from the last access by index.
+/// @param list The list.
+/// @note Lookups by index walk from that position when they can, so sequential access is O(1)
+///       per call. The list keeps it valid itself; code that links or unlinks nodes on its own,
+///       such as the iterator, must call this function.
+void ioopm_linked_list_forget_cursor(ioopm_list_t *list);
+
+/// @brief Adds an element to the hash index of a list, if it has one.
+/// @param list The list the element has been linked into.
+/// @param value The element.
+/// @note The list keeps its index up to date itself; code that links or unlinks nodes on its
+///       own, such as the iterator, must call this function and ioopm_linked_list_index_remove.
+void ioopm_linked_list_index_add(ioopm_list_t *list, elem_t value);
+
+/// @brief Removes one occurrence of an element from the hash index of a list, if it has one.
+/// @param list The list the element has been unlinked from.
+/// @param value The element.
+void ioopm_linked_list_index_remove(ioopm_list_t *list, elem_t value);
+
+/// @brief Get the node of the element at an index of a skip list.
+/// @param list The skip list.
+/// @param index The index of the element, below the size of the list.
+/// @return Pointer to the node.
+/// @note O(log n) expected; the iterator then follows the level-0 links from it.
+skip_node_t *ioopm_linked_list_skip_node_at(ioopm_list_t *list, size_t index);
+
+
+#endif  //LINKED_LIST_INTERNAL_H
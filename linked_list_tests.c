@@ -8,6 +8,7 @@
 
 #include <CUnit/Basic.h>
 #include <stdlib.h>
+#include <string.h>
 #include "linked_list.h"
 
 /*
@@ -46,6 +47,14 @@ static bool elem_eq(elem_t a, elem_t b) {
     return a.intValue == b.intValue;
 }
 
+/// @brief Hash function for integer elements.
+/// @param key The element.
+/// @return The integer value as a hash.
+static size_t int_hash(elem_t key){
+    return (size_t)key.uintValue;
+}
+
+
 /*
  * =========================================
  * SECTION: Initialize and clean the suite
@@ -425,6 +434,818 @@ void test_apply_all(){
     ioopm_linked_list_destroy(list);
 }
 
+/// @brief Checks that two lists hold the same elements in the same order.
+static void assert_lists_equal(ioopm_list_t *expected, ioopm_list_t *actual){
+    size_t expected_size = 0;
+    size_t actual_size = 0;
+    ioopm_linked_list_size(expected, &expected_size);
+    ioopm_linked_list_size(actual, &actual_size);
+    CU_ASSERT_EQUAL(actual_size, expected_size);
+
+    for(size_t i = 0; i < expected_size && i < actual_size; ++i){
+        elem_t a, b;
+        ioopm_linked_list_get(expected, i, &a);
+        ioopm_linked_list_get(actual, i, &b);
+        CU_ASSERT_EQUAL(b.intValue, a.intValue);
+    }
+}
+
+/// @brief Runs random operations on a node list and a list with other storage, and compares them.
+static void check_random_operations(ioopm_list_storage_t storage){
+    ioopm_list_t *nodes = ioopm_linked_list_create(elem_eq);
+    ioopm_list_t *other = ioopm_linked_list_create_with_storage(elem_eq, storage);
+    srand(41);
+
+    for(int i = 0; i < 20000; ++i){
+        size_t size = 0;
+        ioopm_linked_list_size(nodes, &size);
+        int op = rand() % 5;
+        elem_t value = int_elem(i);
+
+        if(op == 0){
+            CU_ASSERT_EQUAL(ioopm_linked_list_append(other, value), IOOPM_SUCCESS);
+            ioopm_linked_list_append(nodes, value);
+        }
+        else if(op == 1){
+            CU_ASSERT_EQUAL(ioopm_linked_list_prepend(other, value), IOOPM_SUCCESS);
+            ioopm_linked_list_prepend(nodes, value);
+        }
+        else if(op == 2){
+            size_t index = rand() % (size + 1);
+            CU_ASSERT_EQUAL(ioopm_linked_list_insert(other, index, value), IOOPM_SUCCESS);
+            ioopm_linked_list_insert(nodes, index, value);
+        }
+        else if(size > 0){
+            // Removing as often as inserting makes the list shrink and grow, merging chunks
+            size_t index = rand() % size;
+            elem_t expected, removed;
+            ioopm_linked_list_remove(nodes, index, &expected);
+            CU_ASSERT_EQUAL(ioopm_linked_list_remove(other, index, &removed), IOOPM_SUCCESS);
+            CU_ASSERT_EQUAL(removed.intValue, expected.intValue);
+        }
+
+        if(i % 1000 == 0){
+            assert_lists_equal(nodes, other);
+        }
+    }
+    assert_lists_equal(nodes, other);
+
+    size_t size = 0;
+    ioopm_linked_list_size(other, &size);
+    CU_ASSERT_EQUAL(ioopm_linked_list_insert(other, size + 1, int_elem(0)), IOOPM_ERROR_INVALID_INDEX);
+    CU_ASSERT_EQUAL(ioopm_linked_list_remove(other, size, NULL), IOOPM_ERROR_INVALID_INDEX);
+    CU_ASSERT_EQUAL(ioopm_linked_list_get(other, size, NULL), IOOPM_ERROR_INVALID_INDEX);
+
+    ioopm_linked_list_destroy(nodes);
+    ioopm_linked_list_destroy(other);
+}
+
+void test_random_operations(){
+    check_random_operations(IOOPM_LIST_UNROLLED);
+    check_random_operations(IOOPM_LIST_ARRAY);
+    check_random_operations(IOOPM_LIST_SKIP);
+    check_random_operations(IOOPM_LIST_DEQUE);
+}
+
+/// @brief Checks contains, any, all and apply_to_all on a list with a given storage.
+static void check_traversal(ioopm_list_storage_t storage){
+    ioopm_list_t *list = ioopm_linked_list_create_with_storage(elem_eq, storage);
+
+    for(int i = 0; i < 100; ++i){
+        ioopm_linked_list_append(list, int_elem(i));
+    }
+
+    bool result = false;
+    CU_ASSERT_EQUAL(ioopm_linked_list_contains(list, int_elem(99), &result), IOOPM_SUCCESS);
+    CU_ASSERT_TRUE(result);
+    CU_ASSERT_EQUAL(ioopm_linked_list_contains(list, int_elem(100), &result), IOOPM_SUCCESS);
+    CU_ASSERT_FALSE(result);
+
+    elem_t target = int_elem(57);
+    CU_ASSERT_EQUAL(ioopm_linked_list_any(list, value_equal, &target, &result), IOOPM_SUCCESS);
+    CU_ASSERT_TRUE(result);
+    CU_ASSERT_EQUAL(ioopm_linked_list_all(list, value_equal, &target, &result), IOOPM_SUCCESS);
+    CU_ASSERT_FALSE(result);
+
+    int multiplier = 2;
+    CU_ASSERT_EQUAL(ioopm_linked_list_apply_to_all(list, multiply_value, &multiplier), IOOPM_SUCCESS);
+    for(size_t i = 0; i < 100; ++i){
+        elem_t retrieved_value;
+        CU_ASSERT_EQUAL(ioopm_linked_list_get(list, i, &retrieved_value), IOOPM_SUCCESS);
+        CU_ASSERT_EQUAL(retrieved_value.intValue, i * 2);
+    }
+
+    ioopm_linked_list_destroy(list);
+}
+
+void test_traversal(){
+    check_traversal(IOOPM_LIST_UNROLLED);
+    check_traversal(IOOPM_LIST_ARRAY);
+    check_traversal(IOOPM_LIST_SKIP);
+    check_traversal(IOOPM_LIST_DEQUE);
+}
+
+void test_array_reserve(){
+    ioopm_list_t *list = ioopm_linked_list_create_with_storage(elem_eq, IOOPM_LIST_ARRAY);
+    elem_t retrieved_value;
+
+    CU_ASSERT_EQUAL(ioopm_linked_list_reserve(NULL, 10), IOOPM_ERROR_NULL_LIST);
+    CU_ASSERT_EQUAL(ioopm_linked_list_reserve(list, 1000), IOOPM_SUCCESS);
+    CU_ASSERT_EQUAL(list->capacity, 1000);
+
+    // Appending up to the reserved capacity keeps the same array
+    for(int i = 0; i < 1000; ++i){
+        CU_ASSERT_EQUAL(ioopm_linked_list_append(list, int_elem(i)), IOOPM_SUCCESS);
+    }
+    CU_ASSERT_EQUAL(list->capacity, 1000);
+    CU_ASSERT_EQUAL(ioopm_linked_list_get(list, 999, &retrieved_value), IOOPM_SUCCESS);
+    CU_ASSERT_EQUAL(retrieved_value.intValue, 999);
+
+    CU_ASSERT_EQUAL(ioopm_linked_list_reserve(list, 10), IOOPM_SUCCESS);
+    CU_ASSERT_EQUAL(list->capacity, 1000);
+    CU_ASSERT_EQUAL(ioopm_linked_list_append(list, int_elem(1000)), IOOPM_SUCCESS);
+    CU_ASSERT_TRUE(list->capacity > 1000);
+
+    CU_ASSERT_EQUAL(ioopm_linked_list_clear(list), IOOPM_SUCCESS);
+    CU_ASSERT_EQUAL(ioopm_linked_list_prepend(list, int_elem(5)), IOOPM_SUCCESS);
+    CU_ASSERT_EQUAL(ioopm_linked_list_get(list, 0, &retrieved_value), IOOPM_SUCCESS);
+    CU_ASSERT_EQUAL(retrieved_value.intValue, 5);
+
+    // Reserving is accepted, and does nothing, for the other kinds of lists
+    ioopm_list_t *nodes = ioopm_linked_list_create(elem_eq);
+    CU_ASSERT_EQUAL(ioopm_linked_list_reserve(nodes, 1000), IOOPM_SUCCESS);
+    ioopm_linked_list_destroy(nodes);
+
+    ioopm_linked_list_destroy(list);
+}
+
+void test_unrolled_clear(){
+    ioopm_list_t *list = ioopm_linked_list_create_with_storage(elem_eq, IOOPM_LIST_UNROLLED);
+    bool empty = false;
+
+    for(int i = 0; i < 50; ++i){
+        ioopm_linked_list_prepend(list, int_elem(i));
+    }
+    CU_ASSERT_EQUAL(ioopm_linked_list_clear(list), IOOPM_SUCCESS);
+    CU_ASSERT_EQUAL(ioopm_linked_list_is_empty(list, &empty), IOOPM_SUCCESS);
+    CU_ASSERT_TRUE(empty);
+
+    CU_ASSERT_EQUAL(ioopm_linked_list_append(list, int_elem(7)), IOOPM_SUCCESS);
+    elem_t retrieved_value;
+    CU_ASSERT_EQUAL(ioopm_linked_list_get(list, 0, &retrieved_value), IOOPM_SUCCESS);
+    CU_ASSERT_EQUAL(retrieved_value.intValue, 7);
+
+    ioopm_linked_list_destroy(list);
+}
+
+
+void test_node_reuse(){
+    ioopm_list_t *list = ioopm_linked_list_create(elem_eq);
+    elem_t removed;
+    int next_in = 0;
+    int next_out = 0;
+
+    // A queue of 100 elements; removed nodes are handed out again by the following appends
+    for(int round = 0; round < 3; ++round){
+        for(; next_in < next_out + 100; ++next_in){
+            CU_ASSERT_EQUAL(ioopm_linked_list_append(list, int_elem(next_in)), IOOPM_SUCCESS);
+        }
+        for(int i = 0; i < 10000; ++i){
+            CU_ASSERT_EQUAL(ioopm_linked_list_append(list, int_elem(next_in++)), IOOPM_SUCCESS);
+            CU_ASSERT_EQUAL(ioopm_linked_list_remove(list, 0, &removed), IOOPM_SUCCESS);
+            CU_ASSERT_EQUAL(removed.intValue, next_out++);
+        }
+
+        size_t size = 0;
+        CU_ASSERT_EQUAL(ioopm_linked_list_size(list, &size), IOOPM_SUCCESS);
+        CU_ASSERT_EQUAL(size, 100);
+        for(size_t i = 0; i < size; ++i){
+            CU_ASSERT_EQUAL(ioopm_linked_list_get(list, i, &removed), IOOPM_SUCCESS);
+            CU_ASSERT_EQUAL(removed.intValue, next_out + (int)i);
+        }
+
+        // Clearing frees the pool, and the list starts over with a fresh one
+        CU_ASSERT_EQUAL(ioopm_linked_list_clear(list), IOOPM_SUCCESS);
+        next_out = next_in;
+    }
+
+    ioopm_linked_list_destroy(list);
+}
+
+
+/// @brief Runs operations at mostly increasing indices on a list and a plain array, and compares them.
+static void check_sequential_access(ioopm_list_storage_t storage){
+    ioopm_list_t *list = ioopm_linked_list_create_with_storage(elem_eq, storage);
+    int expected[2000];
+    size_t size = 0;
+    size_t position = 0;
+    srand(43);
+
+    for(int i = 0; i < 20000; ++i){
+        int op = rand() % 10;
+        elem_t value;
+
+        if(position > size || rand() % 50 == 0){
+            position = size ? rand() % size : 0;
+        }
+
+        if(op < 3 && size < 2000){
+            CU_ASSERT_EQUAL(ioopm_linked_list_insert(list, position, int_elem(i)), IOOPM_SUCCESS);
+            memmove(expected + position + 1, expected + position, (size - position) * sizeof(int));
+            expected[position] = i;
+            ++size;
+            ++position;
+        }
+        else if(op < 5 && position < size){
+            CU_ASSERT_EQUAL(ioopm_linked_list_remove(list, position, &value), IOOPM_SUCCESS);
+            CU_ASSERT_EQUAL(value.intValue, expected[position]);
+            memmove(expected + position, expected + position + 1, (size - position - 1) * sizeof(int));
+            --size;
+        }
+        else if(op == 5 && size < 2000){
+            CU_ASSERT_EQUAL(ioopm_linked_list_prepend(list, int_elem(i)), IOOPM_SUCCESS);
+            memmove(expected + 1, expected, size * sizeof(int));
+            expected[0] = i;
+            ++size;
+        }
+        else if(op == 6 && size > 0){
+            CU_ASSERT_EQUAL(ioopm_linked_list_remove(list, 0, &value), IOOPM_SUCCESS);
+            CU_ASSERT_EQUAL(value.intValue, expected[0]);
+            memmove(expected, expected + 1, (size - 1) * sizeof(int));
+            --size;
+        }
+        else if(op == 7 && size < 2000){
+            CU_ASSERT_EQUAL(ioopm_linked_list_append(list, int_elem(i)), IOOPM_SUCCESS);
+            expected[size++] = i;
+        }
+        else if(position < size){
+            CU_ASSERT_EQUAL(ioopm_linked_list_get(list, position, &value), IOOPM_SUCCESS);
+            CU_ASSERT_EQUAL(value.intValue, expected[position]);
+            ++position;
+        }
+
+        if(i == 10000){
+            ioopm_linked_list_clear(list);
+            size = 0;
+        }
+    }
+
+    for(size_t i = 0; i < size; ++i){
+        elem_t value;
+        CU_ASSERT_EQUAL(ioopm_linked_list_get(list, i, &value), IOOPM_SUCCESS);
+        CU_ASSERT_EQUAL(value.intValue, expected[i]);
+    }
+
+    ioopm_linked_list_destroy(list);
+}
+
+void test_sequential_access(){
+    check_sequential_access(IOOPM_LIST_NODES);
+    check_sequential_access(IOOPM_LIST_UNROLLED);
+    check_sequential_access(IOOPM_LIST_ARRAY);
+    check_sequential_access(IOOPM_LIST_SKIP);
+    check_sequential_access(IOOPM_LIST_DEQUE);
+}
+
+
+/// @brief Compares elements by intValue / 100000 only, so elements with the same key compare equal.
+static int cmp_key(elem_t a, elem_t b){
+    int key_a = a.intValue / 100000;
+    int key_b = b.intValue / 100000;
+    return (key_a > key_b) - (key_a < key_b);
+}
+
+/// @brief Sorts lists of a given storage and checks that they are sorted and stable.
+static void check_sort(ioopm_list_storage_t storage){
+    size_t sizes[] = {0, 1, 2, 17, 1000, 10007};
+    srand(45);
+
+    for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s){
+        ioopm_list_t *list = ioopm_linked_list_create_with_storage(elem_eq, storage);
+
+        // Keys repeat; the last five digits count up, so a stable sort keeps them increasing per key
+        for(size_t i = 0; i < sizes[s]; ++i){
+            ioopm_linked_list_append(list, int_elem((rand() % 50) * 100000 + (int)i));
+        }
+        CU_ASSERT_EQUAL(ioopm_linked_list_sort(list, cmp_key), IOOPM_SUCCESS);
+
+        size_t size = 0;
+        ioopm_linked_list_size(list, &size);
+        CU_ASSERT_EQUAL(size, sizes[s]);
+        elem_t previous, current;
+        for(size_t i = 1; i < size; ++i){
+            ioopm_linked_list_get(list, i - 1, &previous);
+            ioopm_linked_list_get(list, i, &current);
+            CU_ASSERT_TRUE(cmp_key(previous, current) < 0 ||
+                           (cmp_key(previous, current) == 0 && previous.intValue < current.intValue));
+        }
+
+        // The tail must be the last sorted element for appending to work
+        CU_ASSERT_EQUAL(ioopm_linked_list_append(list, int_elem(-1)), IOOPM_SUCCESS);
+        CU_ASSERT_EQUAL(ioopm_linked_list_get(list, size, &current), IOOPM_SUCCESS);
+        CU_ASSERT_EQUAL(current.intValue, -1);
+
+        ioopm_linked_list_destroy(list);
+    }
+}
+
+void test_sort(){
+    CU_ASSERT_EQUAL(ioopm_linked_list_sort(NULL, cmp_key), IOOPM_ERROR_NULL_LIST);
+    ioopm_list_t *list = ioopm_linked_list_create(elem_eq);
+    CU_ASSERT_EQUAL(ioopm_linked_list_sort(list, NULL), IOOPM_ERROR_NULL_FUNCTION);
+    ioopm_linked_list_destroy(list);
+
+    check_sort(IOOPM_LIST_NODES);
+    check_sort(IOOPM_LIST_UNROLLED);
+    check_sort(IOOPM_LIST_ARRAY);
+    check_sort(IOOPM_LIST_SKIP);
+    check_sort(IOOPM_LIST_DEQUE);
+}
+
+
+/// @brief Splices a list into another at several indices and checks the result against an array.
+static void check_splice(ioopm_list_storage_t dst_storage, ioopm_list_storage_t src_storage){
+    size_t dst_sizes[] = {0, 1, 30, 100};
+    size_t src_sizes[] = {0, 1, 40};
+    int expected[200];
+
+    for(size_t d = 0; d < sizeof(dst_sizes) / sizeof(dst_sizes[0]); ++d){
+        for(size_t s = 0; s < sizeof(src_sizes) / sizeof(src_sizes[0]); ++s){
+            size_t indices[] = {0, dst_sizes[d] / 3, dst_sizes[d]};
+            for(size_t k = 0; k < 3; ++k){
+                ioopm_list_t *dst = ioopm_linked_list_create_with_storage(elem_eq, dst_storage);
+                ioopm_list_t *src = ioopm_linked_list_create_with_storage(elem_eq, src_storage);
+                size_t index = indices[k];
+                size_t size = 0;
+
+                for(size_t i = 0; i < dst_sizes[d]; ++i){
+                    ioopm_linked_list_append(dst, int_elem(i));
+                    // Removing some elements leaves spare nodes and partly filled chunks behind
+                    if(i % 7 == 3) ioopm_linked_list_remove(dst, i / 2, NULL);
+                }
+                for(size_t i = 0; i < src_sizes[s]; ++i){
+                    ioopm_linked_list_append(src, int_elem(1000 + i));
+                    if(i % 5 == 2) ioopm_linked_list_remove(src, 0, NULL);
+                }
+
+                ioopm_linked_list_size(dst, &size);
+                if(index > size) index = size;
+                for(size_t i = 0; i < size; ++i){
+                    elem_t value;
+                    ioopm_linked_list_get(dst, i, &value);
+                    expected[i] = value.intValue;
+                }
+                size_t src_size = 0;
+                ioopm_linked_list_size(src, &src_size);
+                memmove(expected + index + src_size, expected + index, (size - index) * sizeof(int));
+                for(size_t i = 0; i < src_size; ++i){
+                    elem_t value;
+                    ioopm_linked_list_get(src, i, &value);
+                    expected[index + i] = value.intValue;
+                }
+
+                CU_ASSERT_EQUAL(ioopm_linked_list_splice(dst, index, src), IOOPM_SUCCESS);
+
+                // src is empty and usable, and dst keeps its nodes after src is gone
+                bool empty = false;
+                CU_ASSERT_EQUAL(ioopm_linked_list_is_empty(src, &empty), IOOPM_SUCCESS);
+                CU_ASSERT_TRUE(empty);
+                CU_ASSERT_EQUAL(ioopm_linked_list_append(src, int_elem(-1)), IOOPM_SUCCESS);
+                ioopm_linked_list_destroy(src);
+
+                CU_ASSERT_EQUAL(ioopm_linked_list_append(dst, int_elem(-2)), IOOPM_SUCCESS);
+                expected[size + src_size] = -2;
+                size_t new_size = 0;
+                ioopm_linked_list_size(dst, &new_size);
+                CU_ASSERT_EQUAL(new_size, size + src_size + 1);
+                for(size_t i = 0; i < new_size; ++i){
+                    elem_t value;
+                    CU_ASSERT_EQUAL(ioopm_linked_list_get(dst, i, &value), IOOPM_SUCCESS);
+                    CU_ASSERT_EQUAL(value.intValue, expected[i]);
+                }
+
+                ioopm_linked_list_destroy(dst);
+            }
+        }
+    }
+}
+
+void test_splice(){
+    ioopm_list_storage_t storages[] = {IOOPM_LIST_NODES, IOOPM_LIST_UNROLLED, IOOPM_LIST_ARRAY, IOOPM_LIST_SKIP,
+                                       IOOPM_LIST_DEQUE};
+    for(size_t i = 0; i < 5; ++i){
+        for(size_t j = 0; j < 5; ++j){
+            check_splice(storages[i], storages[j]);
+        }
+    }
+
+    ioopm_list_t *list = ioopm_linked_list_create(elem_eq);
+    ioopm_linked_list_append(list, int_elem(1));
+    CU_ASSERT_EQUAL(ioopm_linked_list_splice(list, 0, list), IOOPM_ERROR_SAME_LIST);
+    CU_ASSERT_EQUAL(ioopm_linked_list_splice(NULL, 0, list), IOOPM_ERROR_NULL_LIST);
+    CU_ASSERT_EQUAL(ioopm_linked_list_splice(list, 0, NULL), IOOPM_ERROR_NULL_LIST);
+
+    ioopm_list_t *other = ioopm_linked_list_create(elem_eq);
+    CU_ASSERT_EQUAL(ioopm_linked_list_splice(list, 2, other), IOOPM_ERROR_INVALID_INDEX);
+    ioopm_linked_list_destroy(other);
+    ioopm_linked_list_destroy(list);
+}
+
+void test_concat(){
+    // Fan-in of partial results: every worker list is moved to the end of the total
+    ioopm_list_t *total = ioopm_linked_list_create(elem_eq);
+    for(int worker = 0; worker < 10; ++worker){
+        ioopm_list_t *partial = ioopm_linked_list_create(elem_eq);
+        for(int i = 0; i < 100; ++i){
+            ioopm_linked_list_append(partial, int_elem(worker * 100 + i));
+        }
+        CU_ASSERT_EQUAL(ioopm_linked_list_concat(total, partial), IOOPM_SUCCESS);
+        ioopm_linked_list_destroy(partial);
+    }
+
+    size_t size = 0;
+    ioopm_linked_list_size(total, &size);
+    CU_ASSERT_EQUAL(size, 1000);
+    for(size_t i = 0; i < size; ++i){
+        elem_t value;
+        ioopm_linked_list_get(total, i, &value);
+        CU_ASSERT_EQUAL(value.intValue, i);
+    }
+
+    // The spare nodes of both lists are joined and reused by the prepends below
+    ioopm_list_t *spare = ioopm_linked_list_create(elem_eq);
+    for(int i = 0; i < 1000; ++i){
+        ioopm_linked_list_append(spare, int_elem(i));
+    }
+    elem_t removed;
+    for(int i = 0; i < 10; ++i){
+        ioopm_linked_list_remove(total, 0, &removed);
+        ioopm_linked_list_remove(spare, 0, &removed);
+    }
+    CU_ASSERT_EQUAL(ioopm_linked_list_concat(total, spare), IOOPM_SUCCESS);
+    ioopm_linked_list_destroy(spare);
+    for(int i = 0; i < 20; ++i){
+        ioopm_linked_list_prepend(total, int_elem(-1));
+    }
+    ioopm_linked_list_size(total, &size);
+    CU_ASSERT_EQUAL(size, 2000);
+    ioopm_linked_list_get(total, 1999, &removed);
+    CU_ASSERT_EQUAL(removed.intValue, 999);
+
+    CU_ASSERT_EQUAL(ioopm_linked_list_concat(total, total), IOOPM_ERROR_SAME_LIST);
+    CU_ASSERT_EQUAL(ioopm_linked_list_concat(NULL, total), IOOPM_ERROR_NULL_LIST);
+    ioopm_linked_list_destroy(total);
+}
+
+
+/// @brief Builds a list from arrays and reads it back in buffers, checking every element.
+static void check_bulk_arrays(ioopm_list_storage_t storage){
+    size_t no_elements = 1000;
+    elem_t *elements = malloc(no_elements * sizeof(elem_t));
+    for(size_t i = 0; i < no_elements; ++i){
+        elements[i] = int_elem(i);
+    }
+
+    ioopm_list_t *list = ioopm_linked_list_from_array(elem_eq, storage, elements, 10);
+    CU_ASSERT_PTR_NOT_NULL(list);
+
+    // Spare nodes and a partly filled last chunk are there when the batches arrive
+    ioopm_linked_list_remove(list, 9, NULL);
+    ioopm_linked_list_append(list, int_elem(9));
+    for(size_t i = 10; i < no_elements; i += 37){
+        size_t count = no_elements - i < 37 ? no_elements - i : 37;
+        CU_ASSERT_EQUAL(ioopm_linked_list_append_array(list, elements + i, count), IOOPM_SUCCESS);
+    }
+    CU_ASSERT_EQUAL(ioopm_linked_list_append_array(list, NULL, 0), IOOPM_SUCCESS);
+
+    // Single elements still go after the batches
+    ioopm_linked_list_append(list, int_elem(no_elements));
+    ioopm_linked_list_insert(list, 500, int_elem(-1));
+    ioopm_linked_list_remove(list, 500, NULL);
+
+    size_t size = 0;
+    ioopm_linked_list_size(list, &size);
+    CU_ASSERT_EQUAL(size, no_elements + 1);
+
+    elem_t buffer[37];
+    size_t start = 0;
+    size_t copied = 0;
+    do{
+        CU_ASSERT_EQUAL(ioopm_linked_list_copy_range(list, start, 37, buffer, &copied), IOOPM_SUCCESS);
+        for(size_t i = 0; i < copied; ++i){
+            CU_ASSERT_EQUAL(buffer[i].intValue, start + i);
+        }
+        start += copied;
+    } while(copied == 37);
+    CU_ASSERT_EQUAL(start, no_elements + 1);
+    CU_ASSERT_EQUAL(ioopm_linked_list_copy_range(list, size + 1, 37, buffer, &copied), IOOPM_ERROR_INVALID_INDEX);
+
+    elem_t *array = NULL;
+    CU_ASSERT_EQUAL(ioopm_linked_list_to_array(list, &array, &size), IOOPM_SUCCESS);
+    CU_ASSERT_EQUAL(size, no_elements + 1);
+    for(size_t i = 0; i < size; ++i){
+        CU_ASSERT_EQUAL(array[i].intValue, i);
+    }
+    free(array);
+
+    ioopm_linked_list_clear(list);
+    CU_ASSERT_EQUAL(ioopm_linked_list_to_array(list, &array, &size), IOOPM_SUCCESS);
+    CU_ASSERT_PTR_NULL(array);
+    CU_ASSERT_EQUAL(size, 0);
+
+    ioopm_linked_list_destroy(list);
+    free(elements);
+}
+
+void test_bulk_arrays(){
+    check_bulk_arrays(IOOPM_LIST_NODES);
+    check_bulk_arrays(IOOPM_LIST_UNROLLED);
+    check_bulk_arrays(IOOPM_LIST_ARRAY);
+    check_bulk_arrays(IOOPM_LIST_SKIP);
+    check_bulk_arrays(IOOPM_LIST_DEQUE);
+
+    ioopm_list_t *empty = ioopm_linked_list_from_array(elem_eq, IOOPM_LIST_NODES, NULL, 0);
+    CU_ASSERT_PTR_NOT_NULL(empty);
+    CU_ASSERT_EQUAL(ioopm_linked_list_append_array(empty, NULL, 1), IOOPM_ERROR_NULL_PROPERTY);
+    ioopm_linked_list_destroy(empty);
+    CU_ASSERT_EQUAL(ioopm_linked_list_append_array(NULL, NULL, 0), IOOPM_ERROR_NULL_LIST);
+}
+
+
+/// @brief Inserts random values in sorted order and checks the order, stability and returned indices.
+static void check_insert_sorted(ioopm_list_storage_t storage){
+    ioopm_list_t *list = ioopm_linked_list_create_with_storage(elem_eq, storage);
+    srand(48);
+
+    // Keys repeat; the last five digits count up, so equal keys must stay in insertion order
+    for(int i = 0; i < 3000; ++i){
+        elem_t value = int_elem((rand() % 100) * 100000 + i);
+        size_t index = 0;
+        CU_ASSERT_EQUAL(ioopm_linked_list_insert_sorted(list, value, cmp_key, &index), IOOPM_SUCCESS);
+
+        elem_t stored;
+        ioopm_linked_list_get(list, index, &stored);
+        CU_ASSERT_EQUAL(stored.intValue, value.intValue);
+
+        // Removing now and then keeps the list sorted
+        if(i % 7 == 0){
+            ioopm_linked_list_remove(list, index / 2, NULL);
+        }
+    }
+
+    size_t size = 0;
+    ioopm_linked_list_size(list, &size);
+    CU_ASSERT_EQUAL(size, 3000 - 3000 / 7 - 1);
+    elem_t previous, current;
+    for(size_t i = 1; i < size; ++i){
+        ioopm_linked_list_get(list, i - 1, &previous);
+        ioopm_linked_list_get(list, i, &current);
+        CU_ASSERT_TRUE(cmp_key(previous, current) < 0 ||
+                       (cmp_key(previous, current) == 0 && previous.intValue < current.intValue));
+    }
+
+    ioopm_linked_list_destroy(list);
+}
+
+void test_insert_sorted(){
+    check_insert_sorted(IOOPM_LIST_NODES);
+    check_insert_sorted(IOOPM_LIST_UNROLLED);
+    check_insert_sorted(IOOPM_LIST_ARRAY);
+    check_insert_sorted(IOOPM_LIST_SKIP);
+    check_insert_sorted(IOOPM_LIST_DEQUE);
+
+    ioopm_list_t *list = ioopm_linked_list_create(elem_eq);
+    CU_ASSERT_EQUAL(ioopm_linked_list_insert_sorted(list, int_elem(1), NULL, NULL), IOOPM_ERROR_NULL_FUNCTION);
+    CU_ASSERT_EQUAL(ioopm_linked_list_insert_sorted(NULL, int_elem(1), cmp_key, NULL), IOOPM_ERROR_NULL_LIST);
+    ioopm_linked_list_destroy(list);
+}
+
+/// @brief Fills a skip list at random indices, empties it from both ends and fills it again.
+void test_skip_list_levels(){
+    ioopm_list_t *list = ioopm_linked_list_create_with_storage(elem_eq, IOOPM_LIST_SKIP);
+    int *expected = malloc(20000 * sizeof(int));
+
+    for(int round = 0; round < 2; ++round){
+        size_t size = 0;
+        for(int i = 0; i < 20000; ++i){
+            size_t index = (size_t)i * 7919 % (size + 1);
+            memmove(expected + index + 1, expected + index, (size - index) * sizeof(int));
+            expected[index] = i;
+            CU_ASSERT_EQUAL(ioopm_linked_list_insert(list, index, int_elem(i)), IOOPM_SUCCESS);
+            ++size;
+        }
+
+        for(size_t i = 0; i < size; i += 97){
+            elem_t value;
+            CU_ASSERT_EQUAL(ioopm_linked_list_get(list, i, &value), IOOPM_SUCCESS);
+            CU_ASSERT_EQUAL(value.intValue, expected[i]);
+        }
+
+        // The levels above the remaining nodes are dropped as the list shrinks
+        size_t first = 0;
+        while(size > 0){
+            elem_t value;
+            if(size % 2){
+                CU_ASSERT_EQUAL(ioopm_linked_list_remove(list, 0, &value), IOOPM_SUCCESS);
+                CU_ASSERT_EQUAL(value.intValue, expected[first++]);
+            }
+            else{
+                CU_ASSERT_EQUAL(ioopm_linked_list_remove(list, size - 1, &value), IOOPM_SUCCESS);
+                CU_ASSERT_EQUAL(value.intValue, expected[first + size - 1]);
+            }
+            --size;
+        }
+        CU_ASSERT_EQUAL(list->skip_levels, 1);
+    }
+
+    free(expected);
+    ioopm_linked_list_destroy(list);
+}
+
+
+/// @brief Uses a deque list as a queue and as a stack while its ring wraps around, against an array.
+void test_deque_ends(){
+    ioopm_list_t *list = ioopm_linked_list_create_with_storage(elem_eq, IOOPM_LIST_DEQUE);
+    int expected[4096];
+    size_t first = 2048;
+    size_t size = 0;
+    srand(49);
+
+    for(int i = 0; i < 100000; ++i){
+        int op = rand() % 4;
+        elem_t value;
+
+        // Pushing slightly more often than popping makes the ring grow while it is wrapped
+        if(op == 0 && first + size < 4096){
+            CU_ASSERT_EQUAL(ioopm_linked_list_append(list, int_elem(i)), IOOPM_SUCCESS);
+            expected[first + size++] = i;
+        }
+        else if(op == 1 && first > 0){
+            CU_ASSERT_EQUAL(ioopm_linked_list_prepend(list, int_elem(i)), IOOPM_SUCCESS);
+            expected[--first] = i;
+            ++size;
+        }
+        else if(op == 2 && size > 0 && rand() % 8){
+            CU_ASSERT_EQUAL(ioopm_linked_list_remove(list, 0, &value), IOOPM_SUCCESS);
+            CU_ASSERT_EQUAL(value.intValue, expected[first++]);
+            --size;
+        }
+        else if(op == 3 && size > 0 && rand() % 8){
+            CU_ASSERT_EQUAL(ioopm_linked_list_remove(list, size - 1, &value), IOOPM_SUCCESS);
+            CU_ASSERT_EQUAL(value.intValue, expected[first + --size]);
+        }
+
+        if(i % 5000 == 0){
+            for(size_t j = 0; j < size; ++j){
+                ioopm_linked_list_get(list, j, &value);
+                CU_ASSERT_EQUAL(value.intValue, expected[first + j]);
+            }
+        }
+    }
+
+    size_t list_size = 0;
+    ioopm_linked_list_size(list, &list_size);
+    CU_ASSERT_EQUAL(list_size, size);
+    CU_ASSERT_EQUAL(ioopm_linked_list_reserve(list, 10000), IOOPM_SUCCESS);
+    CU_ASSERT_TRUE(list->capacity >= 10000);
+    for(size_t j = 0; j < size; ++j){
+        elem_t value;
+        ioopm_linked_list_get(list, j, &value);
+        CU_ASSERT_EQUAL(value.intValue, expected[first + j]);
+    }
+
+    ioopm_linked_list_destroy(list);
+}
+
+
+/// Number of distinct values in the hash index tests.
+#define Index_Values 300
+
+/// @brief Checks that contains agrees with the number of times every value was added to a list.
+static void assert_index_matches(ioopm_list_t *list, int *counts){
+    CU_ASSERT_PTR_NOT_NULL(list->hash_index);
+    for(int v = 0; v < Index_Values; ++v){
+        bool found = !counts[v];
+        ioopm_linked_list_contains(list, int_elem(v), &found);
+        CU_ASSERT_EQUAL(found, counts[v] > 0);
+    }
+}
+
+/// @brief Runs random operations on an indexed list, checking contains against counts of the values.
+static void check_index(ioopm_list_storage_t storage){
+    ioopm_list_t *list = ioopm_linked_list_create_with_storage(elem_eq, storage);
+    int counts[Index_Values] = {0};
+    srand(43);
+
+    // The index is built from the elements the list already holds
+    for(int i = 0; i < 100; ++i){
+        ioopm_linked_list_append(list, int_elem(i % 50));
+        counts[i % 50]++;
+    }
+    CU_ASSERT_EQUAL(ioopm_linked_list_enable_index(list, NULL), IOOPM_ERROR_NULL_FUNCTION);
+    CU_ASSERT_EQUAL(ioopm_linked_list_enable_index(list, int_hash), IOOPM_SUCCESS);
+    assert_index_matches(list, counts);
+
+    for(int i = 0; i < 5000; ++i){
+        size_t size = 0;
+        ioopm_linked_list_size(list, &size);
+        int op = rand() % 5;
+        int v = rand() % Index_Values;
+
+        if(op == 0){
+            ioopm_linked_list_append(list, int_elem(v));
+            counts[v]++;
+        }
+        else if(op == 1){
+            ioopm_linked_list_prepend(list, int_elem(v));
+            counts[v]++;
+        }
+        else if(op == 2){
+            ioopm_linked_list_insert(list, rand() % (size + 1), int_elem(v));
+            counts[v]++;
+        }
+        else if(size > 0){
+            elem_t removed;
+            ioopm_linked_list_remove(list, rand() % size, &removed);
+            counts[removed.intValue]--;
+        }
+
+        if(i % 500 == 0){
+            assert_index_matches(list, counts);
+        }
+    }
+    assert_index_matches(list, counts);
+
+    // Sorting only moves elements, so the index stays valid
+    ioopm_linked_list_sort(list, cmp_key);
+    assert_index_matches(list, counts);
+
+    ioopm_linked_list_clear(list);
+    memset(counts, 0, sizeof(counts));
+    assert_index_matches(list, counts);
+
+    elem_t values[40];
+    for(int i = 0; i < 40; ++i){
+        values[i] = int_elem(i % 20);
+        counts[i % 20]++;
+    }
+    CU_ASSERT_EQUAL(ioopm_linked_list_append_array(list, values, 40), IOOPM_SUCCESS);
+    ioopm_linked_list_insert_sorted(list, int_elem(7), cmp_key, NULL);
+    counts[7]++;
+    assert_index_matches(list, counts);
+
+    // apply_to_all may change every element, so the index follows the new values
+    elem_t factor = int_elem(3);
+    ioopm_linked_list_apply_to_all(list, multiply_value, &factor);
+    int tripled[Index_Values] = {0};
+    for(int v = 0; v * 3 < Index_Values; ++v){
+        tripled[v * 3] = counts[v];
+    }
+    assert_index_matches(list, tripled);
+    memcpy(counts, tripled, sizeof(counts));
+
+    // Elements spliced in from lists of every storage are added to the index; src is emptied
+    ioopm_list_storage_t storages[] = {IOOPM_LIST_NODES, IOOPM_LIST_UNROLLED, IOOPM_LIST_ARRAY, IOOPM_LIST_SKIP, IOOPM_LIST_DEQUE};
+    for(int j = 0; j < 5; ++j){
+        ioopm_list_t *src = ioopm_linked_list_from_array(elem_eq, storages[j], values, 40);
+        ioopm_linked_list_enable_index(src, int_hash);
+        CU_ASSERT_EQUAL(ioopm_linked_list_splice(list, j, src), IOOPM_SUCCESS);
+        for(int i = 0; i < 40; ++i){
+            counts[values[i].intValue]++;
+        }
+        assert_index_matches(list, counts);
+
+        bool found = true;
+        ioopm_linked_list_contains(src, values[0], &found);
+        CU_ASSERT_FALSE(found);
+        CU_ASSERT_PTR_NOT_NULL(src->hash_index);
+        ioopm_linked_list_destroy(src);
+    }
+
+    // Without the index contains scans, with the same results
+    CU_ASSERT_EQUAL(ioopm_linked_list_disable_index(list), IOOPM_SUCCESS);
+    CU_ASSERT_PTR_NULL(list->hash_index);
+    for(int v = 0; v < Index_Values; ++v){
+        bool found = false;
+        ioopm_linked_list_contains(list, int_elem(v), &found);
+        CU_ASSERT_EQUAL(found, counts[v] > 0);
+    }
+
+    ioopm_linked_list_destroy(list);
+}
+
+void test_index(){
+    CU_ASSERT_EQUAL(ioopm_linked_list_enable_index(NULL, int_hash), IOOPM_ERROR_NULL_LIST);
+    CU_ASSERT_EQUAL(ioopm_linked_list_disable_index(NULL), IOOPM_ERROR_NULL_LIST);
+
+    check_index(IOOPM_LIST_NODES);
+    check_index(IOOPM_LIST_UNROLLED);
+    check_index(IOOPM_LIST_ARRAY);
+    check_index(IOOPM_LIST_SKIP);
+    check_index(IOOPM_LIST_DEQUE);
+}
+
+
 /*
  * =========================================
  * SECTION: Main
@@ -482,6 +1303,20 @@ int main() {
     (CU_add_test(my_test_suite, "Apply all NULL function", test_apply_all_NULL_function) == NULL) ||
     (CU_add_test(my_test_suite, "Apply all empty list", test_apply_all_empty_list) == NULL) ||
     (CU_add_test(my_test_suite, "Apply all", test_apply_all) == NULL) ||
+    (CU_add_test(my_test_suite, "Random operations on unrolled and array lists", test_random_operations) == NULL) ||
+    (CU_add_test(my_test_suite, "Traversal of unrolled and array lists", test_traversal) == NULL) ||
+    (CU_add_test(my_test_suite, "Array reserve", test_array_reserve) == NULL) ||
+    (CU_add_test(my_test_suite, "Unrolled clear", test_unrolled_clear) == NULL) ||
+    (CU_add_test(my_test_suite, "Node reuse", test_node_reuse) == NULL) ||
+    (CU_add_test(my_test_suite, "Sequential access", test_sequential_access) == NULL) ||
+    (CU_add_test(my_test_suite, "Sort", test_sort) == NULL) ||
+    (CU_add_test(my_test_suite, "Splice", test_splice) == NULL) ||
+    (CU_add_test(my_test_suite, "Concat", test_concat) == NULL) ||
+    (CU_add_test(my_test_suite, "Bulk arrays", test_bulk_arrays) == NULL) ||
+    (CU_add_test(my_test_suite, "Insert sorted", test_insert_sorted) == NULL) ||
+    (CU_add_test(my_test_suite, "Skip list levels", test_skip_list_levels) == NULL) ||
+    (CU_add_test(my_test_suite, "Deque ends", test_deque_ends) == NULL) ||
+    (CU_add_test(my_test_suite, "Hash index", test_index) == NULL) ||
     0
   )
     {
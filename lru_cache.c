@@ -0,0 +1,238 @@
+// lru_cache.c
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "lru_cache.h"
+
+/*
+ * =========================================
+ * SECTION: Custom Data Types And Aliases
+ * =========================================
+ */
+
+typedef struct lru_node lru_node_t;
+
+/// An entry, linked into the recency list.
+struct lru_node
+{
+  elem_t key;
+  elem_t value;
+  size_t cost;
+  lru_node_t *prev;
+  lru_node_t *next;
+};
+
+/// The recency list is circular around a sentinel: sentinel.next is the most
+/// recently used entry and sentinel.prev the least recently used one.
+struct lru_cache
+{
+  ioopm_hash_table_t *index;          /// Maps a key to its node.
+  lru_node_t sentinel;
+  size_t size;
+  size_t usage;
+  size_t capacity;
+  ioopm_size_function value_size_func;
+  ioopm_evict_function evict_func;
+  void *evict_arg;
+  size_t hits;
+  size_t misses;
+  size_t evictions;
+};
+
+
+/*
+ * =========================================
+ * SECTION: Function Definitions
+ * =========================================
+ */
+
+/// @brief Unlinks a node from the recency list.
+/// @param node The node to unlink.
+static void node_unlink(lru_node_t *node){
+  node->prev->next = node->next;
+  node->next->prev = node->prev;
+}
+
+/// @brief Links a node in as the most recently used one.
+/// @param cache The cache.
+/// @param node The node to link in.
+static void node_push_front(ioopm_lru_cache_t *cache, lru_node_t *node){
+  node->prev = &cache->sentinel;
+  node->next = cache->sentinel.next;
+  cache->sentinel.next->prev = node;
+  cache->sentinel.next = node;
+}
+
+/// @brief Removes a node from the cache and frees it, passing its entry to the eviction callback if asked to.
+/// @param cache The cache.
+/// @param node The node to remove.
+/// @param notify Whether to call the eviction callback.
+static void node_remove(ioopm_lru_cache_t *cache, lru_node_t *node, bool notify){
+  ioopm_hash_table_remove(cache->index, node->key);
+  node_unlink(node);
+  cache->size--;
+  cache->usage -= node->cost;
+
+  if(notify && cache->evict_func) cache->evict_func(node->key, node->value, cache->evict_arg);
+  free(node);
+}
+
+/// @brief Finds the node of a key.
+/// @param cache The cache.
+/// @param key The key to find.
+/// @return The node, or NULL if the key is not in the cache.
+static lru_node_t *node_find(ioopm_lru_cache_t *cache, elem_t key){
+  option_t found = ioopm_hash_table_lookup(cache->index, key);
+  return Successful(found) ? found.value.ptrValue : NULL;
+}
+
+
+ioopm_lru_cache_t *ioopm_lru_cache_create(ioopm_hash_function hash_func, ioopm_eq_function key_eq_func,
+                                          size_t capacity, ioopm_size_function value_size_func){
+  if(capacity == 0) return NULL;
+
+  ioopm_lru_cache_t *cache = calloc(1, sizeof(ioopm_lru_cache_t));
+  if(!cache) return NULL;
+
+  cache->index = ioopm_hash_table_create(hash_func, key_eq_func, NULL);
+  if(!cache->index){
+    free(cache);
+    return NULL;
+  }
+
+  cache->sentinel.prev = &cache->sentinel;
+  cache->sentinel.next = &cache->sentinel;
+  cache->capacity = capacity;
+  cache->value_size_func = value_size_func;
+
+  return cache;
+}
+
+void ioopm_lru_cache_destroy(ioopm_lru_cache_t *cache){
+  if(!cache) return;
+
+  ioopm_lru_cache_clear(cache);
+  ioopm_hash_table_destroy(cache->index);
+  free(cache);
+}
+
+void ioopm_lru_cache_set_evict_function(ioopm_lru_cache_t *cache, ioopm_evict_function evict_func, void *extra){
+  if(!cache) return;
+
+  cache->evict_func = evict_func;
+  cache->evict_arg = extra;
+}
+
+option_t ioopm_lru_cache_get(ioopm_lru_cache_t *cache, elem_t key){
+  if(!cache) return Failure();
+
+  lru_node_t *node = node_find(cache, key);
+  if(!node){
+    cache->misses++;
+    return Failure();
+  }
+
+  cache->hits++;
+  node_unlink(node);
+  node_push_front(cache, node);
+  return Success(node->value);
+}
+
+option_t ioopm_lru_cache_peek(ioopm_lru_cache_t *cache, elem_t key){
+  if(!cache) return Failure();
+
+  lru_node_t *node = node_find(cache, key);
+  return node ? Success(node->value) : Failure();
+}
+
+bool ioopm_lru_cache_put(ioopm_lru_cache_t *cache, elem_t key, elem_t value){
+  if(!cache) return false;
+
+  size_t cost = cache->value_size_func ? cache->value_size_func(value) : 1;
+  if(cost > cache->capacity) return false;
+
+  lru_node_t *node = calloc(1, sizeof(lru_node_t));
+  if(!node) return false;
+
+  // The index is updated before anything leaves the cache, so a failure leaves it unchanged
+  option_t replaced = ioopm_hash_table_replace(cache->index, key, ptr_elem(node));
+  if(Unsuccessful(replaced)){
+    size_t size_before = ioopm_hash_table_size(cache->index);
+    ioopm_hash_table_insert(cache->index, key, ptr_elem(node));
+    if((size_t)ioopm_hash_table_size(cache->index) == size_before){
+      free(node);
+      return false;
+    }
+  }
+
+  node->key = key;
+  node->value = value;
+  node->cost = cost;
+
+  if(Successful(replaced)){
+    lru_node_t *old = replaced.value.ptrValue;
+    node_unlink(old);
+    cache->size--;
+    cache->usage -= old->cost;
+    if(cache->evict_func) cache->evict_func(old->key, old->value, cache->evict_arg);
+    free(old);
+  }
+
+  while(cache->usage + cost > cache->capacity){
+    node_remove(cache, cache->sentinel.prev, true);
+    cache->evictions++;
+  }
+
+  node_push_front(cache, node);
+  cache->size++;
+  cache->usage += cost;
+
+  return true;
+}
+
+option_t ioopm_lru_cache_remove(ioopm_lru_cache_t *cache, elem_t key){
+  if(!cache) return Failure();
+
+  lru_node_t *node = node_find(cache, key);
+  if(!node) return Failure();
+
+  elem_t value = node->value;
+  node_remove(cache, node, false);
+  return Success(value);
+}
+
+void ioopm_lru_cache_clear(ioopm_lru_cache_t *cache){
+  if(!cache) return;
+
+  while(cache->size > 0){
+    node_remove(cache, cache->sentinel.prev, true);
+  }
+}
+
+size_t ioopm_lru_cache_size(ioopm_lru_cache_t *cache){
+  return cache ? cache->size : 0;
+}
+
+size_t ioopm_lru_cache_usage(ioopm_lru_cache_t *cache){
+  return cache ? cache->usage : 0;
+}
+
+ioopm_lru_stats_t ioopm_lru_cache_stats(ioopm_lru_cache_t *cache){
+  ioopm_lru_stats_t stats = {0};
+  if(!cache) return stats;
+
+  stats.hits = cache->hits;
+  stats.misses = cache->misses;
+  stats.evictions = cache->evictions;
+
+  size_t gets = cache->hits + cache->misses;
+  stats.hit_rate = gets > 0 ? (double)cache->hits / gets : 0;
+  return stats;
+}
@@ -0,0 +1,126 @@
+// lru_cache.h
+
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+/**
+ * @file lru_cache.h
+ * @brief Bounded cache that evicts the least recently used entry.
+ *
+ * Entries are nodes of an intrusive doubly-linked recency list, ordered from
+ * most to least recently used, and a hash table maps every key to its node.
+ * A get moves the node to the front of the list and an eviction unlinks the
+ * node at the back, so get, put, remove and evict are all O(1).
+ *
+ * The capacity is a number of entries, or a number of bytes if a size
+ * function is given: every entry then costs the size of its value. The cache
+ * does not own keys or values; an eviction callback is told about every
+ * entry that leaves the cache on its own, e.g. to free it.
+ */
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include "hash_table.h"
+
+/*
+ * =========================================
+ * SECTION: Custom Data Types And Aliases
+ * =========================================
+ */
+
+typedef struct lru_cache ioopm_lru_cache_t;
+typedef struct lru_stats ioopm_lru_stats_t;
+
+/// @brief Hit and miss counts of a cache.
+struct lru_stats
+{
+  size_t hits;        /// Gets that found their key.
+  size_t misses;      /// Gets that did not.
+  size_t evictions;   /// Entries evicted to make room for new ones.
+  double hit_rate;    /// hits / (hits + misses), 0 before the first get.
+};
+
+
+/*
+ * =========================================
+ * SECTION: Function Declarations
+ * =========================================
+ */
+
+/// @brief Create a new, empty cache.
+/// @param hash_func Function used to hash keys.
+/// @param key_eq_func Function used to compare keys for equality.
+/// @param capacity Maximum total cost of the entries in the cache.
+/// @param value_size_func Returns the cost of a value in bytes, or NULL to let every entry cost 1,
+///                        so that capacity is a number of entries.
+/// @return A new cache, or NULL if capacity is 0 or memory allocation fails.
+ioopm_lru_cache_t *ioopm_lru_cache_create(ioopm_hash_function hash_func, ioopm_eq_function key_eq_func,
+                                          size_t capacity, ioopm_size_function value_size_func);
+
+/// @brief Delete a cache, passing every remaining entry to the eviction callback.
+/// @param cache The cache to delete.
+void ioopm_lru_cache_destroy(ioopm_lru_cache_t *cache);
+
+/// @brief Set the function called for every entry that leaves the cache without being returned:
+///        evicted to make room, replaced by ioopm_lru_cache_put, cleared or destroyed.
+/// @param cache Cache operated upon.
+/// @param evict_func The callback, or NULL for none.
+/// @param extra Extra argument passed to evict_func.
+void ioopm_lru_cache_set_evict_function(ioopm_lru_cache_t *cache, ioopm_evict_function evict_func, void *extra);
+
+/// @brief Lookup the value for a key and mark the entry as most recently used.
+/// @param cache Cache operated upon.
+/// @param key Key to look up.
+/// @return Success with the value on a hit, Failure on a miss; both are counted in the stats.
+option_t ioopm_lru_cache_get(ioopm_lru_cache_t *cache, elem_t key);
+
+/// @brief Lookup the value for a key without changing its recency or the stats.
+/// @param cache Cache operated upon.
+/// @param key Key to look up.
+/// @return Success with the value if the key is present, Failure otherwise.
+option_t ioopm_lru_cache_peek(ioopm_lru_cache_t *cache, elem_t key);
+
+/// @brief Add an entry as the most recently used one, evicting least recently used entries until it fits.
+/// @param cache Cache operated upon.
+/// @param key Key to insert.
+/// @param value Value to insert.
+/// @return true on success, false if the value alone exceeds the capacity (the cache is then unchanged)
+///         or memory allocation fails.
+/// @note An entry with an equal key is replaced, key and value, and passed to the eviction callback.
+bool ioopm_lru_cache_put(ioopm_lru_cache_t *cache, elem_t key, elem_t value);
+
+/// @brief Remove an entry without calling the eviction callback.
+/// @param cache Cache operated upon.
+/// @param key Key to remove.
+/// @return Success with the removed value if the key was present, Failure otherwise.
+option_t ioopm_lru_cache_remove(ioopm_lru_cache_t *cache, elem_t key);
+
+/// @brief Remove all entries, passing them to the eviction callback. The stats are kept.
+/// @param cache Cache operated upon.
+void ioopm_lru_cache_clear(ioopm_lru_cache_t *cache);
+
+/// @brief Returns the number of entries in the cache.
+/// @param cache Cache operated upon.
+/// @return The number of entries.
+size_t ioopm_lru_cache_size(ioopm_lru_cache_t *cache);
+
+/// @brief Returns the total cost of the entries in the cache.
+/// @param cache Cache operated upon.
+/// @return The cost in bytes, or the number of entries if the cache has no size function.
+size_t ioopm_lru_cache_usage(ioopm_lru_cache_t *cache);
+
+/// @brief Returns the hit and miss counts of a cache.
+/// @param cache Cache operated upon.
+/// @return The stats; all zero if cache is NULL.
+ioopm_lru_stats_t ioopm_lru_cache_stats(ioopm_lru_cache_t *cache);
+
+
+
+#endif // LRU_CACHE_H
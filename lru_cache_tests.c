@@ -0,0 +1,249 @@
+// lru_cache_tests.c
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include <CUnit/Basic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lru_cache.h"
+
+
+/*
+ * =========================================
+ * SECTION: Private Function Definitions
+ * =========================================
+ */
+
+/// @brief Hash function for integer keys.
+/// @param key The key to hash.
+/// @return The hash value.
+static size_t int_hash_function(elem_t key) {
+    return (size_t)key.intValue;
+}
+
+/// @brief Equality function for integer keys.
+/// @param a The first key.
+/// @param b The second key.
+/// @return true if the keys are equal.
+static bool int_eq_function(elem_t a, elem_t b) {
+    return a.intValue == b.intValue;
+}
+
+/// @brief Size function where an integer value costs its own value in bytes.
+/// @param value The value.
+/// @return The cost of the value.
+static size_t int_size_function(elem_t value) {
+    return (size_t)value.intValue;
+}
+
+/// @brief Eviction callback that records the evicted keys.
+/// @param key The evicted key.
+/// @param value The evicted value (unused).
+/// @param extra An int array, whose first element is the number of keys recorded after it.
+static void record_evicted_key(elem_t key, elem_t value, void *extra) {
+    int *evicted = extra;
+    evicted[++evicted[0]] = key.intValue;
+}
+
+/// @brief Eviction callback that frees string keys and values.
+/// @param key The evicted key.
+/// @param value The evicted value.
+/// @param extra Unused.
+static void free_evicted_strings(elem_t key, elem_t value, void *extra) {
+    free(key.ptrValue);
+    free(value.ptrValue);
+}
+
+/// @brief Equality function for string keys.
+/// @param a The first key.
+/// @param b The second key.
+/// @return true if the strings are equal.
+static bool string_eq_function(elem_t a, elem_t b) {
+    return strcmp(a.ptrValue, b.ptrValue) == 0;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Initialize and clean the suite
+ * =========================================
+ */
+
+int init_suite(void) {
+  return 0;
+}
+
+int clean_suite(void) {
+  return 0;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Tests
+ * =========================================
+ */
+
+void test_create_destroy() {
+  CU_ASSERT_PTR_NULL(ioopm_lru_cache_create(int_hash_function, int_eq_function, 0, NULL));
+
+  ioopm_lru_cache_t *cache = ioopm_lru_cache_create(int_hash_function, int_eq_function, 3, NULL);
+  CU_ASSERT_PTR_NOT_NULL(cache);
+  CU_ASSERT_EQUAL(ioopm_lru_cache_size(cache), 0);
+  CU_ASSERT(Unsuccessful(ioopm_lru_cache_get(cache, int_elem(1))));
+  ioopm_lru_cache_destroy(cache);
+}
+
+void test_evicts_least_recently_used() {
+  ioopm_lru_cache_t *cache = ioopm_lru_cache_create(int_hash_function, int_eq_function, 3, NULL);
+  int evicted[8] = {0};
+  ioopm_lru_cache_set_evict_function(cache, record_evicted_key, evicted);
+
+  for (int i = 1; i <= 3; ++i) {
+    CU_ASSERT_TRUE(ioopm_lru_cache_put(cache, int_elem(i), int_elem(i * 10)));
+  }
+
+  // Using 1 makes 2 the least recently used entry; peek does not count as a use
+  CU_ASSERT_EQUAL(ioopm_lru_cache_get(cache, int_elem(1)).value.intValue, 10);
+  CU_ASSERT(Successful(ioopm_lru_cache_peek(cache, int_elem(2))));
+  CU_ASSERT_TRUE(ioopm_lru_cache_put(cache, int_elem(4), int_elem(40)));
+
+  CU_ASSERT_EQUAL(evicted[0], 1);
+  CU_ASSERT_EQUAL(evicted[1], 2);
+  CU_ASSERT_EQUAL(ioopm_lru_cache_size(cache), 3);
+  CU_ASSERT(Unsuccessful(ioopm_lru_cache_peek(cache, int_elem(2))));
+
+  CU_ASSERT_TRUE(ioopm_lru_cache_put(cache, int_elem(5), int_elem(50)));
+  CU_ASSERT_EQUAL(evicted[2], 3);
+
+  // Replacing an entry passes the old one to the callback and makes it the most recent
+  CU_ASSERT_TRUE(ioopm_lru_cache_put(cache, int_elem(1), int_elem(11)));
+  CU_ASSERT_EQUAL(evicted[0], 3);
+  CU_ASSERT_EQUAL(evicted[3], 1);
+  CU_ASSERT_EQUAL(ioopm_lru_cache_size(cache), 3);
+  CU_ASSERT_TRUE(ioopm_lru_cache_put(cache, int_elem(6), int_elem(60)));
+  CU_ASSERT_EQUAL(evicted[4], 4);
+  CU_ASSERT_EQUAL(ioopm_lru_cache_peek(cache, int_elem(1)).value.intValue, 11);
+
+  CU_ASSERT_EQUAL(ioopm_lru_cache_stats(cache).evictions, 3);
+  ioopm_lru_cache_destroy(cache);
+  CU_ASSERT_EQUAL(evicted[0], 7);
+}
+
+void test_byte_capacity() {
+  ioopm_lru_cache_t *cache = ioopm_lru_cache_create(int_hash_function, int_eq_function, 100, int_size_function);
+
+  CU_ASSERT_TRUE(ioopm_lru_cache_put(cache, int_elem(1), int_elem(40)));
+  CU_ASSERT_TRUE(ioopm_lru_cache_put(cache, int_elem(2), int_elem(30)));
+  CU_ASSERT_TRUE(ioopm_lru_cache_put(cache, int_elem(3), int_elem(30)));
+  CU_ASSERT_EQUAL(ioopm_lru_cache_usage(cache), 100);
+
+  // Too large to ever fit: rejected without evicting anything
+  CU_ASSERT_FALSE(ioopm_lru_cache_put(cache, int_elem(4), int_elem(101)));
+  CU_ASSERT_EQUAL(ioopm_lru_cache_size(cache), 3);
+
+  // 70 bytes need both 1 and 2 to go
+  CU_ASSERT_TRUE(ioopm_lru_cache_put(cache, int_elem(4), int_elem(70)));
+  CU_ASSERT_EQUAL(ioopm_lru_cache_size(cache), 2);
+  CU_ASSERT_EQUAL(ioopm_lru_cache_usage(cache), 100);
+  CU_ASSERT(Unsuccessful(ioopm_lru_cache_peek(cache, int_elem(1))));
+  CU_ASSERT(Unsuccessful(ioopm_lru_cache_peek(cache, int_elem(2))));
+
+  CU_ASSERT_EQUAL(ioopm_lru_cache_remove(cache, int_elem(4)).value.intValue, 70);
+  CU_ASSERT_EQUAL(ioopm_lru_cache_usage(cache), 30);
+  CU_ASSERT(Unsuccessful(ioopm_lru_cache_remove(cache, int_elem(4))));
+
+  ioopm_lru_cache_clear(cache);
+  CU_ASSERT_EQUAL(ioopm_lru_cache_size(cache), 0);
+  CU_ASSERT_EQUAL(ioopm_lru_cache_usage(cache), 0);
+  ioopm_lru_cache_destroy(cache);
+}
+
+void test_hit_rate() {
+  ioopm_lru_cache_t *cache = ioopm_lru_cache_create(int_hash_function, int_eq_function, 10, NULL);
+  CU_ASSERT_EQUAL(ioopm_lru_cache_stats(cache).hit_rate, 0);
+
+  for (int i = 0; i < 20; ++i) {
+    if (Unsuccessful(ioopm_lru_cache_get(cache, int_elem(i % 5)))) {
+      ioopm_lru_cache_put(cache, int_elem(i % 5), int_elem(i));
+    }
+  }
+
+  ioopm_lru_stats_t stats = ioopm_lru_cache_stats(cache);
+  CU_ASSERT_EQUAL(stats.hits, 15);
+  CU_ASSERT_EQUAL(stats.misses, 5);
+  CU_ASSERT_EQUAL(stats.evictions, 0);
+  CU_ASSERT_DOUBLE_EQUAL(stats.hit_rate, 0.75, 1e-9);
+
+  ioopm_lru_stats_t none = ioopm_lru_cache_stats(NULL);
+  CU_ASSERT_EQUAL(none.hits + none.misses + none.evictions, 0);
+  ioopm_lru_cache_destroy(cache);
+}
+
+void test_owned_strings() {
+  ioopm_lru_cache_t *cache = ioopm_lru_cache_create(ioopm_string_hash, string_eq_function, 2, NULL);
+  ioopm_lru_cache_set_evict_function(cache, free_evicted_strings, NULL);
+
+  char *words[] = {"one", "two", "three", "two", "four"};
+  for (int i = 0; i < 5; ++i) {
+    CU_ASSERT_TRUE(ioopm_lru_cache_put(cache, ptr_elem(strdup(words[i])), ptr_elem(strdup(words[i]))));
+  }
+
+  CU_ASSERT_EQUAL(ioopm_lru_cache_size(cache), 2);
+  CU_ASSERT_STRING_EQUAL(ioopm_lru_cache_get(cache, ptr_elem("two")).value.ptrValue, "two");
+  CU_ASSERT(Unsuccessful(ioopm_lru_cache_get(cache, ptr_elem("three"))));
+
+  // Evicted and replaced strings were freed by the callback, the rest are freed here
+  ioopm_lru_cache_destroy(cache);
+}
+
+
+/*
+ * =========================================
+ * SECTION: Main
+ * =========================================
+ */
+
+int main() {
+  // First we try to set up CUnit, and exit if we fail
+  if (CU_initialize_registry() != CUE_SUCCESS)
+    return CU_get_error();
+
+  // We then create an empty test suite and specify the name and
+  // the init and cleanup functions
+  CU_pSuite my_test_suite = CU_add_suite("Unit tests for LRU cache", init_suite, clean_suite);
+  if (my_test_suite == NULL) {
+      // If the test suite could not be added, tear down CUnit and exit
+      CU_cleanup_registry();
+      return CU_get_error();
+  }
+
+  if (
+    (CU_add_test(my_test_suite, "Create and destroy a cache", test_create_destroy) == NULL) ||
+    (CU_add_test(my_test_suite, "Evict the least recently used entry", test_evicts_least_recently_used) == NULL) ||
+    (CU_add_test(my_test_suite, "Capacity in bytes", test_byte_capacity) == NULL) ||
+    (CU_add_test(my_test_suite, "Hit rate stats", test_hit_rate) == NULL) ||
+    (CU_add_test(my_test_suite, "Evicted strings are freed by the callback", test_owned_strings) == NULL) ||
+    0
+  )
+    {
+      // If adding any of the tests fails, we tear down CUnit and exit
+      CU_cleanup_registry();
+      return CU_get_error();
+    }
+
+  // Set the running mode. Use CU_BRM_VERBOSE for maximum output.
+  // Use CU_BRM_NORMAL to only print errors and a summary
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+
+  // This is where the tests are actually run!
+  CU_basic_run_tests();
+
+  // Tear down CUnit before exiting
+  CU_cleanup_registry();
+  return CU_get_error();
+}
@@ -0,0 +1,586 @@
+// ordered_map.c
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "ordered_map.h"
+#include "linked_list.h"
+
+#define Min_Degree 16
+#define Max_Keys (2 * Min_Degree - 1)
+
+/*
+ * =========================================
+ * SECTION: Custom Data Types And Aliases
+ * =========================================
+ */
+
+typedef struct btree_node btree_node_t;
+
+/// Keys and values are stored in separate arrays so a node search only
+/// touches the keys. Children are only used when leaf is false.
+struct btree_node
+{
+  size_t no_keys;
+  bool leaf;
+  elem_t keys[Max_Keys];
+  elem_t values[Max_Keys];
+  btree_node_t *children[Max_Keys + 1];
+};
+
+struct ordered_map
+{
+  btree_node_t *root;
+  size_t size;
+  ioopm_cmp_function key_cmp_func;
+  ioopm_eq_function key_eq_func;
+  ioopm_eq_function value_eq_func;
+};
+
+
+/*
+ * =========================================
+ * SECTION: Function Definitions
+ * =========================================
+ */
+
+/// @brief Creates a new empty node.
+/// @param leaf Whether the node is a leaf.
+/// @return A pointer to the new node, or NULL if memory allocation fails.
+static btree_node_t *node_create(bool leaf){
+  btree_node_t *node = calloc(1, sizeof(btree_node_t));
+  if(!node){
+    printf("memory allocation for new node failed");
+    return NULL;
+  }
+
+  node->leaf = leaf;
+
+  return node;
+}
+
+/// @brief Frees a node and all of its descendants.
+/// @param node The root of the subtree to free.
+static void node_destroy(btree_node_t *node){
+  if(!node) return;
+
+  if(!node->leaf){
+    for(size_t i = 0; i <= node->no_keys; ++i){
+      node_destroy(node->children[i]);
+    }
+  }
+
+  free(node);
+}
+
+/// @brief Finds the index of the first key in a node that is >= key (binary search).
+/// @param map The ordered map (for the compare function).
+/// @param node The node to search.
+/// @param key The key to search for.
+/// @return An index in [0, no_keys].
+static size_t lower_idx(ioopm_ordered_map_t *map, btree_node_t *node, elem_t key){
+  size_t low = 0;
+  size_t high = node->no_keys;
+
+  while(low < high){
+    size_t mid = low + (high - low) / 2;
+    if(map->key_cmp_func(node->keys[mid], key) < 0){
+      low = mid + 1;
+    }
+    else{
+      high = mid;
+    }
+  }
+
+  return low;
+}
+
+/// @brief Finds the index of the first key in a node that is > key (binary search).
+/// @param map The ordered map (for the compare function).
+/// @param node The node to search.
+/// @param key The key to search for.
+/// @return An index in [0, no_keys].
+static size_t upper_idx(ioopm_ordered_map_t *map, btree_node_t *node, elem_t key){
+  size_t low = 0;
+  size_t high = node->no_keys;
+
+  while(low < high){
+    size_t mid = low + (high - low) / 2;
+    if(map->key_cmp_func(node->keys[mid], key) <= 0){
+      low = mid + 1;
+    }
+    else{
+      high = mid;
+    }
+  }
+
+  return low;
+}
+
+/// @brief Shifts the entries of a node one step right, starting at idx, to make room.
+/// @param node The node operated upon.
+/// @param idx The index of the slot to free.
+static void shift_right(btree_node_t *node, size_t idx){
+  size_t count = node->no_keys - idx;
+  memmove(&node->keys[idx + 1], &node->keys[idx], count * sizeof(elem_t));
+  memmove(&node->values[idx + 1], &node->values[idx], count * sizeof(elem_t));
+  if(!node->leaf){
+    memmove(&node->children[idx + 2], &node->children[idx + 1], count * sizeof(btree_node_t *));
+  }
+}
+
+/// @brief Shifts the entries of a node one step left, overwriting the entry at idx.
+/// @param node The node operated upon.
+/// @param idx The index of the entry to overwrite.
+/// @note The child to the right of the removed key is dropped.
+static void shift_left(btree_node_t *node, size_t idx){
+  size_t count = node->no_keys - idx - 1;
+  memmove(&node->keys[idx], &node->keys[idx + 1], count * sizeof(elem_t));
+  memmove(&node->values[idx], &node->values[idx + 1], count * sizeof(elem_t));
+  if(!node->leaf){
+    memmove(&node->children[idx + 1], &node->children[idx + 2], count * sizeof(btree_node_t *));
+  }
+}
+
+/// @brief Splits the full child at idx of parent into two nodes, moving its median up.
+/// @param parent A non-full parent node.
+/// @param idx The index of the full child.
+/// @return true on success, false if memory allocation fails.
+static bool split_child(btree_node_t *parent, size_t idx){
+  btree_node_t *left = parent->children[idx];
+  btree_node_t *right = node_create(left->leaf);
+  if(!right) return false;
+
+  right->no_keys = Min_Degree - 1;
+  memcpy(right->keys, &left->keys[Min_Degree], (Min_Degree - 1) * sizeof(elem_t));
+  memcpy(right->values, &left->values[Min_Degree], (Min_Degree - 1) * sizeof(elem_t));
+  if(!left->leaf){
+    memcpy(right->children, &left->children[Min_Degree], Min_Degree * sizeof(btree_node_t *));
+  }
+  left->no_keys = Min_Degree - 1;
+
+  shift_right(parent, idx);
+  parent->keys[idx] = left->keys[Min_Degree - 1];
+  parent->values[idx] = left->values[Min_Degree - 1];
+  parent->children[idx + 1] = right;
+  parent->no_keys++;
+
+  return true;
+}
+
+/// @brief Inserts or updates a key in the subtree rooted at a non-full node.
+/// @param map The ordered map.
+/// @param node A non-full node.
+/// @param key The key to insert.
+/// @param value The value to associate with the key.
+static void insert_nonfull(ioopm_ordered_map_t *map, btree_node_t *node, elem_t key, elem_t value){
+  while(true){
+    size_t idx = lower_idx(map, node, key);
+
+    if(idx < node->no_keys && map->key_cmp_func(node->keys[idx], key) == 0){
+      node->values[idx] = value;
+      return;
+    }
+
+    if(node->leaf){
+      shift_right(node, idx);
+      node->keys[idx] = key;
+      node->values[idx] = value;
+      node->no_keys++;
+      map->size++;
+      return;
+    }
+
+    if(node->children[idx]->no_keys == Max_Keys){
+      if(!split_child(node, idx)) return;
+
+      int cmp = map->key_cmp_func(node->keys[idx], key);
+      if(cmp == 0){
+        node->values[idx] = value;
+        return;
+      }
+      if(cmp < 0){
+        idx++;
+      }
+    }
+
+    node = node->children[idx];
+  }
+}
+
+/// @brief Merges child idx+1 and the separating key into child idx.
+/// @param node The parent node.
+/// @param idx The index of the left child.
+static void merge_children(btree_node_t *node, size_t idx){
+  btree_node_t *left = node->children[idx];
+  btree_node_t *right = node->children[idx + 1];
+
+  left->keys[left->no_keys] = node->keys[idx];
+  left->values[left->no_keys] = node->values[idx];
+  memcpy(&left->keys[left->no_keys + 1], right->keys, right->no_keys * sizeof(elem_t));
+  memcpy(&left->values[left->no_keys + 1], right->values, right->no_keys * sizeof(elem_t));
+  if(!left->leaf){
+    memcpy(&left->children[left->no_keys + 1], right->children, (right->no_keys + 1) * sizeof(btree_node_t *));
+  }
+  left->no_keys += right->no_keys + 1;
+
+  shift_left(node, idx);
+  node->no_keys--;
+
+  free(right);
+}
+
+/// @brief Moves a key from the left sibling through the parent into child idx.
+/// @param node The parent node.
+/// @param idx The index of the child that needs one more key.
+static void borrow_from_prev(btree_node_t *node, size_t idx){
+  btree_node_t *child = node->children[idx];
+  btree_node_t *sibling = node->children[idx - 1];
+
+  shift_right(child, 0);
+  if(!child->leaf){
+    child->children[1] = child->children[0];
+    child->children[0] = sibling->children[sibling->no_keys];
+  }
+  child->keys[0] = node->keys[idx - 1];
+  child->values[0] = node->values[idx - 1];
+  child->no_keys++;
+
+  node->keys[idx - 1] = sibling->keys[sibling->no_keys - 1];
+  node->values[idx - 1] = sibling->values[sibling->no_keys - 1];
+  sibling->no_keys--;
+}
+
+/// @brief Moves a key from the right sibling through the parent into child idx.
+/// @param node The parent node.
+/// @param idx The index of the child that needs one more key.
+static void borrow_from_next(btree_node_t *node, size_t idx){
+  btree_node_t *child = node->children[idx];
+  btree_node_t *sibling = node->children[idx + 1];
+
+  child->keys[child->no_keys] = node->keys[idx];
+  child->values[child->no_keys] = node->values[idx];
+  if(!child->leaf){
+    child->children[child->no_keys + 1] = sibling->children[0];
+  }
+  child->no_keys++;
+
+  node->keys[idx] = sibling->keys[0];
+  node->values[idx] = sibling->values[0];
+
+  if(!sibling->leaf){
+    sibling->children[0] = sibling->children[1];
+  }
+  shift_left(sibling, 0);
+  sibling->no_keys--;
+}
+
+/// @brief Makes sure child idx has at least Min_Degree keys before descending into it.
+/// @param node The parent node.
+/// @param idx The index of the child.
+/// @return The index of the child to descend into (it may move left after a merge).
+static size_t fill_child(btree_node_t *node, size_t idx){
+  if(idx > 0 && node->children[idx - 1]->no_keys >= Min_Degree){
+    borrow_from_prev(node, idx);
+  }
+  else if(idx < node->no_keys && node->children[idx + 1]->no_keys >= Min_Degree){
+    borrow_from_next(node, idx);
+  }
+  else if(idx < node->no_keys){
+    merge_children(node, idx);
+  }
+  else{
+    merge_children(node, idx - 1);
+    return idx - 1;
+  }
+
+  return idx;
+}
+
+/// @brief Removes a key from the subtree rooted at node.
+/// @param map The ordered map.
+/// @param node The root of the subtree (has at least Min_Degree keys unless it is the root).
+/// @param key The key to remove.
+/// @param removed Pointer to store the removed value.
+/// @return true if the key was found and removed, false otherwise.
+static bool remove_from(ioopm_ordered_map_t *map, btree_node_t *node, elem_t key, elem_t *removed){
+  elem_t ignored;
+
+  while(true){
+    size_t idx = lower_idx(map, node, key);
+    bool found = idx < node->no_keys && map->key_cmp_func(node->keys[idx], key) == 0;
+
+    if(found && node->leaf){
+      *removed = node->values[idx];
+      shift_left(node, idx);
+      node->no_keys--;
+      return true;
+    }
+
+    if(found){
+      *removed = node->values[idx];
+      btree_node_t *left = node->children[idx];
+      btree_node_t *right = node->children[idx + 1];
+
+      if(left->no_keys >= Min_Degree){
+        btree_node_t *pred = left;
+        while(!pred->leaf) pred = pred->children[pred->no_keys];
+        node->keys[idx] = pred->keys[pred->no_keys - 1];
+        node->values[idx] = pred->values[pred->no_keys - 1];
+        return remove_from(map, left, node->keys[idx], &ignored);
+      }
+      if(right->no_keys >= Min_Degree){
+        btree_node_t *succ = right;
+        while(!succ->leaf) succ = succ->children[0];
+        node->keys[idx] = succ->keys[0];
+        node->values[idx] = succ->values[0];
+        return remove_from(map, right, node->keys[idx], &ignored);
+      }
+
+      merge_children(node, idx);
+      node = left;
+      removed = &ignored;
+      continue;
+    }
+
+    if(node->leaf) return false;
+
+    if(node->children[idx]->no_keys < Min_Degree){
+      idx = fill_child(node, idx);
+    }
+
+    node = node->children[idx];
+  }
+}
+
+/// @brief Applies a function to every entry of a subtree in key order.
+/// @param node The root of the subtree.
+/// @param apply_fun The function to apply.
+/// @param arg Extra argument passed to the function.
+static void node_apply(btree_node_t *node, ioopm_apply_function apply_fun, void *arg){
+  for(size_t i = 0; i < node->no_keys; ++i){
+    if(!node->leaf) node_apply(node->children[i], apply_fun, arg);
+    apply_fun(node->keys[i], &node->values[i], arg);
+  }
+
+  if(!node->leaf) node_apply(node->children[node->no_keys], apply_fun, arg);
+}
+
+/// @brief Applies a function in key order to the entries of a subtree within [low, high).
+/// @param map The ordered map.
+/// @param node The root of the subtree.
+/// @param low Inclusive lower bound.
+/// @param high Exclusive upper bound.
+/// @param apply_fun The function to apply.
+/// @param arg Extra argument passed to the function.
+/// @param visited Counter incremented for each visited entry.
+/// @return false once a key >= high has been seen, true otherwise.
+static bool node_range(ioopm_ordered_map_t *map, btree_node_t *node, elem_t low, elem_t high,
+                       ioopm_apply_function apply_fun, void *arg, size_t *visited){
+  for(size_t i = lower_idx(map, node, low); i < node->no_keys; ++i){
+    if(!node->leaf && !node_range(map, node->children[i], low, high, apply_fun, arg, visited)){
+      return false;
+    }
+    if(map->key_cmp_func(node->keys[i], high) >= 0){
+      return false;
+    }
+
+    if(apply_fun) apply_fun(node->keys[i], &node->values[i], arg);
+    (*visited)++;
+  }
+
+  if(!node->leaf){
+    return node_range(map, node->children[node->no_keys], low, high, apply_fun, arg, visited);
+  }
+
+  return true;
+}
+
+/// @brief Apply function used to append keys to a list.
+static void append_key(elem_t key, elem_t *value, void *extra){
+  (void)value;
+  ioopm_linked_list_append(extra, key);
+}
+
+/// @brief Apply function used to append values to a list.
+static void append_value(elem_t key, elem_t *value, void *extra){
+  (void)key;
+  ioopm_linked_list_append(extra, *value);
+}
+
+
+ioopm_ordered_map_t *ioopm_ordered_map_create(ioopm_cmp_function key_cmp_func, ioopm_eq_function key_eq_func, ioopm_eq_function value_eq_func){
+  if(!key_cmp_func) return NULL;
+
+  ioopm_ordered_map_t *map = calloc(1, sizeof(ioopm_ordered_map_t));
+  if(!map) return NULL;
+
+  map->root = NULL;
+  map->size = 0;
+  map->key_cmp_func = key_cmp_func;
+  map->key_eq_func = key_eq_func;
+  map->value_eq_func = value_eq_func;
+
+  return map;
+}
+
+void ioopm_ordered_map_destroy(ioopm_ordered_map_t *map){
+  if(!map) return;
+
+  node_destroy(map->root);
+  free(map);
+}
+
+void ioopm_ordered_map_insert(ioopm_ordered_map_t *map, elem_t key, elem_t value){
+  if(!map) return;
+
+  if(!map->root){
+    map->root = node_create(true);
+    if(!map->root) return;
+  }
+
+  if(map->root->no_keys == Max_Keys){
+    btree_node_t *new_root = node_create(false);
+    if(!new_root) return;
+
+    new_root->children[0] = map->root;
+    if(!split_child(new_root, 0)){
+      free(new_root);
+      return;
+    }
+    map->root = new_root;
+  }
+
+  insert_nonfull(map, map->root, key, value);
+}
+
+option_t ioopm_ordered_map_lookup(ioopm_ordered_map_t *map, elem_t key){
+  if(!map) return Failure();
+
+  btree_node_t *node = map->root;
+  while(node){
+    size_t idx = lower_idx(map, node, key);
+    if(idx < node->no_keys && map->key_cmp_func(node->keys[idx], key) == 0){
+      return Success(node->values[idx]);
+    }
+
+    node = node->leaf ? NULL : node->children[idx];
+  }
+
+  return Failure();
+}
+
+option_t ioopm_ordered_map_remove(ioopm_ordered_map_t *map, elem_t key){
+  if(!map || !map->root) return Failure();
+
+  elem_t removed;
+  bool found = remove_from(map, map->root, key, &removed);
+
+  if(map->root->no_keys == 0){
+    btree_node_t *old_root = map->root;
+    map->root = old_root->leaf ? NULL : old_root->children[0];
+    free(old_root);
+  }
+
+  if(!found) return Failure();
+
+  map->size--;
+  return Success(removed);
+}
+
+size_t ioopm_ordered_map_size(ioopm_ordered_map_t *map){
+  if(!map) return 0;
+
+  return map->size;
+}
+
+bool ioopm_ordered_map_is_empty(ioopm_ordered_map_t *map){
+  return !map || map->size == 0;
+}
+
+void ioopm_ordered_map_clear(ioopm_ordered_map_t *map){
+  if(!map) return;
+
+  node_destroy(map->root);
+  map->root = NULL;
+  map->size = 0;
+}
+
+bool ioopm_ordered_map_has_key(ioopm_ordered_map_t *map, elem_t key){
+  return Successful(ioopm_ordered_map_lookup(map, key));
+}
+
+ioopm_list_t *ioopm_ordered_map_keys(ioopm_ordered_map_t *map){
+  if(!map) return NULL;
+
+  ioopm_list_t *keys_list = ioopm_linked_list_create(map->key_eq_func);
+  if(keys_list && map->root) node_apply(map->root, append_key, keys_list);
+
+  return keys_list;
+}
+
+ioopm_list_t *ioopm_ordered_map_values(ioopm_ordered_map_t *map){
+  if(!map) return NULL;
+
+  ioopm_list_t *values_list = ioopm_linked_list_create(map->value_eq_func);
+  if(values_list && map->root) node_apply(map->root, append_value, values_list);
+
+  return values_list;
+}
+
+option_t ioopm_ordered_map_lower_bound(ioopm_ordered_map_t *map, elem_t key){
+  if(!map) return Failure();
+
+  option_t result = Failure();
+  btree_node_t *node = map->root;
+  while(node){
+    size_t idx = lower_idx(map, node, key);
+    if(idx < node->no_keys){
+      result = Success(node->keys[idx]);
+      if(map->key_cmp_func(node->keys[idx], key) == 0) return result;
+    }
+
+    node = node->leaf ? NULL : node->children[idx];
+  }
+
+  return result;
+}
+
+option_t ioopm_ordered_map_upper_bound(ioopm_ordered_map_t *map, elem_t key){
+  if(!map) return Failure();
+
+  option_t result = Failure();
+  btree_node_t *node = map->root;
+  while(node){
+    size_t idx = upper_idx(map, node, key);
+    if(idx < node->no_keys){
+      result = Success(node->keys[idx]);
+    }
+
+    node = node->leaf ? NULL : node->children[idx];
+  }
+
+  return result;
+}
+
+void ioopm_ordered_map_apply_to_all(ioopm_ordered_map_t *map, ioopm_apply_function apply_fun, void *arg){
+  if(!map || !apply_fun || !map->root) return;
+
+  node_apply(map->root, apply_fun, arg);
+}
+
+size_t ioopm_ordered_map_range(ioopm_ordered_map_t *map, elem_t low, elem_t high, ioopm_apply_function apply_fun, void *arg){
+  if(!map || !map->root) return 0;
+
+  size_t visited = 0;
+  node_range(map, map->root, low, high, apply_fun, arg, &visited);
+
+  return visited;
+}
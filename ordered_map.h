@@ -0,0 +1,131 @@
+// ordered_map.h
+
+#ifndef ORDERED_MAP_H
+#define ORDERED_MAP_H
+
+/**
+ * @file ordered_map.h
+ * @brief Generic ordered map (B-tree) that maps keys to values.
+ *
+ * Keys are kept sorted by a user supplied compare function, so in-order
+ * traversal, lower/upper bound and range scans are available without a
+ * separate sort pass. Nodes are wide (up to 31 entries each) to keep
+ * the tree shallow and every node visit cache friendly.
+ */
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include "hash_table.h"
+#include "linked_list.h"
+
+/*
+ * =========================================
+ * SECTION: Custom Data Types And Aliases
+ * =========================================
+ */
+
+typedef struct ordered_map ioopm_ordered_map_t;
+
+
+/*
+ * =========================================
+ * SECTION: Function Declarations
+ * =========================================
+ */
+
+/// @brief Create a new ordered map.
+/// @param key_cmp_func Function used to order keys (negative, zero or positive like strcmp).
+/// @param key_eq_func Function used to compare keys for equality in the list from keys (may be NULL).
+/// @param value_eq_func Function used to compare values for equality (may be NULL).
+/// @return A new empty ordered map, or NULL if memory allocation fails.
+ioopm_ordered_map_t *ioopm_ordered_map_create(ioopm_cmp_function key_cmp_func, ioopm_eq_function key_eq_func, ioopm_eq_function value_eq_func);
+
+/// @brief Delete an ordered map and free its memory.
+/// @param map The ordered map to be deleted.
+void ioopm_ordered_map_destroy(ioopm_ordered_map_t *map);
+
+/// @brief Add or update a key-value entry in the ordered map.
+/// @param map Ordered map operated upon.
+/// @param key Key to insert or update.
+/// @param value Value to associate with the key.
+void ioopm_ordered_map_insert(ioopm_ordered_map_t *map, elem_t key, elem_t value);
+
+/// @brief Lookup the value associated with a key.
+/// @param map Ordered map operated upon.
+/// @param key Key to lookup.
+/// @return An option_t containing the value if found, or indicating failure otherwise.
+option_t ioopm_ordered_map_lookup(ioopm_ordered_map_t *map, elem_t key);
+
+/// @brief Remove any mapping from key to a value.
+/// @param map Ordered map operated upon.
+/// @param key Key to remove.
+/// @return An option_t containing the removed value if key existed, or indicating failure otherwise.
+option_t ioopm_ordered_map_remove(ioopm_ordered_map_t *map, elem_t key);
+
+/// @brief Returns the number of key-value entries in the ordered map.
+/// @param map Ordered map operated upon.
+/// @return The number of entries.
+size_t ioopm_ordered_map_size(ioopm_ordered_map_t *map);
+
+/// @brief Checks if the ordered map is empty.
+/// @param map Ordered map operated upon.
+/// @return true if the map is empty, false otherwise.
+bool ioopm_ordered_map_is_empty(ioopm_ordered_map_t *map);
+
+/// @brief Clear all the entries in an ordered map.
+/// @param map Ordered map operated upon.
+void ioopm_ordered_map_clear(ioopm_ordered_map_t *map);
+
+/// @brief Check if the ordered map has an entry with a given key.
+/// @param map Ordered map operated upon.
+/// @param key The key sought.
+/// @return true if the key exists, false otherwise.
+bool ioopm_ordered_map_has_key(ioopm_ordered_map_t *map, elem_t key);
+
+/// @brief Return the keys for all entries in ascending order.
+/// @param map Ordered map operated upon.
+/// @return A linked list containing all keys in sorted order, comparing elements with the map's key_eq_func.
+ioopm_list_t *ioopm_ordered_map_keys(ioopm_ordered_map_t *map);
+
+/// @brief Return the values for all entries, ordered by their keys.
+/// @param map Ordered map operated upon.
+/// @return A linked list containing all values in key order.
+ioopm_list_t *ioopm_ordered_map_values(ioopm_ordered_map_t *map);
+
+/// @brief Find the smallest key that is greater than or equal to key.
+/// @param map Ordered map operated upon.
+/// @param key The key to compare against.
+/// @return An option_t containing the found key, or indicating failure if there is none.
+option_t ioopm_ordered_map_lower_bound(ioopm_ordered_map_t *map, elem_t key);
+
+/// @brief Find the smallest key that is strictly greater than key.
+/// @param map Ordered map operated upon.
+/// @param key The key to compare against.
+/// @return An option_t containing the found key, or indicating failure if there is none.
+option_t ioopm_ordered_map_upper_bound(ioopm_ordered_map_t *map, elem_t key);
+
+/// @brief Apply a function to all entries in ascending key order.
+/// @param map Ordered map operated upon.
+/// @param apply_fun The function to apply to each entry.
+/// @param arg Extra argument passed to the apply function.
+void ioopm_ordered_map_apply_to_all(ioopm_ordered_map_t *map, ioopm_apply_function apply_fun, void *arg);
+
+/// @brief Apply a function, in ascending key order, to all entries with low <= key < high.
+/// @param map Ordered map operated upon.
+/// @param low Inclusive lower bound of the range.
+/// @param high Exclusive upper bound of the range.
+/// @param apply_fun The function to apply to each entry in the range.
+/// @param arg Extra argument passed to the apply function.
+/// @return The number of entries visited.
+size_t ioopm_ordered_map_range(ioopm_ordered_map_t *map, elem_t low, elem_t high, ioopm_apply_function apply_fun, void *arg);
+
+
+
+#endif // ORDERED_MAP_H
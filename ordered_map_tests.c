@@ -0,0 +1,354 @@
+// ordered_map_tests.c
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include <CUnit/Basic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ordered_map.h"
+#include "iterator.h"
+
+/// @brief Number of keys used in the larger tests (enough for a tree of height > 2).
+#define MANY_KEYS 5000
+
+
+/*
+ * =========================================
+ * SECTION: Private Function Definitions
+ * =========================================
+ */
+
+/// @brief Compare function for integer keys.
+/// @param a First integer key.
+/// @param b Second integer key.
+/// @return Negative, zero or positive depending on the order of a and b.
+static int int_cmp_function(elem_t a, elem_t b) {
+    return (a.intValue > b.intValue) - (a.intValue < b.intValue);
+}
+
+/// @brief Compare function for string keys.
+/// @param a First string key.
+/// @param b Second string key.
+/// @return Negative, zero or positive depending on the order of a and b.
+static int string_cmp_function(elem_t a, elem_t b) {
+    return strcmp(a.ptrValue, b.ptrValue);
+}
+
+/// @brief Equality function for string keys.
+/// @param a First string key.
+/// @param b Second string key.
+/// @return true if both strings have the same contents.
+static bool string_eq_function(elem_t a, elem_t b) {
+    return strcmp(a.ptrValue, b.ptrValue) == 0;
+}
+
+/// @brief Collects keys visited by an apply function.
+typedef struct {
+  int keys[MANY_KEYS];
+  size_t count;
+} collector_t;
+
+/// @brief Apply function that collects keys into a collector_t.
+/// @param key The key.
+/// @param value Pointer to the value (unused).
+/// @param extra Pointer to a collector struct.
+static void collect_key(elem_t key, elem_t *value, void *extra) {
+  (void)value;
+  collector_t *collector = extra;
+  collector->keys[collector->count++] = key.intValue;
+}
+
+/// @brief Apply function to double integer values.
+/// @param key The key (unused).
+/// @param value Pointer to the value to modify.
+/// @param extra Unused extra parameter.
+static void double_value(elem_t key, elem_t *value, void *extra) {
+  (void)key;
+  (void)extra;
+  value->intValue *= 2;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Initialize and clean the suite
+ * =========================================
+ */
+
+int init_suite(void) {
+  return 0;
+}
+
+int clean_suite(void) {
+  return 0;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Tests
+ * =========================================
+ */
+
+void test_create_destroy() {
+  ioopm_ordered_map_t *map = ioopm_ordered_map_create(int_cmp_function, NULL, NULL);
+
+  CU_ASSERT_PTR_NOT_NULL(map);
+  CU_ASSERT_TRUE(ioopm_ordered_map_is_empty(map));
+  CU_ASSERT_PTR_NULL(ioopm_ordered_map_create(NULL, NULL, NULL));
+
+  ioopm_ordered_map_destroy(map);
+}
+
+void test_insert_lookup() {
+  ioopm_ordered_map_t *map = ioopm_ordered_map_create(int_cmp_function, NULL, NULL);
+
+  ioopm_ordered_map_insert(map, int_elem(1), ptr_elem("One"));
+  ioopm_ordered_map_insert(map, int_elem(2), ptr_elem("Two"));
+
+  option_t result = ioopm_ordered_map_lookup(map, int_elem(1));
+  CU_ASSERT(Successful(result));
+  CU_ASSERT_STRING_EQUAL(result.value.ptrValue, "One");
+
+  ioopm_ordered_map_insert(map, int_elem(2), ptr_elem("Two updated"));
+  result = ioopm_ordered_map_lookup(map, int_elem(2));
+  CU_ASSERT(Successful(result));
+  CU_ASSERT_STRING_EQUAL(result.value.ptrValue, "Two updated");
+  CU_ASSERT_EQUAL(ioopm_ordered_map_size(map), 2);
+
+  CU_ASSERT(Unsuccessful(ioopm_ordered_map_lookup(map, int_elem(99))));
+  CU_ASSERT_FALSE(ioopm_ordered_map_has_key(map, int_elem(99)));
+  CU_ASSERT_TRUE(ioopm_ordered_map_has_key(map, int_elem(1)));
+
+  ioopm_ordered_map_destroy(map);
+}
+
+void test_insert_remove_many() {
+  ioopm_ordered_map_t *map = ioopm_ordered_map_create(int_cmp_function, NULL, NULL);
+
+  // Insert in a scrambled order so splits happen all over the tree
+  for (int i = 0; i < MANY_KEYS; ++i) {
+    int key = (i * 7919) % MANY_KEYS;
+    ioopm_ordered_map_insert(map, int_elem(key), int_elem(key * 10));
+  }
+  CU_ASSERT_EQUAL(ioopm_ordered_map_size(map), MANY_KEYS);
+
+  for (int i = 0; i < MANY_KEYS; ++i) {
+    option_t result = ioopm_ordered_map_lookup(map, int_elem(i));
+    CU_ASSERT(Successful(result));
+    CU_ASSERT_EQUAL(result.value.intValue, i * 10);
+  }
+
+  // Remove every other key and check that the rest is intact
+  for (int i = 0; i < MANY_KEYS; i += 2) {
+    option_t result = ioopm_ordered_map_remove(map, int_elem(i));
+    CU_ASSERT(Successful(result));
+    CU_ASSERT_EQUAL(result.value.intValue, i * 10);
+  }
+  CU_ASSERT(Unsuccessful(ioopm_ordered_map_remove(map, int_elem(0))));
+  CU_ASSERT_EQUAL(ioopm_ordered_map_size(map), MANY_KEYS / 2);
+
+  for (int i = 0; i < MANY_KEYS; ++i) {
+    CU_ASSERT_EQUAL(ioopm_ordered_map_has_key(map, int_elem(i)), i % 2 == 1);
+  }
+
+  for (int i = MANY_KEYS - 1; i >= 0; --i) {
+    ioopm_ordered_map_remove(map, int_elem(i));
+  }
+  CU_ASSERT_TRUE(ioopm_ordered_map_is_empty(map));
+
+  ioopm_ordered_map_destroy(map);
+}
+
+void test_in_order_iteration() {
+  ioopm_ordered_map_t *map = ioopm_ordered_map_create(int_cmp_function, NULL, NULL);
+  collector_t *collector = calloc(1, sizeof(collector_t));
+
+  for (int i = 0; i < MANY_KEYS; ++i) {
+    int key = (i * 7919) % MANY_KEYS;
+    ioopm_ordered_map_insert(map, int_elem(key), int_elem(key));
+  }
+
+  ioopm_ordered_map_apply_to_all(map, collect_key, collector);
+  CU_ASSERT_EQUAL(collector->count, MANY_KEYS);
+  for (size_t i = 0; i < collector->count; ++i) {
+    CU_ASSERT_EQUAL(collector->keys[i], (int)i);
+  }
+
+  ioopm_list_t *keys = ioopm_ordered_map_keys(map);
+  ioopm_list_iterator_t *iter = ioopm_iterator_create(keys);
+  elem_t current;
+  int expected = 0;
+  while (ioopm_iterator_next(iter, &current) == IOOPM_SUCCESS) {
+    CU_ASSERT_EQUAL(current.intValue, expected);
+    expected++;
+  }
+  CU_ASSERT_EQUAL(expected, MANY_KEYS);
+
+  ioopm_iterator_destroy(iter);
+  ioopm_linked_list_destroy(keys);
+  free(collector);
+  ioopm_ordered_map_destroy(map);
+}
+
+void test_string_keys_sorted() {
+  ioopm_ordered_map_t *map = ioopm_ordered_map_create(string_cmp_function, string_eq_function, NULL);
+  char *words[] = {"pear", "apple", "fig", "banana", "cherry"};
+
+  for (int i = 0; i < 5; ++i) {
+    ioopm_ordered_map_insert(map, ptr_elem(words[i]), int_elem(i));
+  }
+
+  ioopm_list_t *keys = ioopm_ordered_map_keys(map);
+  ioopm_list_t *values = ioopm_ordered_map_values(map);
+  char *expected_keys[] = {"apple", "banana", "cherry", "fig", "pear"};
+  int expected_values[] = {1, 3, 4, 2, 0};
+
+  for (size_t i = 0; i < 5; ++i) {
+    elem_t key, value;
+    ioopm_linked_list_get(keys, i, &key);
+    ioopm_linked_list_get(values, i, &value);
+    CU_ASSERT_STRING_EQUAL(key.ptrValue, expected_keys[i]);
+    CU_ASSERT_EQUAL(value.intValue, expected_values[i]);
+  }
+
+  // The key list compares by contents, not by pointer
+  char fig[] = "fig";
+  bool found = false;
+  ioopm_linked_list_contains(keys, ptr_elem(fig), &found);
+  CU_ASSERT_TRUE(found);
+
+  ioopm_linked_list_destroy(keys);
+  ioopm_linked_list_destroy(values);
+  ioopm_ordered_map_destroy(map);
+}
+
+void test_lower_upper_bound() {
+  ioopm_ordered_map_t *map = ioopm_ordered_map_create(int_cmp_function, NULL, NULL);
+
+  CU_ASSERT(Unsuccessful(ioopm_ordered_map_lower_bound(map, int_elem(0))));
+
+  // Only multiples of ten
+  for (int i = 0; i < MANY_KEYS; ++i) {
+    ioopm_ordered_map_insert(map, int_elem(i * 10), int_elem(i));
+  }
+
+  option_t result = ioopm_ordered_map_lower_bound(map, int_elem(25));
+  CU_ASSERT(Successful(result));
+  CU_ASSERT_EQUAL(result.value.intValue, 30);
+
+  result = ioopm_ordered_map_lower_bound(map, int_elem(30));
+  CU_ASSERT(Successful(result));
+  CU_ASSERT_EQUAL(result.value.intValue, 30);
+
+  result = ioopm_ordered_map_upper_bound(map, int_elem(30));
+  CU_ASSERT(Successful(result));
+  CU_ASSERT_EQUAL(result.value.intValue, 40);
+
+  result = ioopm_ordered_map_lower_bound(map, int_elem(-5));
+  CU_ASSERT(Successful(result));
+  CU_ASSERT_EQUAL(result.value.intValue, 0);
+
+  CU_ASSERT(Unsuccessful(ioopm_ordered_map_lower_bound(map, int_elem(MANY_KEYS * 10))));
+  CU_ASSERT(Unsuccessful(ioopm_ordered_map_upper_bound(map, int_elem((MANY_KEYS - 1) * 10))));
+
+  ioopm_ordered_map_destroy(map);
+}
+
+void test_range() {
+  ioopm_ordered_map_t *map = ioopm_ordered_map_create(int_cmp_function, NULL, NULL);
+  collector_t *collector = calloc(1, sizeof(collector_t));
+
+  for (int i = 0; i < MANY_KEYS; ++i) {
+    ioopm_ordered_map_insert(map, int_elem(i), int_elem(i));
+  }
+
+  size_t visited = ioopm_ordered_map_range(map, int_elem(1000), int_elem(1500), collect_key, collector);
+  CU_ASSERT_EQUAL(visited, 500);
+  CU_ASSERT_EQUAL(collector->count, 500);
+  for (size_t i = 0; i < collector->count; ++i) {
+    CU_ASSERT_EQUAL(collector->keys[i], 1000 + (int)i);
+  }
+
+  CU_ASSERT_EQUAL(ioopm_ordered_map_range(map, int_elem(10), int_elem(10), NULL, NULL), 0);
+  CU_ASSERT_EQUAL(ioopm_ordered_map_range(map, int_elem(-100), int_elem(3), NULL, NULL), 3);
+  CU_ASSERT_EQUAL(ioopm_ordered_map_range(map, int_elem(MANY_KEYS - 2), int_elem(MANY_KEYS * 2), NULL, NULL), 2);
+
+  ioopm_ordered_map_range(map, int_elem(0), int_elem(2), double_value, NULL);
+  CU_ASSERT_EQUAL(ioopm_ordered_map_lookup(map, int_elem(1)).value.intValue, 2);
+  CU_ASSERT_EQUAL(ioopm_ordered_map_lookup(map, int_elem(2)).value.intValue, 2);
+
+  free(collector);
+  ioopm_ordered_map_destroy(map);
+}
+
+void test_clear() {
+  ioopm_ordered_map_t *map = ioopm_ordered_map_create(int_cmp_function, NULL, NULL);
+
+  for (int i = 0; i < 100; ++i) {
+    ioopm_ordered_map_insert(map, int_elem(i), int_elem(i));
+  }
+
+  ioopm_ordered_map_clear(map);
+  CU_ASSERT_TRUE(ioopm_ordered_map_is_empty(map));
+  CU_ASSERT(Unsuccessful(ioopm_ordered_map_lookup(map, int_elem(5))));
+
+  ioopm_ordered_map_insert(map, int_elem(5), int_elem(5));
+  CU_ASSERT_EQUAL(ioopm_ordered_map_size(map), 1);
+
+  ioopm_ordered_map_destroy(map);
+}
+
+
+/*
+ * =========================================
+ * SECTION: Main
+ * =========================================
+ */
+
+int main() {
+  // First we try to set up CUnit, and exit if we fail
+  if (CU_initialize_registry() != CUE_SUCCESS)
+    return CU_get_error();
+
+  // We then create an empty test suite and specify the name and
+  // the init and cleanup functions
+  CU_pSuite my_test_suite = CU_add_suite("Unit tests for ordered map", init_suite, clean_suite);
+  if (my_test_suite == NULL) {
+      // If the test suite could not be added, tear down CUnit and exit
+      CU_cleanup_registry();
+      return CU_get_error();
+  }
+
+  if (
+    (CU_add_test(my_test_suite, "Create and destroy map", test_create_destroy) == NULL) ||
+    (CU_add_test(my_test_suite, "Insert and lookup a KV", test_insert_lookup) == NULL) ||
+    (CU_add_test(my_test_suite, "Insert and remove many keys", test_insert_remove_many) == NULL) ||
+    (CU_add_test(my_test_suite, "Iterate in key order", test_in_order_iteration) == NULL) ||
+    (CU_add_test(my_test_suite, "String keys come out sorted", test_string_keys_sorted) == NULL) ||
+    (CU_add_test(my_test_suite, "Lower and upper bound", test_lower_upper_bound) == NULL) ||
+    (CU_add_test(my_test_suite, "Range scans", test_range) == NULL) ||
+    (CU_add_test(my_test_suite, "Clear the map", test_clear) == NULL) ||
+    0
+  )
+    {
+      // If adding any of the tests fails, we tear down CUnit and exit
+      CU_cleanup_registry();
+      return CU_get_error();
+    }
+
+  // Set the running mode. Use CU_BRM_VERBOSE for maximum output.
+  // Use CU_BRM_NORMAL to only print errors and a summary
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+
+  // This is where the tests are actually run!
+  CU_basic_run_tests();
+
+  // Tear down CUnit before exiting
+  CU_cleanup_registry();
+  return CU_get_error();
+}
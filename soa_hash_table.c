@@ -0,0 +1,379 @@
+// soa_hash_table.c
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "soa_hash_table.h"
+
+/// Number of index slots of a new table.
+#define Min_Index_Slots 16
+
+/// The index is kept at most half full, so probe sequences stay short.
+#define Max_Index_Load_Percent 50
+
+/// Values per block of the vectorized scans (has_int_value checks for a match once per block).
+#define Scan_Block 64
+
+/// Returned by find_position when the key is not in the table.
+#define Not_Found SIZE_MAX
+
+/*
+ * =========================================
+ * SECTION: Custom Data Types And Aliases
+ * =========================================
+ */
+
+/// An index slot holds the position of an entry plus one, so 0 marks an empty slot.
+/// The index uses linear probing and backward-shift deletion, so it has no tombstones.
+struct soa_table
+{
+  uint64_t *hashes;                   /// Mixed hash of the key at every position.
+  elem_t *keys;
+  elem_t *values;
+  size_t size;                        /// Number of entries, which occupy positions 0..size-1.
+  size_t capacity;                    /// Length of the three arrays.
+  uint32_t *index;
+  size_t index_mask;                  /// Number of index slots minus one (a power of two minus one).
+  ioopm_hash_function hash_func;
+  ioopm_eq_function key_eq_func;
+  ioopm_eq_function value_eq_func;
+};
+
+
+/*
+ * =========================================
+ * SECTION: Function Definitions
+ * =========================================
+ */
+
+/// @brief Computes the stored hash of a key.
+static uint64_t key_hash(ioopm_soa_table_t *st, elem_t key){
+  return ioopm_mix_hash(st->hash_func(key));
+}
+
+/// @brief Finds the position of a key.
+/// @param st The table.
+/// @param key The key to find.
+/// @param hash The stored hash of key.
+/// @param slot Receives the index slot of the key, or the empty slot that ended the probe.
+/// @return The position of the key, or Not_Found.
+static size_t find_position(ioopm_soa_table_t *st, elem_t key, uint64_t hash, size_t *slot){
+  size_t i = hash & st->index_mask;
+
+  while(st->index[i]){
+    size_t position = st->index[i] - 1;
+    if(st->hashes[position] == hash && st->key_eq_func(st->keys[position], key)){
+      *slot = i;
+      return position;
+    }
+    i = (i + 1) & st->index_mask;
+  }
+
+  *slot = i;
+  return Not_Found;
+}
+
+/// @brief Finds the index slot that refers to a position.
+/// @param st The table.
+/// @param position A position below size.
+/// @return The slot holding position + 1.
+static size_t slot_of_position(ioopm_soa_table_t *st, size_t position){
+  size_t i = st->hashes[position] & st->index_mask;
+  while(st->index[i] != position + 1){
+    i = (i + 1) & st->index_mask;
+  }
+  return i;
+}
+
+/// @brief Empties an index slot, moving later entries of its probe sequence back into the gap.
+/// @param st The table.
+/// @param slot The slot to empty.
+static void index_delete(ioopm_soa_table_t *st, size_t slot){
+  size_t hole = slot;
+  size_t i = (slot + 1) & st->index_mask;
+
+  while(st->index[i]){
+    size_t home = st->hashes[st->index[i] - 1] & st->index_mask;
+    // The entry may fill the hole if the hole lies on its probe sequence (between home and i)
+    if(((i - home) & st->index_mask) >= ((i - hole) & st->index_mask)){
+      st->index[hole] = st->index[i];
+      hole = i;
+    }
+    i = (i + 1) & st->index_mask;
+  }
+
+  st->index[hole] = 0;
+}
+
+/// @brief Replaces the index with one of no_slots slots, built from the stored hashes.
+/// @param st The table.
+/// @param no_slots The new number of slots, a power of two larger than size.
+/// @return true on success, false if memory allocation fails (the old index is then kept).
+static bool index_rebuild(ioopm_soa_table_t *st, size_t no_slots){
+  uint32_t *index = calloc(no_slots, sizeof(uint32_t));
+  if(!index) return false;
+
+  free(st->index);
+  st->index = index;
+  st->index_mask = no_slots - 1;
+
+  for(size_t position = 0; position < st->size; ++position){
+    size_t i = st->hashes[position] & st->index_mask;
+    while(st->index[i]){
+      i = (i + 1) & st->index_mask;
+    }
+    st->index[i] = position + 1;
+  }
+
+  return true;
+}
+
+/// @brief Grows the three arrays to hold capacity entries.
+/// @param st The table.
+/// @param capacity The new capacity, at least size.
+/// @return true on success, false if memory allocation fails (the capacity is then unchanged).
+static bool arrays_grow(ioopm_soa_table_t *st, size_t capacity){
+  // Arrays that did grow before a failure are kept, which is harmless
+  uint64_t *hashes = realloc(st->hashes, capacity * sizeof(uint64_t));
+  if(!hashes) return false;
+  st->hashes = hashes;
+
+  elem_t *keys = realloc(st->keys, capacity * sizeof(elem_t));
+  if(!keys) return false;
+  st->keys = keys;
+
+  elem_t *values = realloc(st->values, capacity * sizeof(elem_t));
+  if(!values) return false;
+  st->values = values;
+
+  st->capacity = capacity;
+  return true;
+}
+
+/// @brief Returns the number of index slots needed for no_keys entries.
+static size_t index_slots_for(size_t no_keys){
+  size_t no_slots = Min_Index_Slots;
+  while(no_keys * 100 > no_slots * Max_Index_Load_Percent){
+    no_slots *= 2;
+  }
+  return no_slots;
+}
+
+
+ioopm_soa_table_t *ioopm_soa_table_create(ioopm_hash_function hash_func, ioopm_eq_function key_eq_func, ioopm_eq_function value_eq_func){
+  ioopm_soa_table_t *st = calloc(1, sizeof(ioopm_soa_table_t));
+  if(!st) return NULL;
+
+  if(!index_rebuild(st, Min_Index_Slots)){
+    free(st);
+    return NULL;
+  }
+
+  st->hash_func = hash_func;
+  st->key_eq_func = key_eq_func;
+  st->value_eq_func = value_eq_func;
+
+  return st;
+}
+
+void ioopm_soa_table_destroy(ioopm_soa_table_t *st){
+  if(!st) return;
+
+  free(st->hashes);
+  free(st->keys);
+  free(st->values);
+  free(st->index);
+  free(st);
+}
+
+bool ioopm_soa_table_insert(ioopm_soa_table_t *st, elem_t key, elem_t value){
+  if(!st) return false;
+
+  uint64_t hash = key_hash(st, key);
+  size_t slot;
+  size_t position = find_position(st, key, hash, &slot);
+  if(position != Not_Found){
+    st->values[position] = value;
+    return true;
+  }
+
+  if(st->size == UINT32_MAX - 1) return false;
+  if(st->size == st->capacity && !arrays_grow(st, st->capacity ? st->capacity * 2 : Min_Index_Slots / 2)) return false;
+
+  size_t no_slots = index_slots_for(st->size + 1);
+  if(no_slots > st->index_mask + 1){
+    if(!index_rebuild(st, no_slots)) return false;
+    find_position(st, key, hash, &slot);
+  }
+
+  position = st->size++;
+  st->hashes[position] = hash;
+  st->keys[position] = key;
+  st->values[position] = value;
+  st->index[slot] = position + 1;
+
+  return true;
+}
+
+option_t ioopm_soa_table_lookup(ioopm_soa_table_t *st, elem_t key){
+  if(!st) return Failure();
+
+  size_t slot;
+  size_t position = find_position(st, key, key_hash(st, key), &slot);
+  if(position == Not_Found) return Failure();
+
+  return Success(st->values[position]);
+}
+
+option_t ioopm_soa_table_remove(ioopm_soa_table_t *st, elem_t key){
+  if(!st) return Failure();
+
+  size_t slot;
+  size_t position = find_position(st, key, key_hash(st, key), &slot);
+  if(position == Not_Found) return Failure();
+
+  elem_t value = st->values[position];
+  index_delete(st, slot);
+
+  // Fill the gap with the last entry to keep the arrays dense
+  size_t last = st->size - 1;
+  if(position != last){
+    st->index[slot_of_position(st, last)] = position + 1;
+    st->hashes[position] = st->hashes[last];
+    st->keys[position] = st->keys[last];
+    st->values[position] = st->values[last];
+  }
+  st->size--;
+
+  return Success(value);
+}
+
+size_t ioopm_soa_table_size(ioopm_soa_table_t *st){
+  return st ? st->size : 0;
+}
+
+bool ioopm_soa_table_is_empty(ioopm_soa_table_t *st){
+  return ioopm_soa_table_size(st) == 0;
+}
+
+void ioopm_soa_table_clear(ioopm_soa_table_t *st){
+  if(!st) return;
+
+  memset(st->index, 0, (st->index_mask + 1) * sizeof(uint32_t));
+  st->size = 0;
+}
+
+bool ioopm_soa_table_reserve(ioopm_soa_table_t *st, size_t no_keys){
+  if(!st) return false;
+
+  if(no_keys > st->capacity && !arrays_grow(st, no_keys)) return false;
+
+  size_t no_slots = index_slots_for(no_keys);
+  if(no_slots > st->index_mask + 1) return index_rebuild(st, no_slots);
+
+  return true;
+}
+
+bool ioopm_soa_table_has_key(ioopm_soa_table_t *st, elem_t key){
+  return Successful(ioopm_soa_table_lookup(st, key));
+}
+
+bool ioopm_soa_table_has_value(ioopm_soa_table_t *st, elem_t value){
+  if(!st || !st->value_eq_func) return false;
+
+  for(size_t i = 0; i < st->size; ++i){
+    if(st->value_eq_func(st->values[i], value)) return true;
+  }
+
+  return false;
+}
+
+bool ioopm_soa_table_has_int_value(ioopm_soa_table_t *st, int value){
+  if(!st) return false;
+
+  // Full blocks have a fixed trip count and no early exit, so the compiler can compare
+  // several values per instruction
+  size_t i = 0;
+  for(; i + Scan_Block <= st->size; i += Scan_Block){
+    elem_t *block = st->values + i;
+    int found = 0;
+    for(size_t j = 0; j < Scan_Block; ++j){
+      found |= block[j].intValue == value;
+    }
+    if(found) return true;
+  }
+
+  for(; i < st->size; ++i){
+    if(st->values[i].intValue == value) return true;
+  }
+
+  return false;
+}
+
+uint64_t ioopm_soa_table_sum_values(ioopm_soa_table_t *st){
+  if(!st) return 0;
+
+  uint64_t sum = 0;
+  size_t i = 0;
+  for(; i + Scan_Block <= st->size; i += Scan_Block){
+    elem_t *block = st->values + i;
+    uint64_t block_sum = 0;
+    for(size_t j = 0; j < Scan_Block; ++j){
+      block_sum += block[j].uint64Value;
+    }
+    sum += block_sum;
+  }
+
+  for(; i < st->size; ++i){
+    sum += st->values[i].uint64Value;
+  }
+
+  return sum;
+}
+
+ioopm_list_t *ioopm_soa_table_keys(ioopm_soa_table_t *st){
+  if(!st) return NULL;
+
+  // The arrays are already dense, so the list is filled with one copy
+  return ioopm_linked_list_from_array(st->key_eq_func, IOOPM_LIST_ARRAY, st->keys, st->size);
+}
+
+ioopm_list_t *ioopm_soa_table_values(ioopm_soa_table_t *st){
+  if(!st) return NULL;
+
+  return ioopm_linked_list_from_array(st->value_eq_func, IOOPM_LIST_ARRAY, st->values, st->size);
+}
+
+bool ioopm_soa_table_any(ioopm_soa_table_t *st, ioopm_predicate pred, void *arg){
+  if(!st || !pred) return false;
+
+  for(size_t i = 0; i < st->size; ++i){
+    if(pred(st->keys[i], st->values[i], arg)) return true;
+  }
+
+  return false;
+}
+
+bool ioopm_soa_table_all(ioopm_soa_table_t *st, ioopm_predicate pred, void *arg){
+  if(!st || !pred) return false;
+
+  for(size_t i = 0; i < st->size; ++i){
+    if(!pred(st->keys[i], st->values[i], arg)) return false;
+  }
+
+  return true;
+}
+
+void ioopm_soa_table_apply_to_all(ioopm_soa_table_t *st, ioopm_apply_function apply_fun, void *arg){
+  if(!st || !apply_fun) return;
+
+  for(size_t i = 0; i < st->size; ++i){
+    apply_fun(st->keys[i], &st->values[i], arg);
+  }
+}
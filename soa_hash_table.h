@@ -0,0 +1,160 @@
+// soa_hash_table.h
+
+#ifndef SOA_HASH_TABLE_H
+#define SOA_HASH_TABLE_H
+
+/**
+ * @file soa_hash_table.h
+ * @brief Hash table that stores hashes, keys and values in separate dense arrays.
+ *
+ * The n entries of the table occupy positions 0..n-1 of three parallel
+ * arrays (structure of arrays), and a small open-addressing index of 32-bit
+ * positions maps keys to entries. Removing an entry moves the last entry into
+ * its place, so the arrays never have holes. Operations on values therefore
+ * stream one contiguous array: has_value, any, all and values read 8 bytes per
+ * entry instead of a whole chained entry, and the element-wise scans
+ * ioopm_soa_table_has_int_value and ioopm_soa_table_sum_values are plain loops
+ * that gcc vectorizes at -O3 (or -O2 -fvect-cost-model=cheap). Stored hashes
+ * let lookups skip most key comparisons and let the index grow without
+ * calling the hash function.
+ *
+ * Keys and values are elem_t and the functions follow hash_table.h, except
+ * that insert reports failure (memory allocation) and the table can be
+ * sized in advance with ioopm_soa_table_reserve.
+ */
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "hash_table.h"
+
+/*
+ * =========================================
+ * SECTION: Custom Data Types And Aliases
+ * =========================================
+ */
+
+typedef struct soa_table ioopm_soa_table_t;
+
+
+/*
+ * =========================================
+ * SECTION: Function Declarations
+ * =========================================
+ */
+
+/// @brief Create a new, empty table.
+/// @param hash_func Function used to hash keys (the result is mixed before use).
+/// @param key_eq_func Function used to compare keys for equality.
+/// @param value_eq_func Function used to compare values, only needed by has_value.
+/// @return A new table, or NULL if memory allocation fails.
+ioopm_soa_table_t *ioopm_soa_table_create(ioopm_hash_function hash_func, ioopm_eq_function key_eq_func, ioopm_eq_function value_eq_func);
+
+/// @brief Delete a table and free its memory (keys and values are not freed).
+/// @param st Table to delete.
+void ioopm_soa_table_destroy(ioopm_soa_table_t *st);
+
+/// @brief Add a key => value entry, replacing the value if the key is already present.
+/// @param st Table operated upon.
+/// @param key Key to insert.
+/// @param value Value to insert.
+/// @return true on success, false if memory allocation fails (the table is then unchanged).
+bool ioopm_soa_table_insert(ioopm_soa_table_t *st, elem_t key, elem_t value);
+
+/// @brief Lookup the value for a key.
+/// @param st Table operated upon.
+/// @param key Key to look up.
+/// @return Success with the value if the key is present, Failure otherwise.
+option_t ioopm_soa_table_lookup(ioopm_soa_table_t *st, elem_t key);
+
+/// @brief Remove an entry.
+/// @param st Table operated upon.
+/// @param key Key to remove.
+/// @return Success with the removed value if the key was present, Failure otherwise.
+/// @note The last entry is moved into the freed position, which changes the order of keys and values.
+option_t ioopm_soa_table_remove(ioopm_soa_table_t *st, elem_t key);
+
+/// @brief Returns the number of entries in the table.
+/// @param st Table operated upon.
+/// @return The number of entries.
+size_t ioopm_soa_table_size(ioopm_soa_table_t *st);
+
+/// @brief Checks if the table is empty.
+/// @param st Table operated upon.
+/// @return true if size == 0, false otherwise.
+bool ioopm_soa_table_is_empty(ioopm_soa_table_t *st);
+
+/// @brief Remove all entries, keeping the allocated arrays.
+/// @param st Table operated upon.
+void ioopm_soa_table_clear(ioopm_soa_table_t *st);
+
+/// @brief Grow the table so that it holds no_keys entries without growing again.
+/// @param st Table operated upon.
+/// @param no_keys Number of entries to make room for.
+/// @return true on success, false if memory allocation fails (the table is then unchanged).
+bool ioopm_soa_table_reserve(ioopm_soa_table_t *st, size_t no_keys);
+
+/// @brief Checks if a key is in the table.
+/// @param st Table operated upon.
+/// @param key Key to check for.
+/// @return true if the key is present, false otherwise.
+bool ioopm_soa_table_has_key(ioopm_soa_table_t *st, elem_t key);
+
+/// @brief Checks if a value is in the table.
+/// @param st Table operated upon.
+/// @param value Value to check for.
+/// @return true if some entry has the value, false otherwise.
+bool ioopm_soa_table_has_value(ioopm_soa_table_t *st, elem_t value);
+
+/// @brief Checks if some entry has an integer value, comparing intValue directly.
+/// @param st Table operated upon.
+/// @param value Value to check for.
+/// @return true if some entry's intValue equals value, false otherwise.
+/// @note Compares a block of values at a time without calling value_eq_func, so the loop vectorizes.
+bool ioopm_soa_table_has_int_value(ioopm_soa_table_t *st, int value);
+
+/// @brief Returns the sum of all values read as 64-bit counters (elem_t.uint64Value).
+/// @param st Table operated upon.
+/// @return The sum, wrapping around on overflow; 0 for an empty table.
+uint64_t ioopm_soa_table_sum_values(ioopm_soa_table_t *st);
+
+/// @brief Returns the keys of the table, in position order.
+/// @param st Table operated upon.
+/// @return A new list of keys (to be destroyed by the caller).
+ioopm_list_t *ioopm_soa_table_keys(ioopm_soa_table_t *st);
+
+/// @brief Returns the values of the table, in the same order as the keys.
+/// @param st Table operated upon.
+/// @return A new list of values (to be destroyed by the caller).
+ioopm_list_t *ioopm_soa_table_values(ioopm_soa_table_t *st);
+
+/// @brief Checks if a predicate holds for any entry.
+/// @param st Table operated upon.
+/// @param pred The predicate.
+/// @param arg Extra argument passed to pred.
+/// @return true if pred holds for at least one entry, false otherwise.
+bool ioopm_soa_table_any(ioopm_soa_table_t *st, ioopm_predicate pred, void *arg);
+
+/// @brief Checks if a predicate holds for all entries.
+/// @param st Table operated upon.
+/// @param pred The predicate.
+/// @param arg Extra argument passed to pred.
+/// @return true if pred holds for every entry (or the table is empty), false otherwise.
+bool ioopm_soa_table_all(ioopm_soa_table_t *st, ioopm_predicate pred, void *arg);
+
+/// @brief Apply a function to every entry, which may change the values.
+/// @param st Table operated upon.
+/// @param apply_fun Function called with each key and a pointer to its value.
+/// @param arg Extra argument passed to apply_fun.
+void ioopm_soa_table_apply_to_all(ioopm_soa_table_t *st, ioopm_apply_function apply_fun, void *arg);
+
+
+
+#endif // SOA_HASH_TABLE_H
@@ -0,0 +1,140 @@
+// soa_hash_table_bench.c
+
+/**
+ * @file soa_hash_table_bench.c
+ * @brief Value scans over the structure-of-arrays table, next to the chained hash table.
+ *
+ * For several table sizes both tables get the same keys and values, then
+ * every value is scanned repeatedly: has_value for a value that is absent
+ * (so the whole table is read), and a sum over the values read as counters.
+ * The SoA table is timed both through the generic callbacks and through its
+ * vectorized scans. Build and run with: make bench_soa_hash_table
+ */
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "soa_hash_table.h"
+#include "hash_table.h"
+
+/// Entries scanned per measurement, divided over repeated scans of the table.
+#define Bench_Scanned (1 << 24)
+
+/// Multiplying by an odd constant is a bijection on 32 bits, so keys i * Key_Spread are distinct.
+#define Key_Spread 2654435761u
+
+
+/*
+ * =========================================
+ * SECTION: Private Function Definitions
+ * =========================================
+ */
+
+/// @brief Hash function for integer keys.
+static size_t int_hash_function(elem_t key) {
+  return (size_t)key.uintValue;
+}
+
+/// @brief Equality function for integer keys and values.
+static bool int_eq_function(elem_t a, elem_t b) {
+  return a.intValue == b.intValue;
+}
+
+/// @brief Adds a value, read as a counter, to the sum pointed to by extra.
+static void add_to_sum(elem_t key, elem_t *value, void *extra) {
+  *(uint64_t *)extra += value->uint64Value;
+}
+
+/// @brief Returns the current time in nanoseconds.
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/// @brief Returns the value stored for key number i; values are non-negative, so -1 is absent.
+static elem_t bench_value(size_t i) {
+  return (elem_t){.uint64Value = i % 1000};
+}
+
+/// @brief Times the value scans of both tables holding no_keys entries.
+/// @param no_keys Number of entries.
+/// @param result Array receiving the ns per scanned entry of: chained has_value, SoA has_value,
+///               SoA has_int_value, chained sum, SoA sum through apply_to_all and SoA sum_values.
+static void bench_scans(size_t no_keys, double result[6]) {
+  ioopm_hash_table_t *ht = ioopm_hash_table_create(int_hash_function, int_eq_function, int_eq_function);
+  ioopm_soa_table_t *st = ioopm_soa_table_create(int_hash_function, int_eq_function, int_eq_function);
+  ioopm_soa_table_reserve(st, no_keys);
+
+  for (size_t i = 0; i < no_keys; ++i) {
+    elem_t key = {.uintValue = (unsigned int)i * Key_Spread};
+    ioopm_hash_table_insert(ht, key, bench_value(i));
+    ioopm_soa_table_insert(st, key, bench_value(i));
+  }
+
+  size_t rounds = Bench_Scanned / no_keys;
+  size_t found = 0;
+  uint64_t sums[3] = {0};
+  double start;
+
+  start = now_ns();
+  for (size_t r = 0; r < rounds; ++r) found += ioopm_hash_table_has_value(ht, int_elem(-1));
+  result[0] = (now_ns() - start) / ((double)rounds * no_keys);
+
+  start = now_ns();
+  for (size_t r = 0; r < rounds; ++r) found += ioopm_soa_table_has_value(st, int_elem(-1));
+  result[1] = (now_ns() - start) / ((double)rounds * no_keys);
+
+  start = now_ns();
+  for (size_t r = 0; r < rounds; ++r) found += ioopm_soa_table_has_int_value(st, -1);
+  result[2] = (now_ns() - start) / ((double)rounds * no_keys);
+
+  start = now_ns();
+  for (size_t r = 0; r < rounds; ++r) ioopm_hash_table_apply_to_all(ht, add_to_sum, &sums[0]);
+  result[3] = (now_ns() - start) / ((double)rounds * no_keys);
+
+  start = now_ns();
+  for (size_t r = 0; r < rounds; ++r) ioopm_soa_table_apply_to_all(st, add_to_sum, &sums[1]);
+  result[4] = (now_ns() - start) / ((double)rounds * no_keys);
+
+  start = now_ns();
+  for (size_t r = 0; r < rounds; ++r) sums[2] += ioopm_soa_table_sum_values(st);
+  result[5] = (now_ns() - start) / ((double)rounds * no_keys);
+
+  if (found != 0 || sums[0] != sums[1] || sums[1] != sums[2]) {
+    fprintf(stderr, "unexpected result\n");
+  }
+  ioopm_hash_table_destroy(ht);
+  ioopm_soa_table_destroy(st);
+}
+
+
+/*
+ * =========================================
+ * SECTION: Main
+ * =========================================
+ */
+
+int main() {
+  size_t sizes[] = {1 << 12, 1 << 16, 1 << 20};
+
+  printf("%d entries scanned per column, ns/entry\n", Bench_Scanned);
+  printf("keys     | has_value: chained    soa  soa int | sum: chained  soa apply  soa sum\n");
+
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+    double result[6];
+    bench_scans(sizes[i], result);
+
+    printf("%-8zu |           %6.2f %6.2f  %6.2f  |     %6.2f    %6.2f   %6.2f\n", sizes[i],
+           result[0], result[1], result[2], result[3], result[4], result[5]);
+  }
+
+  return 0;
+}
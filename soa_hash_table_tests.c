@@ -0,0 +1,247 @@
+// soa_hash_table_tests.c
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include <CUnit/Basic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "soa_hash_table.h"
+
+/// @brief Number of keys in the large tables.
+#define NUM_KEYS 10000
+
+
+/*
+ * =========================================
+ * SECTION: Private Function Definitions
+ * =========================================
+ */
+
+/// @brief Hash function for integer keys.
+/// @param key The key to hash.
+/// @return The hash value.
+static size_t int_hash_function(elem_t key) {
+    return (size_t)key.intValue;
+}
+
+/// @brief Equality function for integer keys and values.
+/// @param a The first element.
+/// @param b The second element.
+/// @return true if the elements are equal.
+static bool int_eq_function(elem_t a, elem_t b) {
+    return a.intValue == b.intValue;
+}
+
+/// @brief Hash function that sends all keys to the same index slot.
+/// @param key The key to hash (unused).
+/// @return The same hash for every key.
+static size_t constant_hash_function(elem_t key) {
+    return 0;
+}
+
+/// @brief Predicate that checks if a value is non-negative.
+static bool value_is_non_negative(elem_t key, elem_t value, void *extra) {
+    return value.intValue >= 0;
+}
+
+/// @brief Predicate that checks if a key equals the integer pointed to by extra.
+static bool key_equals(elem_t key, elem_t value, void *extra) {
+    return key.intValue == *(int *)extra;
+}
+
+/// @brief Adds one to an integer value.
+static void increment_value(elem_t key, elem_t *value, void *extra) {
+    value->intValue += 1;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Initialize and clean the suite
+ * =========================================
+ */
+
+int init_suite(void) {
+  return 0;
+}
+
+int clean_suite(void) {
+  return 0;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Tests
+ * =========================================
+ */
+
+void test_insert_lookup_remove() {
+  ioopm_soa_table_t *st = ioopm_soa_table_create(int_hash_function, int_eq_function, int_eq_function);
+  CU_ASSERT_TRUE(ioopm_soa_table_is_empty(st));
+
+  for (int i = 0; i < NUM_KEYS; ++i) {
+    CU_ASSERT_TRUE(ioopm_soa_table_insert(st, int_elem(i), int_elem(i * 2)));
+  }
+  CU_ASSERT_TRUE(ioopm_soa_table_insert(st, int_elem(7), int_elem(-7)));
+  CU_ASSERT_EQUAL(ioopm_soa_table_size(st), NUM_KEYS);
+  CU_ASSERT_EQUAL(ioopm_soa_table_lookup(st, int_elem(7)).value.intValue, -7);
+
+  // Remove every other key, which moves entries from the end into the gaps
+  for (int i = 0; i < NUM_KEYS; i += 2) {
+    CU_ASSERT(Successful(ioopm_soa_table_remove(st, int_elem(i))));
+  }
+  CU_ASSERT(Unsuccessful(ioopm_soa_table_remove(st, int_elem(0))));
+  CU_ASSERT_EQUAL(ioopm_soa_table_size(st), NUM_KEYS / 2);
+
+  for (int i = 0; i < NUM_KEYS; ++i) {
+    option_t found = ioopm_soa_table_lookup(st, int_elem(i));
+    if (i % 2 == 0) {
+      CU_ASSERT(Unsuccessful(found));
+    } else if (i != 7) {
+      CU_ASSERT(Successful(found) && found.value.intValue == i * 2);
+    }
+  }
+
+  ioopm_soa_table_clear(st);
+  CU_ASSERT_TRUE(ioopm_soa_table_is_empty(st));
+  CU_ASSERT_FALSE(ioopm_soa_table_has_key(st, int_elem(1)));
+  ioopm_soa_table_destroy(st);
+}
+
+void test_colliding_keys() {
+  ioopm_soa_table_t *st = ioopm_soa_table_create(constant_hash_function, int_eq_function, int_eq_function);
+  CU_ASSERT_TRUE(ioopm_soa_table_reserve(st, 100));
+
+  for (int i = 0; i < 100; ++i) {
+    ioopm_soa_table_insert(st, int_elem(i), int_elem(i));
+  }
+  // Removing from the middle of one long probe sequence must keep the rest reachable
+  for (int i = 0; i < 100; i += 3) {
+    CU_ASSERT(Successful(ioopm_soa_table_remove(st, int_elem(i))));
+  }
+  for (int i = 0; i < 100; ++i) {
+    CU_ASSERT_EQUAL(ioopm_soa_table_has_key(st, int_elem(i)), i % 3 != 0);
+  }
+
+  ioopm_soa_table_destroy(st);
+}
+
+void test_value_scans() {
+  ioopm_soa_table_t *st = ioopm_soa_table_create(int_hash_function, int_eq_function, int_eq_function);
+  CU_ASSERT_FALSE(ioopm_soa_table_has_int_value(st, 0));
+  CU_ASSERT_EQUAL(ioopm_soa_table_sum_values(st), 0);
+
+  // 1000 values, so both full blocks and the tail are scanned
+  uint64_t expected_sum = 0;
+  for (int i = 0; i < 1000; ++i) {
+    ioopm_soa_table_insert(st, int_elem(i), (elem_t){.uint64Value = i * 3});
+    expected_sum += i * 3;
+  }
+  CU_ASSERT_EQUAL(ioopm_soa_table_sum_values(st), expected_sum);
+
+  CU_ASSERT_TRUE(ioopm_soa_table_has_int_value(st, 0));
+  CU_ASSERT_TRUE(ioopm_soa_table_has_int_value(st, 2997));
+  CU_ASSERT_TRUE(ioopm_soa_table_has_int_value(st, 1500));
+  CU_ASSERT_FALSE(ioopm_soa_table_has_int_value(st, 1501));
+  CU_ASSERT_TRUE(ioopm_soa_table_has_value(st, int_elem(2997)));
+  CU_ASSERT_FALSE(ioopm_soa_table_has_value(st, int_elem(3000)));
+
+  ioopm_soa_table_destroy(st);
+}
+
+void test_keys_values() {
+  ioopm_soa_table_t *st = ioopm_soa_table_create(int_hash_function, int_eq_function, int_eq_function);
+  for (int i = 0; i < 50; ++i) {
+    ioopm_soa_table_insert(st, int_elem(i), int_elem(i + 100));
+  }
+  ioopm_soa_table_remove(st, int_elem(10));
+
+  ioopm_list_t *keys = ioopm_soa_table_keys(st);
+  ioopm_list_t *values = ioopm_soa_table_values(st);
+  size_t no_keys = 0, no_values = 0;
+  ioopm_linked_list_size(keys, &no_keys);
+  ioopm_linked_list_size(values, &no_values);
+  CU_ASSERT_EQUAL(no_keys, 49);
+  CU_ASSERT_EQUAL(no_values, 49);
+
+  for (int i = 0; i < 49; ++i) {
+    elem_t key, value;
+    ioopm_linked_list_get(keys, i, &key);
+    ioopm_linked_list_get(values, i, &value);
+    CU_ASSERT_EQUAL(value.intValue, key.intValue + 100);
+  }
+
+  ioopm_linked_list_destroy(keys);
+  ioopm_linked_list_destroy(values);
+  ioopm_soa_table_destroy(st);
+}
+
+void test_predicates_apply() {
+  ioopm_soa_table_t *st = ioopm_soa_table_create(int_hash_function, int_eq_function, int_eq_function);
+  CU_ASSERT_TRUE(ioopm_soa_table_all(st, value_is_non_negative, NULL));
+
+  for (int i = 0; i < 100; ++i) {
+    ioopm_soa_table_insert(st, int_elem(i), int_elem(i - 1));
+  }
+  int wanted = 42;
+  CU_ASSERT_TRUE(ioopm_soa_table_any(st, key_equals, &wanted));
+  CU_ASSERT_FALSE(ioopm_soa_table_all(st, value_is_non_negative, NULL));
+
+  ioopm_soa_table_apply_to_all(st, increment_value, NULL);
+  CU_ASSERT_TRUE(ioopm_soa_table_all(st, value_is_non_negative, NULL));
+  CU_ASSERT_EQUAL(ioopm_soa_table_lookup(st, int_elem(42)).value.intValue, 42);
+
+  ioopm_soa_table_destroy(st);
+}
+
+
+/*
+ * =========================================
+ * SECTION: Main
+ * =========================================
+ */
+
+int main() {
+  // First we try to set up CUnit, and exit if we fail
+  if (CU_initialize_registry() != CUE_SUCCESS)
+    return CU_get_error();
+
+  // We then create an empty test suite and specify the name and
+  // the init and cleanup functions
+  CU_pSuite my_test_suite = CU_add_suite("Unit tests for SoA hash table", init_suite, clean_suite);
+  if (my_test_suite == NULL) {
+      // If the test suite could not be added, tear down CUnit and exit
+      CU_cleanup_registry();
+      return CU_get_error();
+  }
+
+  if (
+    (CU_add_test(my_test_suite, "Insert, lookup and remove", test_insert_lookup_remove) == NULL) ||
+    (CU_add_test(my_test_suite, "Keys with the same hash", test_colliding_keys) == NULL) ||
+    (CU_add_test(my_test_suite, "Vectorized value scans", test_value_scans) == NULL) ||
+    (CU_add_test(my_test_suite, "Keys and values line up", test_keys_values) == NULL) ||
+    (CU_add_test(my_test_suite, "Any, all and apply to all", test_predicates_apply) == NULL) ||
+    0
+  )
+    {
+      // If adding any of the tests fails, we tear down CUnit and exit
+      CU_cleanup_registry();
+      return CU_get_error();
+    }
+
+  // Set the running mode. Use CU_BRM_VERBOSE for maximum output.
+  // Use CU_BRM_NORMAL to only print errors and a summary
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+
+  // This is where the tests are actually run!
+  CU_basic_run_tests();
+
+  // Tear down CUnit before exiting
+  CU_cleanup_registry();
+  return CU_get_error();
+}
@@ -0,0 +1,298 @@
+// space_saving.c
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "space_saving.h"
+
+/*
+ * =========================================
+ * SECTION: Custom Data Types And Aliases
+ * =========================================
+ */
+
+typedef struct counter counter_t;
+typedef struct count_bucket count_bucket_t;
+
+/// A monitored item. Its count is the count of the bucket it belongs to.
+struct counter
+{
+  elem_t key;
+  uint64_t error;
+  count_bucket_t *bucket;
+  counter_t *prev;
+  counter_t *next;
+};
+
+/// All counters with the same count. Buckets form a list sorted by ascending count.
+struct count_bucket
+{
+  uint64_t count;
+  counter_t *counters;
+  count_bucket_t *prev;
+  count_bucket_t *next;
+};
+
+/// Counters and buckets are preallocated: there are never more buckets than counters,
+/// so unused buckets are kept in a free list (linked through next).
+struct space_saving
+{
+  size_t capacity;
+  size_t size;
+  uint64_t total;
+  counter_t *counters;
+  count_bucket_t *buckets;
+  count_bucket_t *free_buckets;
+  count_bucket_t *min_bucket;
+  count_bucket_t *max_bucket;
+  ioopm_hash_table_t *index;          /// Maps a key to its counter.
+  ioopm_copy_function copy_func;
+  ioopm_free_function free_func;
+};
+
+
+/*
+ * =========================================
+ * SECTION: Function Definitions
+ * =========================================
+ */
+
+/// @brief Takes a bucket from the free list and links it into the bucket list after prev.
+/// @param ss The summary.
+/// @param prev The bucket to insert after, or NULL to insert first.
+/// @param count The count of the new bucket.
+/// @return The new bucket.
+static count_bucket_t *bucket_insert_after(ioopm_space_saving_t *ss, count_bucket_t *prev, uint64_t count){
+  count_bucket_t *bucket = ss->free_buckets;
+  ss->free_buckets = bucket->next;
+
+  bucket->count = count;
+  bucket->counters = NULL;
+  bucket->prev = prev;
+  bucket->next = prev ? prev->next : ss->min_bucket;
+
+  if(bucket->next) bucket->next->prev = bucket;
+  else ss->max_bucket = bucket;
+
+  if(prev) prev->next = bucket;
+  else ss->min_bucket = bucket;
+
+  return bucket;
+}
+
+/// @brief Unlinks an empty bucket from the bucket list and returns it to the free list.
+/// @param ss The summary.
+/// @param bucket The bucket to remove.
+static void bucket_remove(ioopm_space_saving_t *ss, count_bucket_t *bucket){
+  if(bucket->prev) bucket->prev->next = bucket->next;
+  else ss->min_bucket = bucket->next;
+
+  if(bucket->next) bucket->next->prev = bucket->prev;
+  else ss->max_bucket = bucket->prev;
+
+  bucket->next = ss->free_buckets;
+  ss->free_buckets = bucket;
+}
+
+/// @brief Adds a counter to a bucket.
+/// @param bucket The bucket.
+/// @param counter The counter.
+static void bucket_attach(count_bucket_t *bucket, counter_t *counter){
+  counter->bucket = bucket;
+  counter->prev = NULL;
+  counter->next = bucket->counters;
+  if(bucket->counters) bucket->counters->prev = counter;
+  bucket->counters = counter;
+}
+
+/// @brief Removes a counter from its bucket.
+/// @param counter The counter.
+static void bucket_detach(counter_t *counter){
+  count_bucket_t *bucket = counter->bucket;
+
+  if(counter->prev) counter->prev->next = counter->next;
+  else bucket->counters = counter->next;
+
+  if(counter->next) counter->next->prev = counter->prev;
+  counter->bucket = NULL;
+}
+
+/// @brief Moves a counter to the bucket for its count + 1.
+/// @param ss The summary.
+/// @param counter The counter to increment.
+static void counter_increment(ioopm_space_saving_t *ss, counter_t *counter){
+  count_bucket_t *bucket = counter->bucket;
+  count_bucket_t *next = bucket->next;
+  uint64_t count = bucket->count + 1;
+
+  bucket_detach(counter);
+
+  if(next && next->count == count){
+    bucket_attach(next, counter);
+    if(!bucket->counters) bucket_remove(ss, bucket);
+  }
+  else if(!bucket->counters){
+    // The bucket stays between its neighbours, so it can simply take the new count
+    bucket->count = count;
+    bucket_attach(bucket, counter);
+  }
+  else{
+    bucket_attach(bucket_insert_after(ss, bucket, count), counter);
+  }
+}
+
+/// @brief Starts monitoring a key in a counter, with an initial count of error + 1.
+/// @param ss The summary.
+/// @param counter A counter that is not in any bucket.
+/// @param key The (already copied) key, which the index already maps to counter.
+/// @param error The count inherited from an evicted item, 0 for a fresh counter.
+static void counter_start(ioopm_space_saving_t *ss, counter_t *counter, elem_t key, uint64_t error){
+  counter->key = key;
+  counter->error = error;
+
+  count_bucket_t *first = ss->min_bucket;
+  uint64_t count = error + 1;
+
+  if(first && first->count == count){
+    bucket_attach(first, counter);
+  }
+  else if(first && first->count < count){
+    // Only after an eviction, count is then the smallest count + 1 so this is at most two steps
+    count_bucket_t *prev = first;
+    while(prev->next && prev->next->count <= count) prev = prev->next;
+    bucket_attach(prev->count == count ? prev : bucket_insert_after(ss, prev, count), counter);
+  }
+  else{
+    bucket_attach(bucket_insert_after(ss, NULL, count), counter);
+  }
+}
+
+
+ioopm_space_saving_t *ioopm_space_saving_create(size_t capacity, ioopm_hash_function hash_func, ioopm_eq_function key_eq_func,
+                                                ioopm_copy_function copy_func, ioopm_free_function free_func){
+  if(capacity == 0) return NULL;
+
+  ioopm_space_saving_t *ss = calloc(1, sizeof(ioopm_space_saving_t));
+  if(!ss) return NULL;
+
+  ss->counters = calloc(capacity, sizeof(counter_t));
+  ss->buckets = calloc(capacity, sizeof(count_bucket_t));
+  ss->index = ioopm_hash_table_create(hash_func, key_eq_func, NULL);
+  if(!ss->counters || !ss->buckets || !ss->index){
+    ioopm_space_saving_destroy(ss);
+    return NULL;
+  }
+
+  for(size_t i = 0; i + 1 < capacity; ++i){
+    ss->buckets[i].next = &ss->buckets[i + 1];
+  }
+  ss->free_buckets = ss->buckets;
+  ss->capacity = capacity;
+  ss->copy_func = copy_func;
+  ss->free_func = free_func;
+
+  return ss;
+}
+
+void ioopm_space_saving_destroy(ioopm_space_saving_t *ss){
+  if(!ss) return;
+
+  if(ss->free_func){
+    for(size_t i = 0; i < ss->size; ++i){
+      ss->free_func(ss->counters[i].key);
+    }
+  }
+
+  if(ss->index) ioopm_hash_table_destroy(ss->index);
+  free(ss->counters);
+  free(ss->buckets);
+  free(ss);
+}
+
+bool ioopm_space_saving_add(ioopm_space_saving_t *ss, elem_t key){
+  if(!ss) return false;
+
+  option_t found = ioopm_hash_table_lookup(ss->index, key);
+  if(Successful(found)){
+    counter_increment(ss, found.value.ptrValue);
+    ss->total++;
+    return true;
+  }
+
+  elem_t owned_key = key;
+  if(ss->copy_func){
+    owned_key = ss->copy_func(key);
+    if(!owned_key.ptrValue) return false;
+  }
+
+  // The index is the only part that allocates, so it is updated before anything else changes
+  counter_t *counter = ss->size < ss->capacity ? &ss->counters[ss->size] : ss->min_bucket->counters;
+  size_t size_before = ioopm_hash_table_size(ss->index);
+  ioopm_hash_table_insert(ss->index, owned_key, ptr_elem(counter));
+  if((size_t)ioopm_hash_table_size(ss->index) == size_before){
+    if(ss->copy_func && ss->free_func) ss->free_func(owned_key);
+    return false;
+  }
+
+  if(ss->size < ss->capacity){
+    ss->size++;
+    counter_start(ss, counter, owned_key, 0);
+  }
+  else{
+    // Replace one of the items with the smallest count
+    counter_t *victim = counter;
+    uint64_t min_count = ss->min_bucket->count;
+
+    ioopm_hash_table_remove(ss->index, victim->key);
+    if(ss->free_func) ss->free_func(victim->key);
+
+    bucket_detach(victim);
+    if(!ss->min_bucket->counters) bucket_remove(ss, ss->min_bucket);
+
+    counter_start(ss, victim, owned_key, min_count);
+  }
+
+  ss->total++;
+  return true;
+}
+
+bool ioopm_space_saving_lookup(ioopm_space_saving_t *ss, elem_t key, ioopm_heavy_hitter_t *result){
+  if(!ss) return false;
+
+  option_t found = ioopm_hash_table_lookup(ss->index, key);
+  if(Unsuccessful(found)) return false;
+
+  counter_t *counter = found.value.ptrValue;
+  if(result){
+    *result = (ioopm_heavy_hitter_t){.key = counter->key, .count = counter->bucket->count, .error = counter->error};
+  }
+
+  return true;
+}
+
+uint64_t ioopm_space_saving_total(ioopm_space_saving_t *ss){
+  return ss ? ss->total : 0;
+}
+
+size_t ioopm_space_saving_size(ioopm_space_saving_t *ss){
+  return ss ? ss->size : 0;
+}
+
+size_t ioopm_space_saving_top(ioopm_space_saving_t *ss, ioopm_heavy_hitter_t *top, size_t k){
+  if(!ss || !top) return 0;
+
+  size_t written = 0;
+  for(count_bucket_t *bucket = ss->max_bucket; bucket && written < k; bucket = bucket->prev){
+    for(counter_t *counter = bucket->counters; counter && written < k; counter = counter->next){
+      top[written++] = (ioopm_heavy_hitter_t){.key = counter->key, .count = bucket->count, .error = counter->error};
+    }
+  }
+
+  return written;
+}
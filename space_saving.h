@@ -0,0 +1,102 @@
+// space_saving.h
+
+#ifndef SPACE_SAVING_H
+#define SPACE_SAVING_H
+
+/**
+ * @file space_saving.h
+ * @brief Space-Saving summary that tracks the most frequent items of a stream.
+ *
+ * The summary monitors at most capacity items, so memory is O(capacity) no
+ * matter how many distinct items the stream has. When a new item arrives
+ * and all counters are taken, it replaces the item with the smallest count
+ * and inherits that count as its error. Every reported count c with error e
+ * satisfies c - e <= true count <= c, and any item occurring more than
+ * total / capacity times is guaranteed to be monitored. Counters are kept in
+ * a stream-summary (a list of buckets of equal count), so each update is O(1).
+ */
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hash_table.h"
+
+/*
+ * =========================================
+ * SECTION: Custom Data Types And Aliases
+ * =========================================
+ */
+
+typedef struct space_saving ioopm_space_saving_t;
+typedef struct heavy_hitter ioopm_heavy_hitter_t;
+
+/// @brief An item reported by the summary.
+struct heavy_hitter
+{
+  elem_t key;       /// The monitored item.
+  uint64_t count;   /// Upper bound of its true count.
+  uint64_t error;   /// Maximum overestimation, so count - error is a lower bound.
+};
+
+
+/*
+ * =========================================
+ * SECTION: Function Declarations
+ * =========================================
+ */
+
+/// @brief Create a new, empty summary.
+/// @param capacity Maximum number of monitored items (use a few times the K of interest).
+/// @param hash_func Function used to hash keys.
+/// @param key_eq_func Function used to compare keys for equality.
+/// @param copy_func Called when an item starts being monitored, e.g. to strdup a transient
+///                  string (returning a NULL ptrValue on failure); NULL stores the key as is.
+/// @param free_func Called when a monitored key is evicted or the summary is destroyed; may be NULL.
+/// @return A new summary, or NULL if capacity is 0 or memory allocation fails.
+ioopm_space_saving_t *ioopm_space_saving_create(size_t capacity, ioopm_hash_function hash_func, ioopm_eq_function key_eq_func,
+                                                ioopm_copy_function copy_func, ioopm_free_function free_func);
+
+/// @brief Delete a summary and free its memory.
+/// @param ss The summary to delete.
+void ioopm_space_saving_destroy(ioopm_space_saving_t *ss);
+
+/// @brief Count one occurrence of an item.
+/// @param ss The summary operated upon.
+/// @param key The item.
+/// @return true on success, false if copying the key or memory allocation fails.
+bool ioopm_space_saving_add(ioopm_space_saving_t *ss, elem_t key);
+
+/// @brief Look up the counter of a monitored item.
+/// @param ss The summary operated upon.
+/// @param key The item.
+/// @param result Pointer to store the item's counter in, if it is monitored (may be NULL).
+/// @return true if the item is monitored, false otherwise.
+bool ioopm_space_saving_lookup(ioopm_space_saving_t *ss, elem_t key, ioopm_heavy_hitter_t *result);
+
+/// @brief Returns the number of items counted so far.
+/// @param ss The summary operated upon.
+/// @return The length of the stream.
+uint64_t ioopm_space_saving_total(ioopm_space_saving_t *ss);
+
+/// @brief Returns the number of items currently monitored.
+/// @param ss The summary operated upon.
+/// @return At most the capacity of the summary.
+size_t ioopm_space_saving_size(ioopm_space_saving_t *ss);
+
+/// @brief Report the items with the highest counts, in descending order of count.
+/// @param ss The summary operated upon.
+/// @param top Array that receives the items.
+/// @param k Size of the array.
+/// @return The number of items written, min(k, size).
+size_t ioopm_space_saving_top(ioopm_space_saving_t *ss, ioopm_heavy_hitter_t *top, size_t k);
+
+
+
+#endif // SPACE_SAVING_H
@@ -0,0 +1,235 @@
+// space_saving_tests.c
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include <CUnit/Basic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "space_saving.h"
+
+/// @brief Length of the skewed stream used in the accuracy tests.
+#define STREAM_LENGTH 100000
+
+
+/*
+ * =========================================
+ * SECTION: Private Function Definitions
+ * =========================================
+ */
+
+/// @brief Hash function for integer keys.
+/// @param key The key to hash.
+/// @return The hash value.
+static size_t int_hash_function(elem_t key) {
+    return (size_t)key.intValue;
+}
+
+/// @brief Equality function for integer keys.
+/// @param a The first key.
+/// @param b The second key.
+/// @return true if the keys are equal.
+static bool int_eq_function(elem_t a, elem_t b) {
+    return a.intValue == b.intValue;
+}
+
+/// @brief Equality function for string keys.
+/// @param a The first key.
+/// @param b The second key.
+/// @return true if the strings are equal.
+static bool string_eq_function(elem_t a, elem_t b) {
+    return strcmp(a.ptrValue, b.ptrValue) == 0;
+}
+
+/// @brief Copies a string key.
+/// @param key The key to copy.
+/// @return The copy.
+static elem_t string_copy_function(elem_t key) {
+    return ptr_elem(strdup(key.ptrValue));
+}
+
+/// @brief Frees a string key.
+/// @param key The key to free.
+static void string_free_function(elem_t key) {
+    free(key.ptrValue);
+}
+
+
+/*
+ * =========================================
+ * SECTION: Initialize and clean the suite
+ * =========================================
+ */
+
+int init_suite(void) {
+  return 0;
+}
+
+int clean_suite(void) {
+  return 0;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Tests
+ * =========================================
+ */
+
+void test_create_destroy() {
+  ioopm_space_saving_t *ss = ioopm_space_saving_create(10, int_hash_function, int_eq_function, NULL, NULL);
+  CU_ASSERT_PTR_NOT_NULL(ss);
+  CU_ASSERT_EQUAL(ioopm_space_saving_total(ss), 0);
+  CU_ASSERT_EQUAL(ioopm_space_saving_size(ss), 0);
+  CU_ASSERT_FALSE(ioopm_space_saving_lookup(ss, int_elem(1), NULL));
+  ioopm_space_saving_destroy(ss);
+
+  CU_ASSERT_PTR_NULL(ioopm_space_saving_create(0, int_hash_function, int_eq_function, NULL, NULL));
+}
+
+void test_exact_below_capacity() {
+  ioopm_space_saving_t *ss = ioopm_space_saving_create(10, int_hash_function, int_eq_function, NULL, NULL);
+
+  // Key i is added i times
+  for (int i = 1; i <= 5; ++i) {
+    for (int j = 0; j < i; ++j) {
+      CU_ASSERT_TRUE(ioopm_space_saving_add(ss, int_elem(i)));
+    }
+  }
+  CU_ASSERT_EQUAL(ioopm_space_saving_total(ss), 15);
+  CU_ASSERT_EQUAL(ioopm_space_saving_size(ss), 5);
+
+  ioopm_heavy_hitter_t top[10];
+  CU_ASSERT_EQUAL(ioopm_space_saving_top(ss, top, 10), 5);
+  for (int i = 0; i < 5; ++i) {
+    CU_ASSERT_EQUAL(top[i].key.intValue, 5 - i);
+    CU_ASSERT_EQUAL(top[i].count, (uint64_t)(5 - i));
+    CU_ASSERT_EQUAL(top[i].error, 0);
+  }
+
+  CU_ASSERT_EQUAL(ioopm_space_saving_top(ss, top, 2), 2);
+  CU_ASSERT_EQUAL(top[0].key.intValue, 5);
+  CU_ASSERT_EQUAL(top[1].key.intValue, 4);
+
+  ioopm_space_saving_destroy(ss);
+}
+
+void test_eviction_inherits_count() {
+  ioopm_space_saving_t *ss = ioopm_space_saving_create(2, int_hash_function, int_eq_function, NULL, NULL);
+
+  ioopm_space_saving_add(ss, int_elem(1));
+  ioopm_space_saving_add(ss, int_elem(1));
+  ioopm_space_saving_add(ss, int_elem(2));
+  ioopm_space_saving_add(ss, int_elem(3));
+
+  ioopm_heavy_hitter_t result;
+  CU_ASSERT_FALSE(ioopm_space_saving_lookup(ss, int_elem(2), NULL));
+  CU_ASSERT_TRUE(ioopm_space_saving_lookup(ss, int_elem(3), &result));
+  CU_ASSERT_EQUAL(result.count, 2);
+  CU_ASSERT_EQUAL(result.error, 1);
+  CU_ASSERT_TRUE(ioopm_space_saving_lookup(ss, int_elem(1), &result));
+  CU_ASSERT_EQUAL(result.count, 2);
+  CU_ASSERT_EQUAL(result.error, 0);
+  CU_ASSERT_EQUAL(ioopm_space_saving_size(ss), 2);
+
+  ioopm_space_saving_destroy(ss);
+}
+
+void test_heavy_hitters_found() {
+  ioopm_space_saving_t *ss = ioopm_space_saving_create(100, int_hash_function, int_eq_function, NULL, NULL);
+  uint64_t *counts = calloc(STREAM_LENGTH, sizeof(uint64_t));
+
+  // Keys 0..4 make up half of the stream, the rest is spread over many rare keys
+  unsigned int seed = 42;
+  for (int i = 0; i < STREAM_LENGTH; ++i) {
+    int key = i % 2 == 0 ? i / 2 % 5 : 5 + rand_r(&seed) % (STREAM_LENGTH - 5);
+    counts[key]++;
+    ioopm_space_saving_add(ss, int_elem(key));
+  }
+  CU_ASSERT_EQUAL(ioopm_space_saving_total(ss), STREAM_LENGTH);
+
+  ioopm_heavy_hitter_t top[5];
+  CU_ASSERT_EQUAL(ioopm_space_saving_top(ss, top, 5), 5);
+  for (int i = 0; i < 5; ++i) {
+    int key = top[i].key.intValue;
+    CU_ASSERT(key >= 0 && key < 5);
+    CU_ASSERT(top[i].count >= counts[key]);
+    CU_ASSERT(top[i].count - top[i].error <= counts[key]);
+    CU_ASSERT(top[i].error <= STREAM_LENGTH / 100);
+    if (i > 0) CU_ASSERT(top[i].count <= top[i - 1].count);
+  }
+
+  free(counts);
+  ioopm_space_saving_destroy(ss);
+}
+
+void test_owned_string_keys() {
+  ioopm_space_saving_t *ss = ioopm_space_saving_create(3, ioopm_string_hash, string_eq_function,
+                                                       string_copy_function, string_free_function);
+  char *words[] = {"a", "b", "a", "c", "d", "e", "a", "f", "a"};
+  char buf[8];
+
+  for (size_t i = 0; i < sizeof(words) / sizeof(words[0]); ++i) {
+    // The summary must not keep pointers into the caller's buffer
+    strcpy(buf, words[i]);
+    CU_ASSERT_TRUE(ioopm_space_saving_add(ss, ptr_elem(buf)));
+  }
+  strcpy(buf, "zzz");
+
+  ioopm_heavy_hitter_t top[1];
+  CU_ASSERT_EQUAL(ioopm_space_saving_top(ss, top, 1), 1);
+  CU_ASSERT_STRING_EQUAL(top[0].key.ptrValue, "a");
+  CU_ASSERT_EQUAL(top[0].count, 4);
+
+  ioopm_space_saving_destroy(ss);
+}
+
+
+/*
+ * =========================================
+ * SECTION: Main
+ * =========================================
+ */
+
+int main() {
+  // First we try to set up CUnit, and exit if we fail
+  if (CU_initialize_registry() != CUE_SUCCESS)
+    return CU_get_error();
+
+  // We then create an empty test suite and specify the name and
+  // the init and cleanup functions
+  CU_pSuite my_test_suite = CU_add_suite("Unit tests for space-saving summary", init_suite, clean_suite);
+  if (my_test_suite == NULL) {
+      // If the test suite could not be added, tear down CUnit and exit
+      CU_cleanup_registry();
+      return CU_get_error();
+  }
+
+  if (
+    (CU_add_test(my_test_suite, "Create and destroy summary", test_create_destroy) == NULL) ||
+    (CU_add_test(my_test_suite, "Counts are exact below capacity", test_exact_below_capacity) == NULL) ||
+    (CU_add_test(my_test_suite, "Evicting the minimum inherits its count", test_eviction_inherits_count) == NULL) ||
+    (CU_add_test(my_test_suite, "Heavy hitters of a skewed stream are found", test_heavy_hitters_found) == NULL) ||
+    (CU_add_test(my_test_suite, "String keys are copied and freed", test_owned_string_keys) == NULL) ||
+    0
+  )
+    {
+      // If adding any of the tests fails, we tear down CUnit and exit
+      CU_cleanup_registry();
+      return CU_get_error();
+    }
+
+  // Set the running mode. Use CU_BRM_VERBOSE for maximum output.
+  // Use CU_BRM_NORMAL to only print errors and a summary
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+
+  // This is where the tests are actually run!
+  CU_basic_run_tests();
+
+  // Tear down CUnit before exiting
+  CU_cleanup_registry();
+  return CU_get_error();
+}
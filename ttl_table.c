@@ -0,0 +1,347 @@
+// ttl_table.c
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "ttl_table.h"
+
+/// Each level of the wheel resolves Wheel_Bits bits of the expiry time.
+#define Wheel_Bits 6
+#define Wheel_Slots (1 << Wheel_Bits)
+
+/// Enough levels to resolve all 64 bits of a time.
+#define Wheel_Levels ((64 + Wheel_Bits - 1) / Wheel_Bits)
+
+/// Level number of entries in the due list rather than in a slot.
+#define Due_Level Wheel_Levels
+
+/*
+ * =========================================
+ * SECTION: Custom Data Types And Aliases
+ * =========================================
+ */
+
+typedef struct wheel_link wheel_link_t;
+typedef struct ttl_node ttl_node_t;
+
+/// Links of a circular, doubly-linked list. The lists of the wheel have one as sentinel.
+struct wheel_link
+{
+  wheel_link_t *prev;
+  wheel_link_t *next;
+};
+
+/// An entry. The link comes first, so that a link in a slot list can be cast to its node.
+struct ttl_node
+{
+  wheel_link_t link;
+  elem_t key;
+  elem_t value;
+  uint64_t expires;
+  uint8_t level;
+  uint8_t slot;
+};
+
+/// An entry on level l with expiry time e agrees with current on all bits above the
+/// digit of level l, and has a larger digit there, so the lowest non-empty level always
+/// holds the entries that expire first. Entries with e <= current are in the due list.
+struct ttl_table
+{
+  ioopm_hash_table_t *index;                          /// Maps a key to its node.
+  wheel_link_t slots[Wheel_Levels][Wheel_Slots];
+  uint64_t occupied[Wheel_Levels];                    /// Bitmap of non-empty slots per level.
+  wheel_link_t due;                                   /// Expired entries waiting to be reaped.
+  wheel_link_t cascade;                               /// Entries of the slot being moved down, see advance().
+  uint64_t current;                                   /// Time up to which the wheel has advanced.
+  size_t size;
+  ioopm_evict_function expire_func;
+  void *expire_arg;
+};
+
+_Static_assert(Wheel_Slots == 64, "a level's occupied bitmap is one uint64_t");
+
+
+/*
+ * =========================================
+ * SECTION: Function Definitions
+ * =========================================
+ */
+
+/// @brief Makes a list empty.
+/// @param sentinel The sentinel of the list.
+static void list_init(wheel_link_t *sentinel){
+  sentinel->prev = sentinel;
+  sentinel->next = sentinel;
+}
+
+/// @brief Checks if a list is empty.
+/// @param sentinel The sentinel of the list.
+/// @return true if the list has no entries.
+static bool list_is_empty(wheel_link_t *sentinel){
+  return sentinel->next == sentinel;
+}
+
+/// @brief Appends a link to a list.
+/// @param sentinel The sentinel of the list.
+/// @param link The link to append.
+static void list_append(wheel_link_t *sentinel, wheel_link_t *link){
+  link->prev = sentinel->prev;
+  link->next = sentinel;
+  sentinel->prev->next = link;
+  sentinel->prev = link;
+}
+
+/// @brief Puts a node in the slot (or due list) its expiry time belongs to.
+/// @param tt The table.
+/// @param node The node to schedule.
+static void schedule(ioopm_ttl_table_t *tt, ttl_node_t *node){
+  if(node->expires <= tt->current){
+    node->level = Due_Level;
+    list_append(&tt->due, &node->link);
+    return;
+  }
+
+  // The highest bit where the times differ decides the level
+  int level = (63 - __builtin_clzll(node->expires ^ tt->current)) / Wheel_Bits;
+  int slot = (node->expires >> (level * Wheel_Bits)) & (Wheel_Slots - 1);
+
+  node->level = level;
+  node->slot = slot;
+  list_append(&tt->slots[level][slot], &node->link);
+  tt->occupied[level] |= 1ULL << slot;
+}
+
+/// @brief Takes a node out of its slot (or the due list).
+/// @param tt The table.
+/// @param node The node to unschedule.
+static void unschedule(ioopm_ttl_table_t *tt, ttl_node_t *node){
+  node->link.prev->next = node->link.next;
+  node->link.next->prev = node->link.prev;
+
+  if(node->level != Due_Level && list_is_empty(&tt->slots[node->level][node->slot])){
+    tt->occupied[node->level] &= ~(1ULL << node->slot);
+  }
+}
+
+/// @brief Removes a node from the table and frees it, passing its entry to the expire callback if asked to.
+/// @param tt The table.
+/// @param node The node to remove.
+/// @param notify Whether to call the expire callback.
+static void node_remove(ioopm_ttl_table_t *tt, ttl_node_t *node, bool notify){
+  ioopm_hash_table_remove(tt->index, node->key);
+  unschedule(tt, node);
+  tt->size--;
+
+  if(notify && tt->expire_func) tt->expire_func(node->key, node->value, tt->expire_arg);
+  free(node);
+}
+
+/// @brief Finds the node of a key.
+/// @param tt The table.
+/// @param key The key to find.
+/// @return The node, or NULL if the key is not in the table.
+static ttl_node_t *node_find(ioopm_ttl_table_t *tt, elem_t key){
+  option_t found = ioopm_hash_table_lookup(tt->index, key);
+  return Successful(found) ? found.value.ptrValue : NULL;
+}
+
+/// @brief Returns now + ttl, saturating instead of wrapping around.
+static uint64_t expiry_time(uint64_t now, uint64_t ttl){
+  return now + ttl < now ? UINT64_MAX : now + ttl;
+}
+
+/// @brief Advances the wheel to the next non-empty slot, if it starts no later than now,
+///        and takes the entries of that slot into the cascade list, from which reap moves
+///        them to lower levels or the due list a bounded number at a time.
+/// @param tt The table, with an empty cascade list.
+/// @param now The current time.
+/// @return true if a slot was taken, false if nothing more is due by now.
+/// @note The nodes keep the level and slot they came from. Nothing is scheduled into that slot
+///       again while current stays within its span, which it does until the cascade list is
+///       empty, so unscheduling such a node only clears a bit that is already clear.
+static bool advance(ioopm_ttl_table_t *tt, uint64_t now){
+  int level = 0;
+  while(level < Wheel_Levels && tt->occupied[level] == 0) ++level;
+
+  if(level < Wheel_Levels){
+    int slot = __builtin_ctzll(tt->occupied[level]);
+    int shift = level * Wheel_Bits;
+    uint64_t above = shift + Wheel_Bits < 64 ? ~0ULL << (shift + Wheel_Bits) : 0;
+    uint64_t slot_start = (tt->current & above) | ((uint64_t)slot << shift);
+
+    if(slot_start <= now){
+      tt->current = slot_start;
+      tt->occupied[level] &= ~(1ULL << slot);
+
+      // Move the whole slot list over in O(1)
+      wheel_link_t *sentinel = &tt->slots[level][slot];
+      tt->cascade.next = sentinel->next;
+      tt->cascade.prev = sentinel->prev;
+      tt->cascade.next->prev = &tt->cascade;
+      tt->cascade.prev->next = &tt->cascade;
+      list_init(sentinel);
+      return true;
+    }
+  }
+
+  // Nothing expires before now, so the wheel can catch up without moving any entry
+  if(now > tt->current) tt->current = now;
+  return false;
+}
+
+
+ioopm_ttl_table_t *ioopm_ttl_table_create(ioopm_hash_function hash_func, ioopm_eq_function key_eq_func, uint64_t now){
+  ioopm_ttl_table_t *tt = calloc(1, sizeof(ioopm_ttl_table_t));
+  if(!tt) return NULL;
+
+  tt->index = ioopm_hash_table_create(hash_func, key_eq_func, NULL);
+  if(!tt->index){
+    free(tt);
+    return NULL;
+  }
+
+  for(int level = 0; level < Wheel_Levels; ++level){
+    for(int slot = 0; slot < Wheel_Slots; ++slot){
+      list_init(&tt->slots[level][slot]);
+    }
+  }
+  list_init(&tt->due);
+  list_init(&tt->cascade);
+  tt->current = now;
+
+  return tt;
+}
+
+void ioopm_ttl_table_destroy(ioopm_ttl_table_t *tt){
+  if(!tt) return;
+
+  while(!list_is_empty(&tt->due)){
+    node_remove(tt, (ttl_node_t *)tt->due.next, true);
+  }
+  while(!list_is_empty(&tt->cascade)){
+    node_remove(tt, (ttl_node_t *)tt->cascade.next, true);
+  }
+  for(int level = 0; level < Wheel_Levels; ++level){
+    while(tt->occupied[level]){
+      int slot = __builtin_ctzll(tt->occupied[level]);
+      node_remove(tt, (ttl_node_t *)tt->slots[level][slot].next, true);
+    }
+  }
+
+  ioopm_hash_table_destroy(tt->index);
+  free(tt);
+}
+
+void ioopm_ttl_table_set_expire_function(ioopm_ttl_table_t *tt, ioopm_evict_function expire_func, void *extra){
+  if(!tt) return;
+
+  tt->expire_func = expire_func;
+  tt->expire_arg = extra;
+}
+
+bool ioopm_ttl_table_insert(ioopm_ttl_table_t *tt, elem_t key, elem_t value, uint64_t now, uint64_t ttl){
+  if(!tt) return false;
+
+  ttl_node_t *node = calloc(1, sizeof(ttl_node_t));
+  if(!node) return false;
+
+  ttl_node_t *old = node_find(tt, key);
+  if(old) node_remove(tt, old, true);
+
+  int size_before = ioopm_hash_table_size(tt->index);
+  ioopm_hash_table_insert(tt->index, key, ptr_elem(node));
+  if(ioopm_hash_table_size(tt->index) == size_before){
+    free(node);
+    return false;
+  }
+
+  node->key = key;
+  node->value = value;
+  node->expires = expiry_time(now, ttl);
+  schedule(tt, node);
+  tt->size++;
+
+  return true;
+}
+
+option_t ioopm_ttl_table_lookup(ioopm_ttl_table_t *tt, elem_t key, uint64_t now){
+  if(!tt) return Failure();
+
+  ttl_node_t *node = node_find(tt, key);
+  if(!node) return Failure();
+
+  if(node->expires <= now){
+    node_remove(tt, node, true);
+    return Failure();
+  }
+  return Success(node->value);
+}
+
+bool ioopm_ttl_table_refresh(ioopm_ttl_table_t *tt, elem_t key, uint64_t now, uint64_t ttl){
+  if(!tt) return false;
+
+  ttl_node_t *node = node_find(tt, key);
+  if(!node) return false;
+
+  if(node->expires <= now){
+    node_remove(tt, node, true);
+    return false;
+  }
+
+  unschedule(tt, node);
+  node->expires = expiry_time(now, ttl);
+  schedule(tt, node);
+  return true;
+}
+
+option_t ioopm_ttl_table_remove(ioopm_ttl_table_t *tt, elem_t key){
+  if(!tt) return Failure();
+
+  ttl_node_t *node = node_find(tt, key);
+  if(!node) return Failure();
+
+  elem_t value = node->value;
+  node_remove(tt, node, false);
+  return Success(value);
+}
+
+size_t ioopm_ttl_table_reap(ioopm_ttl_table_t *tt, uint64_t now, size_t max_entries){
+  if(!tt) return 0;
+
+  // An entry moves down at most Wheel_Levels times before it is due, so this many moves
+  // cover max_entries expiries, while a slot of long-lived entries can not stall the call
+  size_t max_moves = max_entries > SIZE_MAX / Wheel_Levels ? SIZE_MAX : max_entries * Wheel_Levels;
+  size_t moves = 0;
+  size_t reaped = 0;
+
+  while(reaped < max_entries){
+    if(!list_is_empty(&tt->due)){
+      node_remove(tt, (ttl_node_t *)tt->due.next, true);
+      ++reaped;
+    }
+    else if(!list_is_empty(&tt->cascade)){
+      if(moves == max_moves) break;
+
+      ttl_node_t *node = (ttl_node_t *)tt->cascade.next;
+      node->link.prev->next = node->link.next;
+      node->link.next->prev = node->link.prev;
+      schedule(tt, node);
+      ++moves;
+    }
+    else if(!advance(tt, now)){
+      break;
+    }
+  }
+
+  return reaped;
+}
+
+size_t ioopm_ttl_table_size(ioopm_ttl_table_t *tt){
+  return tt ? tt->size : 0;
+}
@@ -0,0 +1,121 @@
+// ttl_table.h
+
+#ifndef TTL_TABLE_H
+#define TTL_TABLE_H
+
+/**
+ * @file ttl_table.h
+ * @brief Hash table whose entries expire after a per-entry time to live.
+ *
+ * Every entry is also scheduled in a hierarchical timing wheel: eleven levels
+ * of 64 slots, where a slot on level l spans 64^l ticks, so that any 64-bit
+ * expiry time has a slot. An entry is placed on the lowest level whose slot
+ * still separates its expiry time from the current time of the wheel, and
+ * moves down a level each time the wheel reaches its slot. Each level keeps
+ * a bitmap of its non-empty slots, so the wheel jumps straight to the next
+ * slot that is due: reaping costs O(levels) per expiring entry, however big
+ * the table is and however much time has passed. The entries of a slot are
+ * moved down a bounded number per reap call, so a coarse slot holding many
+ * entries is spread over several calls.
+ *
+ * Expired entries are removed lazily when a lookup finds them, and in
+ * batches of a bounded size by ioopm_ttl_table_reap, so no call has to sweep
+ * the whole table. Time is given by the caller in ticks of any unit (e.g.
+ * milliseconds) and must never go backwards between calls.
+ */
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "hash_table.h"
+
+/*
+ * =========================================
+ * SECTION: Custom Data Types And Aliases
+ * =========================================
+ */
+
+typedef struct ttl_table ioopm_ttl_table_t;
+
+
+/*
+ * =========================================
+ * SECTION: Function Declarations
+ * =========================================
+ */
+
+/// @brief Create a new, empty table.
+/// @param hash_func Function used to hash keys.
+/// @param key_eq_func Function used to compare keys for equality.
+/// @param now The current time; later calls must not pass an earlier time.
+/// @return A new table, or NULL if memory allocation fails.
+ioopm_ttl_table_t *ioopm_ttl_table_create(ioopm_hash_function hash_func, ioopm_eq_function key_eq_func, uint64_t now);
+
+/// @brief Delete a table, passing every remaining entry to the expire callback.
+/// @param tt The table to delete.
+void ioopm_ttl_table_destroy(ioopm_ttl_table_t *tt);
+
+/// @brief Set the function called for every entry that leaves the table without being returned:
+///        expired (on lookup or reap), replaced by ioopm_ttl_table_insert or destroyed.
+/// @param tt Table operated upon.
+/// @param expire_func The callback, or NULL for none.
+/// @param extra Extra argument passed to expire_func.
+void ioopm_ttl_table_set_expire_function(ioopm_ttl_table_t *tt, ioopm_evict_function expire_func, void *extra);
+
+/// @brief Add an entry that expires ttl ticks from now.
+/// @param tt Table operated upon.
+/// @param key Key to insert.
+/// @param value Value to insert.
+/// @param now The current time.
+/// @param ttl Ticks until the entry expires; 0 makes it expire immediately.
+/// @return true on success, false if memory allocation fails.
+/// @note An entry with an equal key is replaced, key and value, and passed to the expire callback.
+bool ioopm_ttl_table_insert(ioopm_ttl_table_t *tt, elem_t key, elem_t value, uint64_t now, uint64_t ttl);
+
+/// @brief Lookup the value for a key, expiring the entry if its time is up.
+/// @param tt Table operated upon.
+/// @param key Key to look up.
+/// @param now The current time.
+/// @return Success with the value if the key is present and not expired, Failure otherwise.
+option_t ioopm_ttl_table_lookup(ioopm_ttl_table_t *tt, elem_t key, uint64_t now);
+
+/// @brief Give an entry a new time to live, e.g. when a session is used.
+/// @param tt Table operated upon.
+/// @param key Key of the entry.
+/// @param now The current time.
+/// @param ttl Ticks from now until the entry expires.
+/// @return true if the entry was present and not expired, false otherwise.
+bool ioopm_ttl_table_refresh(ioopm_ttl_table_t *tt, elem_t key, uint64_t now, uint64_t ttl);
+
+/// @brief Remove an entry without calling the expire callback.
+/// @param tt Table operated upon.
+/// @param key Key to remove.
+/// @return Success with the removed value if the key was present (even if expired), Failure otherwise.
+option_t ioopm_ttl_table_remove(ioopm_ttl_table_t *tt, elem_t key);
+
+/// @brief Expire at most max_entries entries whose time is up.
+/// @param tt Table operated upon.
+/// @param now The current time.
+/// @param max_entries Upper bound on the entries expired by this call.
+/// @return The number of entries expired; less than max_entries once nothing more is due, or
+///         when the call has moved eleven (the number of levels) times max_entries entries
+///         down the wheel, in which case the next call continues where it stopped.
+/// @note Call this regularly (e.g. once per request or timer tick) so that entries that are
+///       never looked up again do not pile up. A call does O(max_entries) work.
+size_t ioopm_ttl_table_reap(ioopm_ttl_table_t *tt, uint64_t now, size_t max_entries);
+
+/// @brief Returns the number of entries in the table.
+/// @param tt Table operated upon.
+/// @return The number of entries, including expired ones that have not been removed yet.
+size_t ioopm_ttl_table_size(ioopm_ttl_table_t *tt);
+
+
+
+#endif // TTL_TABLE_H
@@ -0,0 +1,309 @@
+// ttl_table_tests.c
+
+/*
+ * =========================================
+ * SECTION: Includes and Macros
+ * =========================================
+ */
+
+#include <CUnit/Basic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ttl_table.h"
+
+/// @brief Number of entries in the randomized test.
+#define NUM_ENTRIES 2000
+
+
+/*
+ * =========================================
+ * SECTION: Private Function Definitions
+ * =========================================
+ */
+
+/// @brief Hash function for integer keys.
+/// @param key The key to hash.
+/// @return The hash value.
+static size_t int_hash_function(elem_t key) {
+    return (size_t)key.intValue;
+}
+
+/// @brief Equality function for integer keys.
+/// @param a The first key.
+/// @param b The second key.
+/// @return true if the keys are equal.
+static bool int_eq_function(elem_t a, elem_t b) {
+    return a.intValue == b.intValue;
+}
+
+/// @brief Expire callback that records the expired keys.
+/// @param key The expired key.
+/// @param value The expired value (unused).
+/// @param extra An int array, whose first element is the number of keys recorded after it.
+static void record_expired_key(elem_t key, elem_t value, void *extra) {
+    int *expired = extra;
+    expired[++expired[0]] = key.intValue;
+}
+
+/// @brief Expire callback that frees string keys.
+/// @param key The expired key.
+/// @param value The expired value (unused).
+/// @param extra Unused.
+static void free_expired_key(elem_t key, elem_t value, void *extra) {
+    free(key.ptrValue);
+}
+
+/// @brief Expire callback that checks that entries do not expire early.
+/// @param key The expired key.
+/// @param value The expiry time of the entry.
+/// @param extra Pointer to the current time.
+static void check_expiry_time(elem_t key, elem_t value, void *extra) {
+    CU_ASSERT(value.uint64Value <= *(uint64_t *)extra);
+}
+
+/// @brief Equality function for string keys.
+/// @param a The first key.
+/// @param b The second key.
+/// @return true if the strings are equal.
+static bool string_eq_function(elem_t a, elem_t b) {
+    return strcmp(a.ptrValue, b.ptrValue) == 0;
+}
+
+/// @brief Returns a pseudo-random number (xorshift).
+/// @param state The generator state, not 0.
+/// @return The next number.
+static uint64_t next_random(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Initialize and clean the suite
+ * =========================================
+ */
+
+int init_suite(void) {
+  return 0;
+}
+
+int clean_suite(void) {
+  return 0;
+}
+
+
+/*
+ * =========================================
+ * SECTION: Tests
+ * =========================================
+ */
+
+void test_lazy_expiry() {
+  ioopm_ttl_table_t *tt = ioopm_ttl_table_create(int_hash_function, int_eq_function, 100);
+  int expired[8] = {0};
+  ioopm_ttl_table_set_expire_function(tt, record_expired_key, expired);
+
+  CU_ASSERT_TRUE(ioopm_ttl_table_insert(tt, int_elem(1), int_elem(10), 100, 50));
+  CU_ASSERT_TRUE(ioopm_ttl_table_insert(tt, int_elem(2), int_elem(20), 100, 0));
+  CU_ASSERT_EQUAL(ioopm_ttl_table_size(tt), 2);
+
+  CU_ASSERT(Unsuccessful(ioopm_ttl_table_lookup(tt, int_elem(2), 100)));
+  CU_ASSERT_EQUAL(ioopm_ttl_table_lookup(tt, int_elem(1), 149).value.intValue, 10);
+  CU_ASSERT(Unsuccessful(ioopm_ttl_table_lookup(tt, int_elem(1), 150)));
+
+  CU_ASSERT_EQUAL(expired[0], 2);
+  CU_ASSERT_EQUAL(expired[1], 2);
+  CU_ASSERT_EQUAL(expired[2], 1);
+  CU_ASSERT_EQUAL(ioopm_ttl_table_size(tt), 0);
+  CU_ASSERT_EQUAL(ioopm_ttl_table_reap(tt, 1000, 10), 0);
+
+  ioopm_ttl_table_destroy(tt);
+}
+
+void test_bounded_reap() {
+  ioopm_ttl_table_t *tt = ioopm_ttl_table_create(int_hash_function, int_eq_function, 0);
+  int *expired = calloc(1001, sizeof(int));
+  ioopm_ttl_table_set_expire_function(tt, record_expired_key, expired);
+
+  for (int i = 1; i <= 1000; ++i) {
+    ioopm_ttl_table_insert(tt, int_elem(i), int_elem(i), 0, i);
+  }
+
+  CU_ASSERT_EQUAL(ioopm_ttl_table_reap(tt, 500, 100), 100);
+  CU_ASSERT_EQUAL(ioopm_ttl_table_size(tt), 900);
+  CU_ASSERT_EQUAL(ioopm_ttl_table_reap(tt, 500, 1000), 400);
+  CU_ASSERT_EQUAL(ioopm_ttl_table_reap(tt, 500, 1000), 0);
+  CU_ASSERT_EQUAL(ioopm_ttl_table_size(tt), 500);
+
+  for (int i = 1; i <= 500; ++i) {
+    CU_ASSERT(expired[i] >= 1 && expired[i] <= 500);
+  }
+  CU_ASSERT(Successful(ioopm_ttl_table_lookup(tt, int_elem(501), 500)));
+
+  CU_ASSERT_EQUAL(ioopm_ttl_table_reap(tt, 100000, 1000), 500);
+  CU_ASSERT_EQUAL(ioopm_ttl_table_size(tt), 0);
+
+  ioopm_ttl_table_destroy(tt);
+  free(expired);
+}
+
+void test_reap_random_times() {
+  ioopm_ttl_table_t *tt = ioopm_ttl_table_create(int_hash_function, int_eq_function, 0);
+  uint64_t now = 0;
+  ioopm_ttl_table_set_expire_function(tt, check_expiry_time, &now);
+
+  uint64_t *expires = calloc(NUM_ENTRIES, sizeof(uint64_t));
+  uint64_t state = 88172645463325252ULL;
+  for (int i = 0; i < NUM_ENTRIES; ++i) {
+    // TTLs spread over many levels of the wheel
+    uint64_t ttl = next_random(&state) >> (next_random(&state) % 64);
+    expires[i] = ttl;
+    ioopm_ttl_table_insert(tt, int_elem(i), (elem_t){.uint64Value = ttl}, 0, ttl);
+  }
+
+  for (int step = 0; step < 200; ++step) {
+    // Steps below 2^54 keep the time from wrapping around
+    now += next_random(&state) >> (10 + next_random(&state) % 54);
+
+    size_t alive = 0;
+    for (int i = 0; i < NUM_ENTRIES; ++i) {
+      alive += expires[i] > now;
+    }
+
+    ioopm_ttl_table_reap(tt, now, NUM_ENTRIES);
+    CU_ASSERT_EQUAL(ioopm_ttl_table_size(tt), alive);
+  }
+
+  // Destroying passes the entries that are still alive to the callback too
+  now = UINT64_MAX;
+  ioopm_ttl_table_destroy(tt);
+  free(expires);
+}
+
+void test_refresh_remove_replace() {
+  ioopm_ttl_table_t *tt = ioopm_ttl_table_create(int_hash_function, int_eq_function, 0);
+  int expired[8] = {0};
+  ioopm_ttl_table_set_expire_function(tt, record_expired_key, expired);
+
+  ioopm_ttl_table_insert(tt, int_elem(1), int_elem(10), 0, 100);
+  CU_ASSERT_TRUE(ioopm_ttl_table_refresh(tt, int_elem(1), 90, 100));
+  CU_ASSERT_EQUAL(ioopm_ttl_table_reap(tt, 150, 10), 0);
+  CU_ASSERT(Successful(ioopm_ttl_table_lookup(tt, int_elem(1), 150)));
+  CU_ASSERT_FALSE(ioopm_ttl_table_refresh(tt, int_elem(2), 150, 100));
+
+  // Replacing hands the old entry to the callback; removing does not
+  ioopm_ttl_table_insert(tt, int_elem(1), int_elem(11), 150, 100);
+  CU_ASSERT_EQUAL(expired[0], 1);
+  CU_ASSERT_EQUAL(ioopm_ttl_table_size(tt), 1);
+  CU_ASSERT_EQUAL(ioopm_ttl_table_remove(tt, int_elem(1)).value.intValue, 11);
+  CU_ASSERT(Unsuccessful(ioopm_ttl_table_remove(tt, int_elem(1))));
+  CU_ASSERT_EQUAL(expired[0], 1);
+  CU_ASSERT_EQUAL(ioopm_ttl_table_reap(tt, 1000, 10), 0);
+
+  // Refreshing an expired entry expires it instead
+  ioopm_ttl_table_insert(tt, int_elem(3), int_elem(30), 1000, 10);
+  CU_ASSERT_FALSE(ioopm_ttl_table_refresh(tt, int_elem(3), 1010, 10));
+  CU_ASSERT_EQUAL(expired[0], 2);
+  CU_ASSERT_EQUAL(ioopm_ttl_table_size(tt), 0);
+
+  ioopm_ttl_table_destroy(tt);
+}
+
+void test_destroy_expires_remaining() {
+  ioopm_ttl_table_t *tt = ioopm_ttl_table_create(ioopm_string_hash, string_eq_function, 0);
+  ioopm_ttl_table_set_expire_function(tt, free_expired_key, NULL);
+
+  char *words[] = {"alpha", "beta", "gamma", "delta"};
+  for (int i = 0; i < 4; ++i) {
+    ioopm_ttl_table_insert(tt, ptr_elem(strdup(words[i])), int_elem(i), 0, (uint64_t)1 << (i * 20));
+  }
+  CU_ASSERT_EQUAL(ioopm_ttl_table_reap(tt, 1, 10), 1);
+  CU_ASSERT(Successful(ioopm_ttl_table_lookup(tt, ptr_elem("delta"), 1)));
+
+  // The remaining keys are freed by the callback
+  ioopm_ttl_table_destroy(tt);
+}
+
+
+void test_reap_spreads_cascade() {
+  ioopm_ttl_table_t *tt = ioopm_ttl_table_create(int_hash_function, int_eq_function, 0);
+  uint64_t now = 0;
+  ioopm_ttl_table_set_expire_function(tt, check_expiry_time, &now);
+
+  // All entries share one coarse slot, which the wheel reaches before any of them is due
+  uint64_t base = (uint64_t)1 << 30;
+  for (int i = 0; i < NUM_ENTRIES; ++i) {
+    ioopm_ttl_table_insert(tt, int_elem(i), (elem_t){.uint64Value = base + 1000 + i}, 0, base + 1000 + i);
+  }
+
+  now = base;
+  CU_ASSERT_EQUAL(ioopm_ttl_table_reap(tt, now, 1), 0);
+  CU_ASSERT_EQUAL(ioopm_ttl_table_size(tt), NUM_ENTRIES);
+
+  // Small calls keep moving the slot down where the previous one stopped
+  now = base + 1000 + NUM_ENTRIES / 2;
+  size_t reaped = 0;
+  for (int calls = 0; calls < 10 * NUM_ENTRIES && reaped <= NUM_ENTRIES / 2; ++calls) {
+    size_t step = ioopm_ttl_table_reap(tt, now, 1);
+    CU_ASSERT(step <= 1);
+    reaped += step;
+  }
+  CU_ASSERT_EQUAL(reaped, NUM_ENTRIES / 2 + 1);
+  while (ioopm_ttl_table_reap(tt, now, 1) > 0) ++reaped;
+  CU_ASSERT_EQUAL(reaped, NUM_ENTRIES / 2 + 1);
+  CU_ASSERT_EQUAL(ioopm_ttl_table_size(tt), NUM_ENTRIES - reaped);
+
+  now = UINT64_MAX;
+  ioopm_ttl_table_destroy(tt);
+}
+
+
+/*
+ * =========================================
+ * SECTION: Main
+ * =========================================
+ */
+
+int main() {
+  // First we try to set up CUnit, and exit if we fail
+  if (CU_initialize_registry() != CUE_SUCCESS)
+    return CU_get_error();
+
+  // We then create an empty test suite and specify the name and
+  // the init and cleanup functions
+  CU_pSuite my_test_suite = CU_add_suite("Unit tests for TTL table", init_suite, clean_suite);
+  if (my_test_suite == NULL) {
+      // If the test suite could not be added, tear down CUnit and exit
+      CU_cleanup_registry();
+      return CU_get_error();
+  }
+
+  if (
+    (CU_add_test(my_test_suite, "Entries expire lazily on lookup", test_lazy_expiry) == NULL) ||
+    (CU_add_test(my_test_suite, "Reaping is bounded per call", test_bounded_reap) == NULL) ||
+    (CU_add_test(my_test_suite, "Reaping matches the expiry times", test_reap_random_times) == NULL) ||
+    (CU_add_test(my_test_suite, "Refresh, remove and replace entries", test_refresh_remove_replace) == NULL) ||
+    (CU_add_test(my_test_suite, "Destroy expires the remaining entries", test_destroy_expires_remaining) == NULL) ||
+    (CU_add_test(my_test_suite, "Reaping spreads a large slot over calls", test_reap_spreads_cascade) == NULL) ||
+    0
+  )
+    {
+      // If adding any of the tests fails, we tear down CUnit and exit
+      CU_cleanup_registry();
+      return CU_get_error();
+    }
+
+  // Set the running mode. Use CU_BRM_VERBOSE for maximum output.
+  // Use CU_BRM_NORMAL to only print errors and a summary
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+
+  // This is where the tests are actually run!
+  CU_basic_run_tests();
+
+  // Tear down CUnit before exiting
+  CU_cleanup_registry();
+  return CU_get_error();
+}